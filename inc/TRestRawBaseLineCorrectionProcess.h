@@ -42,6 +42,15 @@ class TRestRawBaseLineCorrectionProcess : public TRestEventProcess {
     /// Time window width in bins for the moving average filter for baseline correction
     Int_t fSmoothingWindow = 75;
 
+    /// The baseline estimator : average (moving average excluding outliers) or median (running median)
+    std::string fSmoothingMethod = "average";
+
+    /// The TRestRawSignal::GetSignalSmoothed option corresponding to fSmoothingMethod
+    std::string fSmoothingOption = "EXCLUDE OUTLIERS";  //!
+
+    /// If true, the signals are corrected inside the input event, which is returned as output event
+    Bool_t fInPlace = false;
+
     /// Just a flag to quickly determine if we have to apply the range filter
     Bool_t fRangeEnabled = false;  //!
 
@@ -49,7 +58,13 @@ class TRestRawBaseLineCorrectionProcess : public TRestEventProcess {
 
    public:
     RESTValue GetInputEvent() const override { return fInputEvent; }
-    RESTValue GetOutputEvent() const override { return fOutputEvent; }
+    RESTValue GetOutputEvent() const override {
+        if (fInPlace) return fInputEvent;
+        return fOutputEvent;
+    }
+
+    inline Bool_t IsInPlace() const { return fInPlace; }
+    inline void SetInPlace(Bool_t inPlace) { fInPlace = inPlace; }
 
     void PrintMetadata() override;
 
@@ -57,6 +72,11 @@ class TRestRawBaseLineCorrectionProcess : public TRestEventProcess {
 
     TRestEvent* ProcessEvent(TRestEvent* eventInput) override;
 
+    void ProcessSignal(TRestRawSignal* signal);
+
+    /// It sets the readout metadata used to select the signals by channel type
+    inline void SetReadoutMetadata(TRestRawReadoutMetadata* metadata) { fReadoutMetadata = metadata; }
+
     void EndProcess() override;
 
     void InitFromConfigFile() override;
@@ -72,6 +92,6 @@ class TRestRawBaseLineCorrectionProcess : public TRestEventProcess {
 
     // ROOT class definition helper. Increase the number in it every time
     // you add/rename/remove the process parameters
-    ClassDefOverride(TRestRawBaseLineCorrectionProcess, 2);
+    ClassDefOverride(TRestRawBaseLineCorrectionProcess, 4);
 };
 #endif
@@ -26,7 +26,10 @@
 #include <TRestEventProcess.h>
 #include <TRestRawSignalEvent.h>
 
+#include <map>
+
 #include "TRestRawSignal.h"
+#include "TRestRawWorkerPool.h"
 
 //! A process to subtract the common channels noise from RawSignal type
 class TRestRawCommonNoiseReductionProcess : public TRestEventProcess {
@@ -50,16 +53,52 @@ class TRestRawCommonNoiseReductionProcess : public TRestEventProcess {
     /// Minimum number of signals required to apply the process.
     Int_t fMinSignalsRequired = 200;
 
+    /// The number of consecutive DAQ channels in a block, i.e. 72 for one AGET/AFTER chip (blocks = 1).
+    Int_t fBlockSize = 72;
+
+    /// The number of threads used to process the blocks of one event (blocks = 1).
+    Int_t fBlockThreads = 1;
+
+    /// If true, the signals are corrected inside the input event, which is returned as output event.
+    Bool_t fInPlace = false;
+
     std::string fChannelType;
     TRestRawReadoutMetadata* fReadoutMetadata = nullptr;  //!
 
+    /// The block index of each DAQ channel defined in the readout metadata (blocks = 1).
+    std::map<Int_t, Int_t> fChannelBlock;  //!
+
+    /// The signal values transposed to time bins x channels, one for each block thread
+    std::vector<std::vector<Short_t>> fTile;  //!
+
+    /// The correction to be added to each time bin, one for each block thread
+    std::vector<std::vector<Double_t>> fCorrection;  //!
+
+    /// The threads used to process the blocks of one event
+    TRestRawWorkerPool* fWorkers = nullptr;  //!
+
+    void InitBlocks();
+
+    void StartWorkers();
+
+    void SubtractCommonNoise(const std::vector<TRestRawSignal*>& signals, Double_t baseLine,
+                             std::vector<Short_t>& tile, std::vector<Double_t>& correction);
+
     void Initialize() override;
 
     void LoadDefaultConfig();
 
    public:
     RESTValue GetInputEvent() const override { return fInputEvent; }
-    RESTValue GetOutputEvent() const override { return fOutputEvent; }
+    RESTValue GetOutputEvent() const override {
+        if (fInPlace) return fInputEvent;
+        return fOutputEvent;
+    }
+
+    inline Bool_t IsInPlace() const { return fInPlace; }
+    inline void SetInPlace(Bool_t inPlace) { fInPlace = inPlace; }
+
+    inline void SetReadoutMetadata(TRestRawReadoutMetadata* metadata) { fReadoutMetadata = metadata; }
 
     void InitProcess() override;
 
@@ -85,7 +124,12 @@ class TRestRawCommonNoiseReductionProcess : public TRestEventProcess {
         }
         RESTMetadata << " centerWidth : " << fCenterWidth << RESTendl;
         RESTMetadata << "blocks : [" << fBlocks << "]" << RESTendl;
+        if (fBlocks == 1) {
+            RESTMetadata << " blockSize : " << fBlockSize << RESTendl;
+            RESTMetadata << " blockThreads : " << fBlockThreads << RESTendl;
+        }
         RESTMetadata << " Minimum number of signals : " << fMinSignalsRequired << RESTendl;
+        RESTMetadata << " In place : " << (fInPlace ? "true" : "false") << RESTendl;
 
         EndPrintProcess();
     }
@@ -103,6 +147,6 @@ class TRestRawCommonNoiseReductionProcess : public TRestEventProcess {
     // Destructor
     ~TRestRawCommonNoiseReductionProcess();
 
-    ClassDefOverride(TRestRawCommonNoiseReductionProcess, 3);
+    ClassDefOverride(TRestRawCommonNoiseReductionProcess, 5);
 };
 #endif
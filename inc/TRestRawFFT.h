@@ -18,27 +18,38 @@
 #ifndef RestCore_TRestRawFFT
 #define RestCore_TRestRawFFT
 
-#include <TArrayD.h>
 #include <TObject.h>
 #include <TRestRawSignal.h>
 
+#include <complex>
 #include <iostream>
+#include <vector>
+
+class TRestRawSignalEvent;
 
 class TRestRawFFT : public TObject {
    protected:
     Int_t fNfft;
 
-    TArrayD fTimeReal;       // [fNfft]
-    TArrayD fTimeImg;        // [fNfft]
-    TArrayD fFrequencyReal;  // [fNfft]
-    TArrayD fFrequencyImg;   // [fNfft]
+    /// The real time signal, fNfft points
+    std::vector<Double_t> fTime;
+
+    /// The complex spectrum, fNfft points stored contiguously
+    std::vector<std::complex<Double_t>> fFrequency;
+
+    void Forward();
 
    public:
     // Getters
-    Double_t GetFrequencyAmplitudeReal(Int_t n) { return fFrequencyReal.GetArray()[n]; }
-    Double_t GetFrequencyAmplitudeImg(Int_t n) { return fFrequencyImg.GetArray()[n]; }
+    Double_t GetFrequencyAmplitudeReal(Int_t n) const { return fFrequency[n].real(); }
+    Double_t GetFrequencyAmplitudeImg(Int_t n) const { return fFrequency[n].imag(); }
 
-    Double_t GetFrequencyNorm2(Int_t n);
+    Double_t GetFrequencyNorm2(Int_t n) const { return std::norm(fFrequency[n]); }
+
+    /// Returns a pointer to the fNfft complex frequency nodes
+    std::complex<Double_t>* GetFrequency() { return fFrequency.data(); }
+
+    Double_t GetTimeAmplitude(Int_t n) const { return fTime[n]; }
 
     inline Int_t GetNfft() const { return fNfft; }
 
@@ -48,8 +59,7 @@ class TRestRawFFT : public TObject {
     void SetNfft(Int_t n);
 
     void SetNode(Int_t n, Double_t real, Double_t img = 0) {
-        fFrequencyReal.GetArray()[n] = real;
-        fFrequencyImg.GetArray()[n] = img;
+        fFrequency[n] = std::complex<Double_t>(real, img);
     }
 
     void SetSecondOrderAnalyticalResponse(Double_t f1, Double_t f2, Double_t to);
@@ -57,8 +67,13 @@ class TRestRawFFT : public TObject {
 
     // FFT processing
     void ForwardSignalFFT(TRestRawSignal* sgnl, Int_t fNStart = 0, Int_t fNEnd = 0);
+    void ForwardFFT(const std::vector<Double_t>& data, Int_t nfft);
     void BackwardFFT();
 
+    static void ForwardEventFFT(TRestRawSignalEvent* event, std::vector<TRestRawFFT>& fft, Int_t fNStart = 0,
+                                Int_t fNEnd = 0);
+    static void BackwardEventFFT(std::vector<TRestRawFFT>& fft);
+
     void RenormalizeNode(Int_t n, Double_t factor);
     void ApplyLowPassFilter(Int_t cutFrequency);
     // void NoiseReductionFilter( Int_t cutOff );
@@ -82,6 +97,6 @@ class TRestRawFFT : public TObject {
     // Destructor
     ~TRestRawFFT();
 
-    ClassDef(TRestRawFFT, 1);
+    ClassDef(TRestRawFFT, 2);
 };
 #endif
@@ -109,6 +109,9 @@ class TRestRawMultiCoBoAsAdToSignalProcess : public TRestRawToSignalProcess {
     std::vector<CoBoHeaderFrame> fHeaderFrame;  //!///reserves a header frame for each file
 
     int fCurrentEvent = -1;  //!
+
+    /// True if the current event is rejected by the event selection
+    Bool_t fSkipEvent = false;  //!
     int fNextEvent = -1;     //!
 #endif
 
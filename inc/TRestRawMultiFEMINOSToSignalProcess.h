@@ -36,6 +36,11 @@ class TRestRawMultiFEMINOSToSignalProcess : public TRestRawToSignalProcess {
 
     Int_t fCounter = 0;  //!
 
+    /// True if the event being read is rejected by the event selection
+    Bool_t fSkipEvent = false;  //!
+
+    void ApplyEventSelection();
+
    public:
     void InitProcess() override;
     void Initialize() override;
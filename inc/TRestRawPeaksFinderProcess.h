@@ -9,6 +9,7 @@
 
 #include "TRestRawReadoutMetadata.h"
 #include "TRestRawSignalEvent.h"
+#include "TRestRawWorkerPool.h"
 
 class TRestRawPeaksFinderProcess : public TRestEventProcess {
    private:
@@ -41,6 +42,29 @@ class TRestRawPeaksFinderProcess : public TRestEventProcess {
 
     std::set<std::string> fChannelTypes = {};  // this process will only be applied to selected channel types
 
+    /// \brief number of threads used to find the peaks of the signals
+    Int_t fFinderThreads = 1;
+
+    /// A peak: signalId, time, amplitude, amplitudeBaseLineCorrected
+    using PeakTuple = std::tuple<UShort_t, UShort_t, double, double>;
+
+    /// Bits of the channel masks
+    enum ChannelMaskBit : UChar_t { kSelectedChannel = 1, kTPCChannel = 2, kVetoChannel = 4 };
+
+    /// The type bits of each channel, indexed by channel daq id. It is built from the readout metadata
+    std::vector<UChar_t> fChannelMask;  //!
+    /// The type bits and the number of peaks of each signal in the event being processed
+    std::vector<UChar_t> fSignalMask;         //!
+    std::vector<UShort_t> fSignalPeaksCount;  //!
+    /// The peaks found by each thread, and all the peaks of the event sorted by time and signal id
+    std::vector<std::vector<PeakTuple>> fThreadPeaks;  //!
+    std::vector<PeakTuple> fEventPeaks;                //!
+
+    /// The threads used to find the peaks, created at InitProcess and deleted at EndProcess
+    TRestRawWorkerPool* fWorkers = nullptr;  //!
+
+    void BuildChannelMask();
+
    public:
     RESTValue GetInputEvent() const override { return fInputEvent; }
     RESTValue GetOutputEvent() const override { return fInputEvent; }
@@ -49,7 +73,7 @@ class TRestRawPeaksFinderProcess : public TRestEventProcess {
 
     void InitProcess() override;
     TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
-    void EndProcess() override {}
+    void EndProcess() override;
 
     const char* GetProcessName() const override { return "peaksFinder"; }
 
@@ -58,9 +82,9 @@ class TRestRawPeaksFinderProcess : public TRestEventProcess {
     void InitFromConfigFile() override;
 
     TRestRawPeaksFinderProcess() = default;
-    ~TRestRawPeaksFinderProcess() = default;
+    ~TRestRawPeaksFinderProcess() { delete fWorkers; }
 
-    ClassDefOverride(TRestRawPeaksFinderProcess, 6);
+    ClassDefOverride(TRestRawPeaksFinderProcess, 7);
 };
 
 #endif  // REST_TRESTRAWPEAKSFINDERPROCESS_H
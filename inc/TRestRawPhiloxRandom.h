@@ -0,0 +1,59 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestCore_TRestRawPhiloxRandom
+#define RestCore_TRestRawPhiloxRandom
+
+#include <TObject.h>
+
+#include <vector>
+
+//! A counter-based Philox4x32-10 random number generator
+class TRestRawPhiloxRandom : public TObject {
+   private:
+    /// The key of the generator
+    UInt_t fKey[2] = {0, 0};
+
+    /// The uniform values used to generate the gaussian values
+    std::vector<Double_t> fUniform;  //!
+
+   public:
+    static void Generate(const UInt_t* counter, const UInt_t* key, UInt_t* result);
+
+    /// It returns the 4 random words of the given counter, using the generator key
+    inline void Generate(const UInt_t* counter, UInt_t* result) const { Generate(counter, fKey, result); }
+
+    void FillGaussian(Double_t* values, Int_t n, UInt_t stream0, UInt_t stream1, UInt_t stream2,
+                      Double_t sigma = 1.);
+
+    inline UInt_t GetKey(Int_t n) const { return fKey[n]; }
+    inline void SetKey(UInt_t key0, UInt_t key1) {
+        fKey[0] = key0;
+        fKey[1] = key1;
+    }
+
+    TRestRawPhiloxRandom(UInt_t key0 = 0, UInt_t key1 = 0);
+    ~TRestRawPhiloxRandom();
+
+    ClassDef(TRestRawPhiloxRandom, 1);
+};
+#endif
@@ -0,0 +1,95 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestCore_TRestRawPulseFitter
+#define RestCore_TRestRawPulseFitter
+
+#include <TObject.h>
+#include <TRestRawSignal.h>
+
+#include <vector>
+
+//! A Levenberg-Marquardt fitter of the AGET shaperSin pulse
+class TRestRawPulseFitter : public TObject {
+   public:
+    /// The order of the fit parameters
+    enum Parameter { kBaseline = 0, kAmplitude, kShapingTime, kStartPosition, kNParameters };
+
+   private:
+    /// The fitted parameters
+    Double_t fParameters[kNParameters] = {0, 0, 0, 0};
+
+    /// The sum of the squared residuals of the fit
+    Double_t fChiSquare = 0;
+
+    /// The number of iterations of the last fit
+    Int_t fIterations = 0;
+
+    /// True if the relative change of the chi square reached the tolerance
+    Bool_t fConverged = false;
+
+    /// The maximum number of iterations
+    Int_t fMaxIterations = 100;
+
+    /// The relative change of the chi square used to stop the iterations
+    Double_t fTolerance = 1.e-6;
+
+    /// The data being fitted, the model and the jacobian of the model, for the fitted parameters
+    std::vector<Double_t> fData;      //!
+    std::vector<Double_t> fModel;     //!
+    std::vector<Double_t> fJacobian;  //!
+    std::vector<Double_t> fTrial;     //!
+
+    void InitialParameters();
+    Double_t ComputeModel(const Double_t* par, std::vector<Double_t>& model) const;
+    void ComputeJacobian();
+
+   public:
+    static Double_t Shape(Double_t u);
+    static Double_t ShapeDerivative(Double_t u);
+    static Double_t Evaluate(Double_t x, const Double_t* par);
+    static Bool_t SolveLinearSystem(Double_t* a, Double_t* b, Double_t* x, Int_t n);
+
+    Bool_t Fit(const Short_t* data, Int_t nBins);
+    Bool_t Fit(const TRestRawSignal* signal);
+
+    inline Double_t GetParameter(Int_t n) const { return fParameters[n]; }
+    inline const Double_t* GetParameters() const { return fParameters; }
+    inline Double_t GetChiSquare() const { return fChiSquare; }
+    inline Int_t GetIterations() const { return fIterations; }
+    inline Bool_t IsConverged() const { return fConverged; }
+
+    /// It returns the fitted model at the given bin of the last fit
+    inline Double_t GetModel(Int_t bin) const { return fModel[bin]; }
+
+    inline Int_t GetMaxIterations() const { return fMaxIterations; }
+    inline void SetMaxIterations(Int_t iterations) { fMaxIterations = iterations; }
+
+    inline Double_t GetTolerance() const { return fTolerance; }
+    inline void SetTolerance(Double_t tolerance) { fTolerance = tolerance; }
+
+    TRestRawPulseFitter();
+    ~TRestRawPulseFitter();
+
+    ClassDef(TRestRawPulseFitter, 1);
+};
+#endif
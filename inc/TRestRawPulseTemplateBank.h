@@ -0,0 +1,65 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestCore_TRestRawPulseTemplateBank
+#define RestCore_TRestRawPulseTemplateBank
+
+#include <TObject.h>
+
+#include <vector>
+
+//! A table of the AGET shaperSin pulse convoluted with a gaussian
+class TRestRawPulseTemplateBank : public TObject {
+   private:
+    /// The range and step of the pulse variable u = (x-t0)/tau
+    Double_t fMinU = -5;
+    Double_t fMaxU = 15;
+    Double_t fStepU = 0.02;
+
+    /// The maximum and step of the gaussian width in units of the shaping time, s = sigma/tau
+    Double_t fMaxS = 1;
+    Double_t fStepS = 0.01;
+
+    /// The number of nodes in u and s
+    Int_t fNu = 0;
+    Int_t fNs = 0;
+
+    /// The convoluted pulse and its derivative in u, for each s row, fNs x fNu values
+    std::vector<Double_t> fTemplate;    //!
+    std::vector<Double_t> fDerivative;  //!
+
+   public:
+    void Build();
+
+    inline Bool_t IsBuilt() const { return !fTemplate.empty(); }
+
+    inline Double_t GetMaxS() const { return fMaxS; }
+
+    Double_t Evaluate(Double_t u, Double_t s, Double_t* dGdu = nullptr, Double_t* dGds = nullptr) const;
+
+    TRestRawPulseTemplateBank();
+    TRestRawPulseTemplateBank(Double_t minU, Double_t maxU, Double_t stepU, Double_t maxS, Double_t stepS);
+    ~TRestRawPulseTemplateBank();
+
+    ClassDef(TRestRawPulseTemplateBank, 1);
+};
+#endif
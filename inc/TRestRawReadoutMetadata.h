@@ -30,6 +30,8 @@ class TRestRawReadoutMetadata : public TRestMetadata {
 
     std::vector<UShort_t> GetChannelDaqIDsForType(const std::string& type) const;
 
+    std::vector<UShort_t> GetChannelDaqIDs() const;
+
     void PrintMetadata() const;
 
     TRestRawReadoutMetadata() = default;
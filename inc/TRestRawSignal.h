@@ -46,6 +46,8 @@ class TRestRawSignal {
 
     std::vector<Float_t> GetSignalSmoothed_ExcludeOutliers(Int_t averagingPoints);
 
+    std::vector<Float_t> GetSignalSmoothed_Median(Int_t averagingPoints);
+
    protected:
     /// An integer value used to attribute a unique identification number to the signal.
     Int_t fSignalID;
@@ -127,6 +129,12 @@ class TRestRawSignal {
 
     Short_t operator[](Int_t n);
 
+    /// Returns a pointer to the data points, for kernels working on the whole signal at once
+    inline Short_t* GetSignalData() { return fSignalData.data(); }
+
+    /// Returns a pointer to the data points, for kernels working on the whole signal at once
+    inline const Short_t* GetSignalData() const { return fSignalData.data(); }
+
     /// It sets the id number of the signal
     inline void SetSignalID(Int_t sID) { fSignalID = sID; }
 
@@ -151,12 +159,16 @@ class TRestRawSignal {
 
     void Initialize();
 
+    void ResetCalculatedValues();
+
     void AddPoint(Short_t);
 
     void AddPoint(Double_t);
 
     void IncreaseBinBy(Int_t bin, Double_t data);
 
+    void SetPoint(Int_t n, Double_t value);
+
     void InitializePointsOverThreshold(const TVector2& thrPar, Int_t nPointsOver, Int_t nPointsFlat = 512);
 
     UInt_t GetSeed() const { return fSeed; }
@@ -205,7 +217,8 @@ class TRestRawSignal {
 
     void CalculateBaseLine(Int_t startBin, Int_t endBin, const std::string& option = "");
 
-    void GetBaseLineCorrected(TRestRawSignal* smoothedSignal, Int_t averagingPoints);
+    void GetBaseLineCorrected(TRestRawSignal* smoothedSignal, Int_t averagingPoints,
+                              const std::string& option = "EXCLUDE OUTLIERS");
 
     void AddOffset(Short_t offset);
 
@@ -25,6 +25,7 @@
 
 #include <TRestEventProcess.h>
 
+#include "TRestRawPhiloxRandom.h"
 #include "TRestRawSignalEvent.h"
 
 //! A process to add/emulate electronic noise into a TRestRawSignalEvent
@@ -43,6 +44,29 @@ class TRestRawSignalAddNoiseProcess : public TRestEventProcess {
     /// The noise level to be added to the signal. It is 1-gaussian sigma
     Double_t fNoiseLevel = 10.0;
 
+    /// If true, the noise is added to the input event signals, and the input event is returned
+    Bool_t fInPlace = false;
+
+    /// The seed of the noise generator. Together with the run number it defines the generator key
+    UInt_t fSeed = 0;
+
+    /// The noise generator. It can be `philox` or `TRandom3`
+    std::string fGenerator = "philox";
+
+    /// The counter-based generator used to produce the noise
+    TRestRawPhiloxRandom fRandom;  //!
+
+    /// The event id used as generator counter
+    UInt_t fEventId = 0;  //!
+
+    /// The sub-event id used as generator counter
+    UInt_t fSubEventId = 0;  //!
+
+    /// The noise values of the signal being processed
+    std::vector<Double_t> fNoise;  //!
+
+    void GenerateNoise(const TRestRawSignal* signal);
+
    public:
     /// It returns the noise level defined in the process (ADC units)
     inline Double_t GetNoiseLevel() const { return fNoiseLevel; }
@@ -50,14 +74,41 @@ class TRestRawSignalAddNoiseProcess : public TRestEventProcess {
     /// It sets the noise level of the process (ADC units)
     inline void SetNoiseLevel(Double_t noiseLevel) { fNoiseLevel = noiseLevel; }
 
+    /// It returns the seed of the noise generator
+    inline UInt_t GetSeed() const { return fSeed; }
+
+    /// It sets the seed of the noise generator
+    inline void SetSeed(UInt_t seed) { fSeed = seed; }
+
+    /// It returns the noise generator (`philox` or `TRandom3`)
+    inline std::string GetGenerator() const { return fGenerator; }
+
+    /// It sets the noise generator (`philox` or `TRandom3`)
+    inline void SetGenerator(const std::string& generator) { fGenerator = generator; }
+
+    /// It returns true if the noise is added to the input event signals
+    inline Bool_t IsInPlace() const { return fInPlace; }
+
+    /// It sets if the noise is added to the input event signals
+    inline void SetInPlace(Bool_t inPlace) { fInPlace = inPlace; }
+
     /// Returns a pointer to the input signal event
     RESTValue GetInputEvent() const override { return fInputSignalEvent; }
 
     /// Returns a pointer to the output signal event
-    RESTValue GetOutputEvent() const override { return fOutputSignalEvent; }
+    RESTValue GetOutputEvent() const override {
+        if (fInPlace) return fInputSignalEvent;
+        return fOutputSignalEvent;
+    }
+
+    void InitProcess() override;
 
     TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
 
+    void SetEventKey(const TRestEvent* event);
+
+    void ProcessSignal(TRestRawSignal* signal);
+
     void LoadConfig(const std::string& configFilename, const std::string& name = "");
 
     /// Prints out the metadata members of this class
@@ -65,6 +116,9 @@ class TRestRawSignalAddNoiseProcess : public TRestEventProcess {
         BeginPrintProcess();
 
         RESTMetadata << "Noise Level : " << fNoiseLevel << RESTendl;
+        RESTMetadata << "In place : " << (fInPlace ? "true" : "false") << RESTendl;
+        RESTMetadata << "Generator : " << fGenerator << RESTendl;
+        RESTMetadata << "Seed : " << fSeed << RESTendl;
 
         EndPrintProcess();
     }
@@ -78,6 +132,6 @@ class TRestRawSignalAddNoiseProcess : public TRestEventProcess {
     TRestRawSignalAddNoiseProcess(const char* configFilename);
     ~TRestRawSignalAddNoiseProcess();
 
-    ClassDefOverride(TRestRawSignalAddNoiseProcess, 2);
+    ClassDefOverride(TRestRawSignalAddNoiseProcess, 4);
 };
 #endif
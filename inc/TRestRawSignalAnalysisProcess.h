@@ -25,6 +25,8 @@
 
 #include <TRestRawSignalEvent.h>
 
+#include <functional>
+
 #include "TRestEventProcess.h"
 
 //! An analysis process to extract valuable information from a TRestRawSignalEvent.
@@ -62,6 +64,68 @@ class TRestRawSignalAnalysisProcess : public TRestEventProcess {
 
     TRestRawReadoutMetadata* fReadoutMetadata = nullptr;
 
+    /// If true, the per-signal observables are written as vectors, following the order of signal_id
+    Bool_t fFlatObservables = false;
+
+    /// The per-signal observables when fFlatObservables is enabled. They are reused at every event.
+    std::vector<Int_t> fSignalIds;              //!
+    std::vector<Double_t> fBaseLines;           //!
+    std::vector<Double_t> fBaseLineSigmas;      //!
+    std::vector<Double_t> fMaxAmplitudes;       //!
+    std::vector<Double_t> fThresholdIntegrals;  //!
+    std::vector<Int_t> fRiseTimes;              //!
+    std::vector<Int_t> fPeakTimes;              //!
+    std::vector<Int_t> fPointsOverThresholdN;   //!
+
+    /// The signals of the selected channel types in the event being analysed
+    TRestRawSignalEvent fEvent;  //!
+
+    /// The registered observables, each with the function computing and setting its value
+    std::vector<std::pair<std::string, std::function<void()>>> fObservableCalculators;  //!
+    /// The functions of the observables written to the analysis tree or used by a cut
+    std::vector<std::function<void()>> fActiveCalculators;  //!
+    /// True once the requested observables have been found at the first event
+    Bool_t fObservablesResolved = false;  //!
+
+    /// The event values shared by several observables
+    enum EventValue {
+        kBaseLineMean,
+        kBaseLineSigmaMean,
+        kTimeBinsLength,
+        kFullIntegral,
+        kThresholdIntegral,
+        kRiseSlope,
+        kSlopeIntegral,
+        kNEventValues
+    };
+    Double_t fEventValues[kNEventValues];    //!
+    Bool_t fEventValueDone[kNEventValues];  //!
+
+    /// The intermediate results shared by several observables. They are computed once per event.
+    Bool_t fPointsOverThresholdDone = false;  //!
+    Int_t fNGoodSignals = 0;                  //!
+    Bool_t fMaxPeakBinsDone = false;          //!
+    std::vector<Int_t> fMaxPeakBins;          //!
+    Bool_t fPeakValuesDone = false;           //!
+    Double_t fMaxValue = 0;                   //!
+    Double_t fMinValue = 0;                   //!
+    Double_t fMaxValueIntegral = 0;           //!
+    Double_t fMinDownValue = 0;               //!
+    Double_t fMinPeakTime = 0;                //!
+    Double_t fMaxPeakTime = 0;                //!
+    Double_t fPeakTimeAverage = 0;            //!
+
+    void RegisterObservables();
+    void ResolveObservables();
+    Bool_t IsObservableRequested(const std::string& name) const;
+    Bool_t IsSignalInRange(Int_t s);
+
+    void ComputePointsOverThreshold();
+    void ComputeMaxPeakBins();
+    void ComputePeakValues();
+    Double_t GetEventValue(EventValue value);
+    Bool_t ApplyEarlyCut();
+
     void Initialize() override;
 
     std::set<std::string> fChannelTypes = {};  // this process will only be applied to selected channel types
@@ -92,6 +156,7 @@ class TRestRawSignalAnalysisProcess : public TRestEventProcess {
         RESTMetadata << "Number of points over threshold : " << fPointsOverThreshold << RESTendl;
         RESTMetadata << "Baseline calculation method: " << (fBaseLineOption.empty() ? "Standard" : "Robust")
                      << RESTendl;
+        RESTMetadata << "Flat observables : " << (fFlatObservables ? "true" : "false") << RESTendl;
 
         EndPrintProcess();
     }
@@ -102,7 +167,7 @@ class TRestRawSignalAnalysisProcess : public TRestEventProcess {
 
     ~TRestRawSignalAnalysisProcess();
 
-    ClassDefOverride(TRestRawSignalAnalysisProcess, 5);
+    ClassDefOverride(TRestRawSignalAnalysisProcess, 6);
 };
 
 #endif
@@ -25,9 +25,8 @@
 
 #include <TRestRawSignalEvent.h>
 
-#include "TF1Convolution.h"
-#include "TH1D.h"
 #include "TRestEventProcess.h"
+#include "TRestRawPulseTemplateBank.h"
 
 //! An analysis REST process to extract valuable information from RawSignal type
 //! of data.
@@ -49,8 +48,21 @@ class TRestRawSignalConvolutionFittingProcess : public TRestEventProcess {
 
     void LoadDefaultConfig();
 
+    /// The table of the AGET pulse convoluted with a gaussian, built at InitProcess
+    TRestRawPulseTemplateBank fBank;  //!
+
+    /// The baseline corrected data inside the fit range, the model and its jacobian
+    std::vector<Double_t> fData;      //!
+    std::vector<Double_t> fModel;     //!
+    std::vector<Double_t> fTrial;     //!
+    std::vector<Double_t> fJacobian;  //!
+
+    Double_t ComputeModel(const Double_t* par, Double_t amplitude, Int_t from, std::vector<Double_t>& model);
+    Double_t FitPulse(Double_t amplitude, Int_t from, Double_t* par);
+
    protected:
-    // add here the members of your event process
+    /// The maximum number of iterations of each fit
+    Int_t fMaxIterations = 100;
 
    public:
     RESTValue GetInputEvent() const override { return fRawSignalEvent; }
@@ -77,6 +89,8 @@ class TRestRawSignalConvolutionFittingProcess : public TRestEventProcess {
     metadata << " " << endl;
         */
 
+        RESTMetadata << "Max iterations : " << fMaxIterations << RESTendl;
+
         EndPrintProcess();
     }
 
@@ -86,6 +100,6 @@ class TRestRawSignalConvolutionFittingProcess : public TRestEventProcess {
     TRestRawSignalConvolutionFittingProcess(const char* configFilename);
     ~TRestRawSignalConvolutionFittingProcess();  // Destructor
 
-    ClassDefOverride(TRestRawSignalConvolutionFittingProcess, 1);
+    ClassDefOverride(TRestRawSignalConvolutionFittingProcess, 2);
 };
 #endif
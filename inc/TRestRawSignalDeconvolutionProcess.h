@@ -0,0 +1,138 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestCore_TRestRawSignalDeconvolutionProcess
+#define RestCore_TRestRawSignalDeconvolutionProcess
+
+#include <TRestEventProcess.h>
+
+#include <complex>
+#include <map>
+
+#include "TRestRawFFT.h"
+#include "TRestRawSignalEvent.h"
+
+//! A process to recover the charge time profile of the signals by deconvolution of the detector response
+class TRestRawSignalDeconvolutionProcess : public TRestEventProcess {
+   private:
+    /// A pointer to the specific TRestRawSignalEvent input
+    TRestRawSignalEvent* fInputEvent;  //!
+
+    /// A pointer to the specific TRestRawSignalEvent output
+    TRestRawSignalEvent* fOutputEvent;  //!
+
+    /// The response, with unit integral. It is built at InitProcess.
+    std::vector<Double_t> fResponse;  //!
+
+    /// The response bin placed at the time of the charge
+    Int_t fResponseOffset = 0;  //!
+
+    /// The deconvolution filter for each FFT size, fNfft/2+1 nodes
+    std::map<Int_t, std::vector<std::complex<Double_t>>> fFilter;  //!
+
+    /// The FFT used to transform the signals
+    TRestRawFFT fFFT;  //!
+
+    void InitFromConfigFile() override;
+
+    void Initialize() override;
+
+    void LoadDefaultConfig();
+
+    void BuildResponse();
+
+    const std::vector<std::complex<Double_t>>& GetFilter(Int_t nfft);
+
+   protected:
+    /// The response type : responseFile, or any shaping type of TRestRawSignalShapingProcess
+    std::string fResponseType = "shaperSin";
+
+    /// The shaping time, in samples, used by the analytical responses
+    Double_t fShapingTime = 10.0;
+
+    /// The order of the shaper response
+    Int_t fShapingOrder = 3;
+
+    /// An ASCII file containing the response, one sample per line
+    std::string fResponseFile = "";
+
+    /// The first sample of the response inside the response file
+    Int_t fResponseStart = 0;
+
+    /// The regularization of the Wiener filter, relative to the maximum response power
+    Double_t fRegularization = 0.01;
+
+    /// A value used to scale the output signal
+    Double_t fDeconvolutionGain = 1.0;
+
+   public:
+    RESTValue GetInputEvent() const override { return fInputEvent; }
+    RESTValue GetOutputEvent() const override { return fOutputEvent; }
+
+    void InitProcess() override;
+
+    TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
+
+    void LoadConfig(const std::string& configFilename, const std::string& name = "");
+
+    inline std::string GetResponseType() const { return fResponseType; }
+    inline void SetResponseType(const std::string& type) { fResponseType = type; }
+
+    inline Double_t GetShapingTime() const { return fShapingTime; }
+    inline void SetShapingTime(Double_t shapingTime) { fShapingTime = shapingTime; }
+
+    inline Int_t GetShapingOrder() const { return fShapingOrder; }
+    inline void SetShapingOrder(Int_t order) { fShapingOrder = order; }
+
+    inline std::string GetResponseFile() const { return fResponseFile; }
+    inline void SetResponseFile(const std::string& filename) { fResponseFile = filename; }
+
+    inline Int_t GetResponseStart() const { return fResponseStart; }
+    inline void SetResponseStart(Int_t start) { fResponseStart = start; }
+
+    inline Double_t GetRegularization() const { return fRegularization; }
+    inline void SetRegularization(Double_t regularization) { fRegularization = regularization; }
+
+    inline Double_t GetDeconvolutionGain() const { return fDeconvolutionGain; }
+    inline void SetDeconvolutionGain(Double_t gain) { fDeconvolutionGain = gain; }
+
+    inline const std::vector<Double_t>& GetResponse() const { return fResponse; }
+
+    /// It prints out the process parameters stored in the metadata structure
+    void PrintMetadata() override;
+
+    /// Returns a new instance of this class
+    TRestEventProcess* Maker() { return new TRestRawSignalDeconvolutionProcess; }
+
+    /// Returns the name of this process
+    const char* GetProcessName() const override { return "deconvolution"; }
+
+    // Constructor
+    TRestRawSignalDeconvolutionProcess();
+    TRestRawSignalDeconvolutionProcess(const char* configFilename);
+
+    // Destructor
+    ~TRestRawSignalDeconvolutionProcess();
+
+    ClassDefOverride(TRestRawSignalDeconvolutionProcess, 1);
+};
+#endif
@@ -31,6 +31,7 @@
 #include <TRestRun.h>
 #include <TVector2.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -67,6 +68,13 @@ class TRestRawSignalEvent : public TRestEvent {
 
     void RemoveSignalWithId(Int_t sId);
 
+    /// It removes, in a single pass, the signals for which `remove(signal)` is true. The other signals
+    /// keep their order.
+    template <class Predicate>
+    void RemoveSignalsIf(Predicate remove) {
+        fSignal.erase(std::remove_if(fSignal.begin(), fSignal.end(), remove), fSignal.end());
+    }
+
     void AddChargeToSignal(Int_t sgnlID, Int_t bin, Short_t value);
 
     void SetTailPoints(Int_t p) {
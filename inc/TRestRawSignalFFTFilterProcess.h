@@ -0,0 +1,127 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestCore_TRestRawSignalFFTFilterProcess
+#define RestCore_TRestRawSignalFFTFilterProcess
+
+#include <TRestEventProcess.h>
+#include <TVector2.h>
+
+#include <map>
+
+#include "TRestRawFFT.h"
+#include "TRestRawSignalEvent.h"
+#include "TRestRawWorkerPool.h"
+
+//! A process to filter the signals of a TRestRawSignalEvent in the frequency domain
+class TRestRawSignalFFTFilterProcess : public TRestEventProcess {
+   private:
+    /// A pointer to the specific TRestRawSignalEvent input
+    TRestRawSignalEvent* fInputEvent;  //!
+
+    /// A pointer to the specific TRestRawSignalEvent output
+    TRestRawSignalEvent* fOutputEvent;  //!
+
+    /// The transfer function for each FFT size, fNfft/2+1 nodes
+    std::map<Int_t, std::vector<Double_t>> fTransfer;  //!
+
+    /// The FFT objects used by each filter thread
+    std::vector<TRestRawFFT> fFFT;  //!
+
+    /// The threads filtering the signals of one event
+    TRestRawWorkerPool* fWorkers = nullptr;  //!
+
+    void InitFromConfigFile() override;
+
+    void Initialize() override;
+
+    void LoadDefaultConfig();
+
+    void StartWorkers();
+
+    const std::vector<Double_t>& GetTransfer(Int_t nfft);
+
+    void FilterSignal(TRestRawSignal* input, TRestRawSignal* output, TRestRawFFT& fft);
+
+   protected:
+    /// The filter type : lowPass, butterworth or none
+    std::string fFilterType = "butterworth";
+
+    /// The cut frequency, in units of the sampling frequency (0 to 0.5)
+    Double_t fCutFrequency = 0.1;
+
+    /// The order of the butterworth filter
+    Int_t fOrder = 2;
+
+    /// The notch filters. Each one is defined by its central frequency and full width, in units of the
+    /// sampling frequency
+    std::vector<TVector2> fNotches;
+
+    /// The number of threads used to filter the signals of one event
+    Int_t fFilterThreads = 1;
+
+   public:
+    RESTValue GetInputEvent() const override { return fInputEvent; }
+    RESTValue GetOutputEvent() const override { return fOutputEvent; }
+
+    void InitProcess() override;
+
+    TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
+
+    void EndProcess() override;
+
+    void LoadConfig(const std::string& configFilename, const std::string& name = "");
+
+    inline std::string GetFilterType() const { return fFilterType; }
+    inline void SetFilterType(const std::string& type) { fFilterType = type; }
+
+    inline Double_t GetCutFrequency() const { return fCutFrequency; }
+    inline void SetCutFrequency(Double_t frequency) { fCutFrequency = frequency; }
+
+    inline Int_t GetOrder() const { return fOrder; }
+    inline void SetOrder(Int_t order) { fOrder = order; }
+
+    inline std::vector<TVector2> GetNotches() const { return fNotches; }
+    inline void AddNotch(Double_t frequency, Double_t width) { fNotches.emplace_back(frequency, width); }
+
+    inline Int_t GetFilterThreads() const { return fFilterThreads; }
+    inline void SetFilterThreads(Int_t threads) { fFilterThreads = threads; }
+
+    /// It prints out the process parameters stored in the metadata structure
+    void PrintMetadata() override;
+
+    /// Returns a new instance of this class
+    TRestEventProcess* Maker() { return new TRestRawSignalFFTFilterProcess; }
+
+    /// Returns the name of this process
+    const char* GetProcessName() const override { return "fftFilter"; }
+
+    // Constructor
+    TRestRawSignalFFTFilterProcess();
+    TRestRawSignalFFTFilterProcess(const char* configFilename);
+
+    // Destructor
+    ~TRestRawSignalFFTFilterProcess();
+
+    ClassDefOverride(TRestRawSignalFFTFilterProcess, 1);
+};
+#endif
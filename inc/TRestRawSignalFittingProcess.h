@@ -25,9 +25,11 @@
 
 #include <TRestRawSignalEvent.h>
 
-#include "TF1.h"
-#include "TH1D.h"
+#include <array>
+
 #include "TRestEventProcess.h"
+#include "TRestRawPulseFitter.h"
+#include "TRestRawWorkerPool.h"
 
 //! An analysis REST process to extract valuable information from RawSignal type
 //! of data.
@@ -45,8 +47,30 @@ class TRestRawSignalFittingProcess : public TRestEventProcess {
     Double_t fBaseline = 0;
     Double_t fAmplitude = 0;
 
+    /// The fitter used by each thread
+    std::vector<TRestRawPulseFitter> fFitters;  //!
+
+    /// The fit results of each signal in the event
+    std::vector<std::array<Double_t, TRestRawPulseFitter::kNParameters>> fFitParameters;  //!
+    std::vector<Double_t> fFitChiSquare;                                                 //!
+    std::vector<Double_t> fFitSigma;                                                     //!
+
+    /// If the fit of each signal converged. Not a vector<bool>, since it is written from several threads
+    std::vector<Char_t> fFitConverged;  //!
+
+    /// The threads used to fit the signals of one event
+    TRestRawWorkerPool* fWorkers = nullptr;  //!
+
+    void FitSignal(Int_t s, TRestRawPulseFitter& fitter);
+
+    void StartWorkers();
+
    protected:
-    // add here the members of your event process
+    /// The number of threads used to fit the signals of one event
+    Int_t fFitThreads = 1;
+
+    /// The maximum number of iterations of each fit
+    Int_t fMaxIterations = 100;
 
    public:
     RESTValue GetInputEvent() const override { return fRawSignalEvent; }
@@ -66,6 +90,9 @@ class TRestRawSignalFittingProcess : public TRestEventProcess {
     void PrintMetadata() override {
         BeginPrintProcess();
 
+        RESTMetadata << "Fit threads : " << fFitThreads << RESTendl;
+        RESTMetadata << "Max iterations : " << fMaxIterations << RESTendl;
+
         EndPrintProcess();
     }
 
@@ -75,6 +102,6 @@ class TRestRawSignalFittingProcess : public TRestEventProcess {
     TRestRawSignalFittingProcess(const char* configFilename);
     ~TRestRawSignalFittingProcess();  // Destructor
 
-    ClassDefOverride(TRestRawSignalFittingProcess, 2);
+    ClassDefOverride(TRestRawSignalFittingProcess, 3);
 };
 #endif
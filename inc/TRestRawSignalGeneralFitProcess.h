@@ -26,8 +26,8 @@
 #include <TRestRawSignalEvent.h>
 
 #include "TF1.h"
-#include "TH1D.h"
 #include "TRestEventProcess.h"
+#include "TRestRawWorkerPool.h"
 
 //! An analysis REST process to extract valuable information from RawSignal type
 //! of data.
@@ -43,8 +43,30 @@ class TRestRawSignalGeneralFitProcess : public TRestEventProcess {
     TVector2 fFunctionRange = TVector2(0, 0);
     std::string fFunction;
 
+    /// The number of threads used to fit the signals of one event
+    Int_t fFitThreads = 1;
+
+    /// The function built from fFunction at InitProcess. It holds the fit result of the last signal.
     TF1* fFitFunc = nullptr;  //!
 
+    /// The initial values of the parameters, used to start each fit
+    std::vector<Double_t> fInitialParameters;  //!
+
+    /// A copy of fFitFunc for each thread
+    std::vector<TF1*> fThreadFunctions;  //!
+
+    /// The fit results of each signal, fNpar values per signal
+    std::vector<Double_t> fParameters;       //!
+    std::vector<Double_t> fParameterErrors;  //!
+    std::vector<Double_t> fChiSquare;        //!
+    std::vector<Double_t> fSigma;            //!
+
+    /// The threads used to fit the signals of one event
+    TRestRawWorkerPool* fWorkers = nullptr;  //!
+
+    void FitSignal(Int_t s, TF1* function);
+    void DeleteFunctions();
+
     /*Double_t fShaping = 0;
     Double_t fStartPosition = 0;
     Double_t fBaseline = 0;
@@ -75,6 +97,7 @@ class TRestRawSignalGeneralFitProcess : public TRestEventProcess {
 
         RESTMetadata << "Function std::string: " << fFunction << RESTendl;
         RESTMetadata << "Range: ( " << fFunctionRange.X() << " , " << fFunctionRange.Y() << " ) " << RESTendl;
+        RESTMetadata << "Fit threads : " << fFitThreads << RESTendl;
 
         EndPrintProcess();
     }
@@ -85,6 +108,6 @@ class TRestRawSignalGeneralFitProcess : public TRestEventProcess {
     TRestRawSignalGeneralFitProcess(const char* configFilename);
     ~TRestRawSignalGeneralFitProcess();  // Destructor
 
-    ClassDefOverride(TRestRawSignalGeneralFitProcess, 2);
+    ClassDefOverride(TRestRawSignalGeneralFitProcess, 3);
 };
 #endif
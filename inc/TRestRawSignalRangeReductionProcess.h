@@ -44,6 +44,9 @@ class TRestRawSignalRangeReductionProcess : public TRestEventProcess {
 
     TVector2 fDigitizationOutputRange;
 
+    /// If true, the signals are converted inside the input event, which is returned as output event
+    Bool_t fInPlace = false;
+
    public:
     void Initialize() override;
 
@@ -53,12 +56,21 @@ class TRestRawSignalRangeReductionProcess : public TRestEventProcess {
     inline TVector2 GetDigitizationInputRange() const { return fDigitizationInputRange; }
     void SetDigitizationInputRange(const TVector2& range);
 
+    inline Bool_t IsInPlace() const { return fInPlace; }
+    inline void SetInPlace(Bool_t inPlace) { fInPlace = inPlace; }
+
     RESTValue GetInputEvent() const override { return fInputRawSignalEvent; }
-    RESTValue GetOutputEvent() const override { return fOutputRawSignalEvent; }
+    RESTValue GetOutputEvent() const override {
+        if (fInPlace) return fInputRawSignalEvent;
+        return fOutputRawSignalEvent;
+    }
 
     void InitProcess() override;
     TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
 
+    /// It converts the given signal to the target range, modifying it in place
+    void ProcessSignal(TRestRawSignal* signal);
+
     void LoadConfig(const std::string& configFilename, const std::string& name = "");
 
     Double_t ConvertFromStartingRangeToTargetRange(Double_t value) const;
@@ -70,6 +82,7 @@ class TRestRawSignalRangeReductionProcess : public TRestEventProcess {
         RESTMetadata << "Resolution in bits: " << fResolutionInBits << RESTendl;
         RESTMetadata << "Digitization range: (" << fDigitizationInputRange.X() << ", "
                      << fDigitizationInputRange.Y() << ")" << RESTendl;
+        RESTMetadata << "In place: " << (fInPlace ? "true" : "false") << RESTendl;
 
         EndPrintProcess();
     }
@@ -84,6 +97,6 @@ class TRestRawSignalRangeReductionProcess : public TRestEventProcess {
     // Destructor
     ~TRestRawSignalRangeReductionProcess();
 
-    ClassDefOverride(TRestRawSignalRangeReductionProcess, 2);
+    ClassDefOverride(TRestRawSignalRangeReductionProcess, 3);
 };
 #endif  // RestCore_TRestRawSignalRangeReductionProcess
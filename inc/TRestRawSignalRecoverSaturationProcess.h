@@ -58,6 +58,20 @@ class TRestRawSignalRecoverSaturationProcess : public TRestEventProcess {
     /// Canvas to draw the signals
     TCanvas* fC;  //!
 
+    /// The pulse normalized to its maximum, (u exp(1-u))^3, and its derivative, tabulated in u
+    std::vector<Double_t> fTemplate;            //!
+    std::vector<Double_t> fTemplateDerivative;  //!
+
+    /// The bins and values of the signal points used in the fit
+    std::vector<Int_t> fFitBins;       //!
+    std::vector<Double_t> fFitValues;  //!
+
+    void BuildTemplate();
+    Double_t EvaluateTemplate(Double_t u, Double_t* derivative = nullptr) const;
+    Double_t ComputeChiSquare(const Double_t* par) const;
+    void FitPulse(Double_t* par, Bool_t fixBaseline, Int_t firstSaturated, Int_t lastSaturated,
+                  Double_t maxValue, Int_t nPoints);
+
    public:
     RESTValue GetInputEvent() const override { return fAnaEvent; }
     RESTValue GetOutputEvent() const override { return fAnaEvent; }
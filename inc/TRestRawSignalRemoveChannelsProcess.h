@@ -52,9 +52,18 @@ class TRestRawSignalRemoveChannelsProcess : public TRestEventProcess {
 
     std::map<Int_t, std::string> fChannelTypesToRemove;
 
+    /// If true, the signals are removed from the input event, which is returned as output event
+    Bool_t fInPlace = false;
+
    public:
     RESTValue GetInputEvent() const override { return fInputEvent; }
-    RESTValue GetOutputEvent() const override { return fOutputEvent; }
+    RESTValue GetOutputEvent() const override {
+        if (fInPlace) return fInputEvent;
+        return fOutputEvent;
+    }
+
+    inline Bool_t IsInPlace() const { return fInPlace; }
+    inline void SetInPlace(Bool_t inPlace) { fInPlace = inPlace; }
 
     TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
 
@@ -79,6 +88,6 @@ class TRestRawSignalRemoveChannelsProcess : public TRestEventProcess {
     // Destructor
     ~TRestRawSignalRemoveChannelsProcess();
 
-    ClassDefOverride(TRestRawSignalRemoveChannelsProcess, 3);
+    ClassDefOverride(TRestRawSignalRemoveChannelsProcess, 4);
 };
 #endif
@@ -26,6 +26,7 @@
 #include <TRestRawSignalEvent.h>
 
 #include "TRestEventProcess.h"
+#include "TRestRawFFT.h"
 
 //! A process to convolute the input raw signal event with a given input
 //! response.
@@ -49,6 +50,38 @@ class TRestRawSignalShapingProcess : public TRestEventProcess {
     Double_t fShapingTime = 10.0;  // ns
     /// A value used to scale the input signal
     Double_t fShapingGain = 1.0;
+    /// The order n of the CR-RCn response used by the shaper type
+    Int_t fShapingOrder = 3;
+    /// The convolution engine : auto, direct, fft or iir
+    TString fShapingEngine = "auto";
+    /// If true, the shaped data replaces the input event data, and the input event is returned
+    Bool_t fInPlace = false;
+
+    /// The response, normalized to fShapingGain. It is built at InitProcess.
+    std::vector<Double_t> fResponse;  //!
+    /// The response bin placed at the time of the input sample
+    Int_t fResponseOffset = 0;  //!
+    /// True if the FFT convolution is used
+    Bool_t fUseFFT = false;  //!
+    /// True if the response is applied as a recursive filter
+    Bool_t fUseIIR = false;  //!
+
+    /// The input signal data being convoluted, and the convolution result
+    std::vector<Double_t> fInput;   //!
+    std::vector<Double_t> fOutput;  //!
+    /// The signal reused to build each output signal
+    TRestRawSignal fShapedSignal;  //!
+
+    /// The FFT size, and the response and signal spectra used by the FFT engine
+    Int_t fNfft = 0;           //!
+    TRestRawFFT fResponseFFT;  //!
+    TRestRawFFT fSignalFFT;    //!
+
+    void BuildResponse();
+    void ConvoluteSignal(const TRestRawSignal* signal);
+    void ConvoluteDirect(Int_t nBins);
+    void ConvoluteFFT(Int_t nBins);
+    void FilterIIR(Int_t nBins);
 
    public:
     inline TString GetShapingType() const { return fShapingType; }
@@ -60,11 +93,27 @@ class TRestRawSignalShapingProcess : public TRestEventProcess {
     inline Double_t GetShapingGain() const { return fShapingGain; }
     inline void SetShapingGain(Double_t shapingGain) { fShapingGain = shapingGain; }
 
+    inline Int_t GetShapingOrder() const { return fShapingOrder; }
+    inline void SetShapingOrder(Int_t order) { fShapingOrder = order; }
+
+    inline TString GetShapingEngine() const { return fShapingEngine; }
+    inline void SetShapingEngine(const TString& engine) { fShapingEngine = engine; }
+
+    inline const std::vector<Double_t>& GetResponse() const { return fResponse; }
+    inline Int_t GetResponseOffset() const { return fResponseOffset; }
+
+    inline Bool_t IsInPlace() const { return fInPlace; }
+    inline void SetInPlace(Bool_t inPlace) { fInPlace = inPlace; }
+
     RESTValue GetInputEvent() const override { return fInputSignalEvent; }
-    RESTValue GetOutputEvent() const override { return fOutputSignalEvent; }
+    RESTValue GetOutputEvent() const override {
+        if (fInPlace) return fInputSignalEvent;
+        return fOutputSignalEvent;
+    }
 
     void InitProcess() override;
     TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
+    void ProcessSignal(TRestRawSignal* signal);
     void EndProcess() override;
 
     void LoadConfig(const std::string& configFilename, const std::string& name = "");
@@ -76,6 +125,9 @@ class TRestRawSignalShapingProcess : public TRestEventProcess {
         RESTMetadata << "Shaping type : " << fShapingType << RESTendl;
         RESTMetadata << "Shaping time : " << fShapingTime << RESTendl;
         RESTMetadata << "Amplitude gain : " << fShapingGain << RESTendl;
+        if (fShapingType == "shaper") RESTMetadata << "Shaping order : " << fShapingOrder << RESTendl;
+        RESTMetadata << "Engine : " << fShapingEngine << RESTendl;
+        RESTMetadata << "In place : " << (fInPlace ? "true" : "false") << RESTendl;
         if (fShapingType == "responseFile") {
             RESTMetadata << "Response file : " << fResponseFilename << RESTendl;
         }
@@ -93,6 +145,6 @@ class TRestRawSignalShapingProcess : public TRestEventProcess {
     TRestRawSignalShapingProcess(const char* configFilename);
     ~TRestRawSignalShapingProcess();
 
-    ClassDefOverride(TRestRawSignalShapingProcess, 2);
+    ClassDefOverride(TRestRawSignalShapingProcess, 5);
 };
 #endif
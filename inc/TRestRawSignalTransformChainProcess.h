@@ -0,0 +1,140 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestCore_TRestRawSignalTransformChainProcess
+#define RestCore_TRestRawSignalTransformChainProcess
+
+#include <TRestEventProcess.h>
+
+#include <functional>
+
+#include "TRestRawReadoutMetadata.h"
+#include "TRestRawSignalEvent.h"
+
+class TRestRawBaseLineCorrectionProcess;
+class TRestRawSignalAddNoiseProcess;
+class TRestRawSignalShapingProcess;
+
+//! A process applying a chain of raw signal transforms to each signal in a single pass
+class TRestRawSignalTransformChainProcess : public TRestEventProcess {
+   private:
+    /// A pointer to the specific TRestRawSignalEvent input
+    TRestRawSignalEvent* fInputEvent;  //!
+
+    /// A pointer to the specific TRestRawSignalEvent output
+    TRestRawSignalEvent* fOutputEvent;  //!
+
+    /// A pointer to the readout metadata
+    TRestRawReadoutMetadata* fReadoutMetadata = nullptr;  //!
+
+    /// The processes of the chain, in the order they are applied. They are owned by the chain.
+    std::vector<TRestEventProcess*> fTransforms;  //!
+
+    /// The function applying each process of the chain to one signal
+    std::vector<std::function<void(TRestRawSignal*)>> fKernels;  //!
+
+    /// The baseline correction processes, which need the readout metadata
+    std::vector<TRestRawBaseLineCorrectionProcess*> fBaseLineCorrections;  //!
+
+    /// The noise processes, whose generator is keyed by the event being processed
+    std::vector<TRestRawSignalAddNoiseProcess*> fAddNoises;  //!
+
+    /// The shaping processes, which reject the events if their response is not defined
+    std::vector<TRestRawSignalShapingProcess*> fShapings;  //!
+
+    /// True if the events without signals are rejected, as it is done by the processes of the chain
+    Bool_t fRejectEmptyEvents = false;  //!
+
+    /// The signals after each process of the chain, if fKeepIntermediateEvents is enabled
+    std::vector<TRestRawSignalEvent*> fIntermediateEvents;  //!
+
+    void InitFromConfigFile() override;
+
+    void Initialize() override;
+
+    void LoadDefaultConfig();
+
+   protected:
+    /// The class names of the processes of the chain
+    std::vector<std::string> fTransformTypes;
+
+    /// If true, the signals are transformed inside the input event, which is returned as output event
+    Bool_t fInPlace = false;
+
+    /// If true, a copy of the signals is kept after each process of the chain
+    Bool_t fKeepIntermediateEvents = false;
+
+   public:
+    RESTValue GetInputEvent() const override { return fInputEvent; }
+    RESTValue GetOutputEvent() const override {
+        if (fInPlace) return fInputEvent;
+        return fOutputEvent;
+    }
+
+    void InitProcess() override;
+
+    TRestEvent* ProcessEvent(TRestEvent* inputEvent) override;
+
+    void EndProcess() override;
+
+    void LoadConfig(const std::string& configFilename, const std::string& name = "");
+
+    Bool_t AddTransform(TRestEventProcess* process);
+
+    /// Returns the number of processes in the chain
+    inline size_t GetNumberOfTransforms() const { return fTransforms.size(); }
+
+    /// Returns the process at the given position of the chain
+    inline TRestEventProcess* GetTransform(size_t n) const { return fTransforms[n]; }
+
+    /// Returns the signals of the last event after the process n of the chain, or nullptr if they are
+    /// not kept
+    inline TRestRawSignalEvent* GetIntermediateEvent(size_t n) const {
+        if (n >= fIntermediateEvents.size()) return nullptr;
+        return fIntermediateEvents[n];
+    }
+
+    inline Bool_t IsInPlace() const { return fInPlace; }
+    inline void SetInPlace(Bool_t inPlace) { fInPlace = inPlace; }
+
+    inline Bool_t IsKeepIntermediateEvents() const { return fKeepIntermediateEvents; }
+    inline void SetKeepIntermediateEvents(Bool_t keep) { fKeepIntermediateEvents = keep; }
+
+    /// It prints out the process parameters stored in the metadata structure
+    void PrintMetadata() override;
+
+    /// Returns a new instance of this class
+    TRestEventProcess* Maker() { return new TRestRawSignalTransformChainProcess; }
+
+    /// Returns the name of this process
+    const char* GetProcessName() const override { return "rawSignalTransformChain"; }
+
+    // Constructor
+    TRestRawSignalTransformChainProcess();
+    TRestRawSignalTransformChainProcess(const char* configFilename);
+
+    // Destructor
+    ~TRestRawSignalTransformChainProcess();
+
+    ClassDefOverride(TRestRawSignalTransformChainProcess, 1);
+};
+#endif
@@ -25,6 +25,9 @@
 
 #include <TRestEventProcess.h>
 #include <TRestRawSignalEvent.h>
+#include <TVector2.h>
+
+#include <set>
 
 //! A base class for any process reading a binary external file as input to REST
 class TRestRawToSignalProcess : public TRestEventProcess {
@@ -39,6 +42,42 @@ class TRestRawToSignalProcess : public TRestEventProcess {
     Long64_t totalbytesRead;
     Long64_t totalBytes;
 
+    /// Channel daq ids to be decoded. If empty, all channels not explicitly skipped are decoded
+    std::set<Int_t> fChannelIdsToKeep;
+
+    /// Channel daq ids whose samples will not be decoded
+    std::set<Int_t> fChannelIdsToSkip;
+
+    /// Channel types (as defined in TRestRawReadoutMetadata) to be decoded
+    std::vector<std::string> fChannelTypesToKeep;
+
+    /// Channel types (as defined in TRestRawReadoutMetadata) whose samples will not be decoded
+    std::vector<std::string> fChannelTypesToSkip;
+
+    /// If true, channels removed by a TRestRawSignalRemoveChannelsProcess in the chain are not decoded
+    Bool_t fSkipRemovedChannels = false;
+
+    /// A lookup table, indexed by daq id, with the channels to be skipped
+    std::vector<bool> fChannelSkipMask;  //!
+
+    /// True if channels outside the lookup table must be skipped, i.e. when a keep list is given
+    Bool_t fSkipUnlistedChannels = false;  //!
+
+    /// Only events with an id equal or larger than this value will be decoded
+    Int_t fFirstEvent = 0;
+
+    /// Only events with an id equal or smaller than this value will be decoded. If -1 there is no limit.
+    Int_t fLastEvent = -1;
+
+    /// Only one of every fPrescale events found in the input will be decoded
+    Int_t fPrescale = 1;
+
+    /// Only events with a timestamp inside this window will be decoded. Disabled if (-1,-1).
+    TVector2 fTimeWindow = TVector2(-1, -1);
+
+    /// The number of events found in the input, used for prescaling
+    Long64_t fEventCounter = 0;  //!
+
     TRestRawSignalEvent* fSignalEvent = nullptr;  //!
 #ifndef __CINT__
     FILE* fInputBinFile;  //!
@@ -50,11 +89,51 @@ class TRestRawToSignalProcess : public TRestEventProcess {
     Int_t iCurFile;                  //!
     std::vector<FILE*> fInputFiles;  //!
     std::vector<std::string> fInputFileNames;
+    std::vector<bool> fInputFileOpened;  //! true once the file has been opened, it might be closed already
     bool fgKeepFileOpen;  //! true if need to open all raw files at the beginning
 
     Int_t fShowSamples;  //!
+
+    /// Bytes of compressed input files consumed by the decompression streams
+    Long64_t fCompressedBytesRead = 0;  //!
+
+    /// Bytes delivered to the decoder by the decompression streams
+    Long64_t fDecompressedBytesRead = 0;  //!
 #endif
 
+    void InitChannelFilter();
+
+    /// It returns true if the samples of the channel with the given daq id do not need to be decoded
+    inline Bool_t IsChannelSkipped(Int_t daqId) const {
+        if (fChannelSkipMask.empty()) return false;
+        if (daqId < 0 || daqId >= (Int_t)fChannelSkipMask.size()) return fSkipUnlistedChannels;
+        return fChannelSkipMask[daqId];
+    }
+
+    /// It counts a new event found in the input and returns true if the prescale rejects it
+    inline Bool_t SkipByPrescale() {
+        Long64_t n = fEventCounter++;
+        return fPrescale > 1 && n % fPrescale != 0;
+    }
+
+    /// It returns true if the event id or timestamp are outside the selection
+    inline Bool_t IsEventOutOfSelection(Int_t eventId, Double_t timeStamp) const {
+        if (eventId < fFirstEvent || (fLastEvent >= 0 && eventId > fLastEvent)) return true;
+        if (fTimeWindow.X() != -1 && timeStamp < fTimeWindow.X()) return true;
+        if (fTimeWindow.Y() != -1 && timeStamp > fTimeWindow.Y()) return true;
+        return false;
+    }
+
+    /// It returns true if no more events will be selected, assuming event ids are increasing
+    inline Bool_t IsSelectionFinished(Int_t eventId) const { return fLastEvent >= 0 && eventId > fLastEvent; }
+
+    Bool_t SkipInputBytes(FILE* f, Long64_t nBytes);
+
+    FILE* OpenRawFile(const std::string& file);
+    FILE* GetInputFile(Int_t n);
+    void PrefetchInputFile(Int_t n);
+    void CloseInputFile(Int_t n);
+
     void LoadDefaultConfig();
 
    public:
@@ -64,6 +143,8 @@ class TRestRawToSignalProcess : public TRestEventProcess {
     virtual void InitProcess() override {
         fRunOrigin = fRunInfo->GetRunNumber();
         fSubRunOrigin = fRunInfo->GetSubRunNumber();
+        fEventCounter = 0;
+        InitChannelFilter();
     }
 
     virtual void PrintMetadata() override;
@@ -80,8 +161,17 @@ class TRestRawToSignalProcess : public TRestEventProcess {
 
     Bool_t ResetEntry() override;
 
-    Long64_t GetTotalBytesRead() const override { return totalbytesRead; }
+    /// Bytes read from disk, i.e. compressed bytes for compressed input files
+    Long64_t GetTotalBytesRead() const override {
+        return totalbytesRead - fDecompressedBytesRead + fCompressedBytesRead;
+    }
+    /// Bytes on disk, i.e. compressed bytes for compressed input files
     Long64_t GetTotalBytes() const override { return totalBytes; }
+    /// Bytes read by the decoder, after decompression. It is the same than GetTotalBytesRead for
+    /// uncompressed files
+    Long64_t GetTotalUncompressedBytesRead() const { return totalbytesRead; }
+
+    static Bool_t IsCompressedFile(const std::string& file);
     virtual std::string GetElectronicsType() const { return fElectronicsType; }
 
     Bool_t GoToNextFile();
@@ -92,6 +182,6 @@ class TRestRawToSignalProcess : public TRestEventProcess {
     // Destructor
     ~TRestRawToSignalProcess();
 
-    ClassDefOverride(TRestRawToSignalProcess, 1);
+    ClassDefOverride(TRestRawToSignalProcess, 3);
 };
 #endif
@@ -68,6 +68,15 @@ class TRestRawVetoAnalysisProcess : public TRestEventProcess {
 
     TRestRawReadoutMetadata* fReadoutMetadata = nullptr;  //!
 
+    /// The veto group of each signal id, or -1 if the signal is not a veto. The single list is group 0
+    std::vector<Int_t> fVetoGroupIndex;  //!
+
+    /// The (signal id, peak time) and (signal id, max amplitude) maps of each group in the event
+    std::vector<std::map<int, Double_t>> fGroupPeakTime;          //!
+    std::vector<std::map<int, Double_t>> fGroupMaxPeakAmplitude;  //!
+
+    void AddVetoToGroup(Int_t signalId, Int_t group);
+
     void InitFromConfigFile() override;
 
     void Initialize() override;
@@ -0,0 +1,63 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+#ifndef RestCore_TRestRawWorkerPool
+#define RestCore_TRestRawWorkerPool
+
+#include <Rtypes.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! A set of threads, kept between events, running the same task with a different index
+class TRestRawWorkerPool {
+   private:
+    /// The threads 1 to N-1. The thread 0 is the calling thread
+    std::vector<std::thread> fThreads;  //!
+
+    std::mutex fMutex;                                  //!
+    std::condition_variable fWake;                      //!
+    std::condition_variable fDone;                      //!
+    const std::function<void(Int_t)>* fTask = nullptr;  //!
+    size_t fGeneration = 0;                             //!
+    size_t fPending = 0;                                //!
+    Bool_t fStop = false;                               //!
+
+    void Loop(Int_t thread);
+
+   public:
+    /// It returns the number of threads, including the calling one
+    inline Int_t GetNumberOfThreads() const { return fThreads.size() + 1; }
+
+    void Run(const std::function<void(Int_t)>& task);
+
+    void ForEach(Int_t nItems, const std::function<void(Int_t, Int_t)>& work);
+
+    TRestRawWorkerPool(Int_t nThreads = 1);
+    ~TRestRawWorkerPool();
+
+    ClassDef(TRestRawWorkerPool, 1);
+};
+#endif
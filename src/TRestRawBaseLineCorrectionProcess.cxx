@@ -28,8 +28,20 @@
 ///   verboseLevel="silent">
 ///       <parameter name="signalsRange" value="(4610,4900)" />
 ///       <parameter name="smoothingWindow" value="75" />
+///       <parameter name="smoothingMethod" value="median" />
 ///   </addProcess>
 /// \endcode
+///
+/// The parameter "smoothingMethod" defines how the baseline is estimated inside the smoothing window:
+/// - average : The moving average, where the points far from the signal baseline are replaced by the
+///   baseline. The baseline is calculated first, with the "ROBUST" option. This is the default.
+/// - median : The running median. It does not need a previous baseline calculation, and it is not
+///   affected by the pulses shorter than half the window.
+///
+/// If the parameter "inPlace" is set to true the signals are corrected inside
+/// the input event, which is then returned as the output event. The signals
+/// that are not corrected are not copied, and the signals keep their order.
+///
 /// \htmlonly <style>div.image
 /// img[src="doc_TRestRawBaseLineCorrectionProcess1.png"]{width:750px;}</style>\endhtmlonly
 ///
@@ -61,6 +73,8 @@
 ///
 /// 2022-Mar:  First implementation
 ///             Konrad Altenmueller
+///
+/// 2026-October: In place mode. Running median smoothing method.
 /// \class TRestRawBaseLineCorrectionProcess
 /// \author     Konrad Altenmueller
 ///
@@ -107,6 +121,13 @@ TRestEvent* TRestRawBaseLineCorrectionProcess::ProcessEvent(TRestEvent* inputEve
         exit(1);
     }
 
+    if (fInPlace) {
+        for (int s = 0; s < fInputEvent->GetNumberOfSignals(); s++) {
+            ProcessSignal(fInputEvent->GetSignal(s));
+        }
+        return fInputEvent;
+    }
+
     for (int s = 0; s < fInputEvent->GetNumberOfSignals(); s++) {
         TRestRawSignal* signal = fInputEvent->GetSignal(s);
         const UShort_t signalId = signal->GetSignalID();
@@ -128,7 +149,7 @@ TRestEvent* TRestRawBaseLineCorrectionProcess::ProcessEvent(TRestEvent* inputEve
         }
 
         TRestRawSignal signalCorrected;
-        signal->GetBaseLineCorrected(&signalCorrected, fSmoothingWindow);
+        signal->GetBaseLineCorrected(&signalCorrected, fSmoothingWindow, fSmoothingOption);
         signalCorrected.SetID(signal->GetID());
         fOutputEvent->AddSignal(signalCorrected);
     }
@@ -136,7 +157,48 @@ TRestEvent* TRestRawBaseLineCorrectionProcess::ProcessEvent(TRestEvent* inputEve
     return fOutputEvent;
 }
 
-void TRestRawBaseLineCorrectionProcess::InitProcess() {}
+///////////////////////////////////////////////
+/// \brief It corrects the baseline of the given signal, which is modified in place. The signals
+/// excluded by the channel type or the signals range are left untouched.
+///
+/// The result is the same than the signal added to the output event by ProcessEvent. If channel types
+/// are defined, the readout metadata must have been set before.
+///
+void TRestRawBaseLineCorrectionProcess::ProcessSignal(TRestRawSignal* signal) {
+    if (!fChannelTypes.empty()) {
+        if (fReadoutMetadata == nullptr) {
+            cerr << "TRestRawBaseLineCorrectionProcess::ProcessSignal: readout metadata is null, cannot "
+                    "filter the process by signal type"
+                 << endl;
+            exit(1);
+        }
+        const string channelType = fReadoutMetadata->GetTypeForChannelDaqId(signal->GetSignalID());
+        if (fChannelTypes.find(channelType) == fChannelTypes.end()) return;
+    }
+
+    if (fRangeEnabled && (signal->GetID() < fSignalsRange.X() || signal->GetID() > fSignalsRange.Y())) {
+        return;
+    }
+
+    // Same values than GetBaseLineCorrected, written over the signal data
+    const vector<Float_t> averagedSignal = signal->GetSignalSmoothed(fSmoothingWindow, fSmoothingOption);
+    for (int i = 0; i < signal->GetNumberOfPoints(); i++) {
+        signal->SetPoint(i, signal->GetRawData(i) - averagedSignal[i]);
+    }
+    signal->ResetCalculatedValues();
+}
+
+void TRestRawBaseLineCorrectionProcess::InitProcess() {
+    if (fSmoothingMethod == "median") {
+        fSmoothingOption = "MEDIAN";
+    } else {
+        if (fSmoothingMethod != "average")
+            RESTWarning << "Smoothing method : " << fSmoothingMethod << " is not defined. Using average."
+                        << RESTendl;
+        fSmoothingMethod = "average";
+        fSmoothingOption = "EXCLUDE OUTLIERS";
+    }
+}
 
 void TRestRawBaseLineCorrectionProcess::InitFromConfigFile() {
     if (fSignalsRange.X() != -1 && fSignalsRange.Y() != -1) {
@@ -150,6 +212,8 @@ void TRestRawBaseLineCorrectionProcess::InitFromConfigFile() {
 
     fSignalsRange = Get2DVectorParameterWithUnits("signalsRange", fSignalsRange);
     fSmoothingWindow = (Int_t)StringToDouble(GetParameter("smoothingWindow", double(fSmoothingWindow)));
+    fSmoothingMethod = GetParameter("smoothingMethod", fSmoothingMethod);
+    fInPlace = StringToBool(GetParameter("inPlace", fInPlace));
 }
 
 void TRestRawBaseLineCorrectionProcess::PrintMetadata() {
@@ -166,8 +230,10 @@ void TRestRawBaseLineCorrectionProcess::PrintMetadata() {
     }
 
     RESTMetadata << "Smoothing window size: " << fSmoothingWindow << RESTendl;
+    RESTMetadata << "Smoothing method: " << fSmoothingMethod << RESTendl;
     RESTMetadata << "Baseline correction applied to signals with IDs in range (" << fSignalsRange.X() << ","
                  << fSignalsRange.Y() << ")" << RESTendl;
+    RESTMetadata << "In place: " << (fInPlace ? "true" : "false") << RESTendl;
 
     EndPrintProcess();
 }
@@ -39,16 +39,28 @@
 /// of these bins is used to do the correction.
 ///
 /// Common noise identification in all signals or by blocks
-/// Written with TREX-DM architecture in mind (8 blocks with 68 signals each
-/// and gap of 4 ID between blocks)
 ///
 /// * **Blocks = 0**: All signals together.
 ///
-/// * **Blocks = 1**: 8 groups of signals, independent common noise reduction
-/// process for each group.
+/// * **Blocks = 1**: Independent common noise reduction process for each
+/// block of *blockSize* consecutive DAQ channels, 72 by default, i.e. one
+/// AGET/AFTER chip. Use 288 to group the channels of a full card. If readout
+/// metadata is available only the channels defined there are used. Only the
+/// signals with a baseline sigma above 3.3 in the bins (20, 500) are corrected.
+/// The blocks of one event may be processed in parallel using *blockThreads*
+/// threads. The blocks and the threads are prepared at InitProcess, and the
+/// threads are kept until EndProcess.
 ///
 /// Output signal without base line subtraction.
 ///
+/// If *inPlace* is true the signals are corrected inside the input event,
+/// which is returned as the output event. The ignored signals are then not
+/// copied, and all the signals keep their input order.
+///
+/// The signals are transposed into a time bins x channels table, and the
+/// ranked values of each time bin are obtained by partial selection
+/// (std::nth_element), which gives the same result than a full sort.
+///
 /// <hr>
 ///
 /// \warning **⚠ REST is under continuous development.** This
@@ -77,6 +89,11 @@
 /// 2020-October: Base line not subtracted.
 ///            David Diez
 ///
+/// 2026-October: Transposed kernel using partial selection. Blocks defined
+///            from the readout metadata.
+///
+/// 2026-October: In place mode.
+///
 /// \class      TRestRawCommonNoiseReductionProcess
 /// \author     Benjamin Manier
 /// \author     David Diez
@@ -124,6 +141,7 @@ TRestRawCommonNoiseReductionProcess::TRestRawCommonNoiseReductionProcess(const c
 TRestRawCommonNoiseReductionProcess::~TRestRawCommonNoiseReductionProcess() {
     delete fInputEvent;
     delete fOutputEvent;
+    delete fWorkers;
 }
 
 ///////////////////////////////////////////////
@@ -162,9 +180,48 @@ void TRestRawCommonNoiseReductionProcess::LoadConfig(const string& configFilenam
 }
 
 ///////////////////////////////////////////////
-/// \brief Process initialization.
+/// \brief Process initialization. It defines the blocks and starts the block threads.
 ///
-void TRestRawCommonNoiseReductionProcess::InitProcess() {}
+void TRestRawCommonNoiseReductionProcess::InitProcess() {
+    if (fReadoutMetadata == nullptr && GetRunInfo() != nullptr) {
+        fReadoutMetadata =
+            dynamic_cast<TRestRawReadoutMetadata*>(GetRunInfo()->GetMetadataClass("TRestRawReadoutMetadata"));
+    }
+
+    InitBlocks();
+    StartWorkers();
+}
+
+///////////////////////////////////////////////
+/// \brief It (re)creates the block threads and the working buffers of each thread
+///
+void TRestRawCommonNoiseReductionProcess::StartWorkers() {
+    delete fWorkers;
+    fWorkers = new TRestRawWorkerPool(fBlocks == 1 ? max(1, fBlockThreads) : 1);
+
+    fTile.resize(fWorkers->GetNumberOfThreads());
+    fCorrection.resize(fTile.size());
+}
+
+///////////////////////////////////////////////
+/// \brief It prepares the blocks definition.
+///
+/// If readout metadata is available only the DAQ channels defined there are
+/// assigned to a block, and the block index of each channel is computed here
+/// once.
+///
+void TRestRawCommonNoiseReductionProcess::InitBlocks() {
+    if (fBlockSize <= 0) fBlockSize = 72;
+
+    fChannelBlock.clear();
+    if (fReadoutMetadata != nullptr) {
+        for (const auto daqId : fReadoutMetadata->GetChannelDaqIDs()) {
+            if (!fChannelType.empty() && fReadoutMetadata->GetTypeForChannelDaqId(daqId) != fChannelType)
+                continue;
+            fChannelBlock[daqId] = daqId / fBlockSize;
+        }
+    }
+}
 
 ///////////////////////////////////////////////
 /// \brief The main processing event function
@@ -177,15 +234,21 @@ TRestEvent* TRestRawCommonNoiseReductionProcess::ProcessEvent(TRestEvent* inputE
         fInputEvent->InitializeReferences(run);
     }
 
+    TRestRawSignalEvent* outputEvent = fInPlace ? fInputEvent : fOutputEvent;
+
     if (fInputEvent->GetNumberOfSignals() < fMinSignalsRequired) {
-        for (int signal = 0; signal < fInputEvent->GetNumberOfSignals(); signal++) {
-            fOutputEvent->AddSignal(*fInputEvent->GetSignal(signal));
+        if (!fInPlace) {
+            for (int signal = 0; signal < fInputEvent->GetNumberOfSignals(); signal++) {
+                fOutputEvent->AddSignal(*fInputEvent->GetSignal(signal));
+            }
         }
-        return fOutputEvent;
+        return outputEvent;
     }
 
     if (fReadoutMetadata == nullptr) {
         fReadoutMetadata = fInputEvent->GetReadoutMetadata();
+        // The blocks were defined without readout metadata
+        if (fReadoutMetadata != nullptr) InitBlocks();
     }
 
     if (fReadoutMetadata == nullptr && !fChannelType.empty()) {
@@ -195,188 +258,146 @@ TRestEvent* TRestRawCommonNoiseReductionProcess::ProcessEvent(TRestEvent* inputE
         exit(1);
     }
 
-    vector<TRestRawSignal*> signalsToProcess;
+    // The signals to be corrected. In place they are the input signals, and the ignored signals are
+    // left untouched. Otherwise the ignored signals are copied first, followed by the copies to correct.
+    vector<TRestRawSignal*> signals;
     vector<TRestRawSignal*> signalsToIgnore;
-
-    if (fChannelType.empty()) {
-        for (int signal = 0; signal < fInputEvent->GetNumberOfSignals(); signal++) {
-            signalsToProcess.push_back(fInputEvent->GetSignal(signal));
-        }
-    } else {
-        for (int signal = 0; signal < fInputEvent->GetNumberOfSignals(); signal++) {
-            TRestRawSignal* signalPtr = fInputEvent->GetSignal(signal);
-            const UShort_t signalId = signalPtr->GetSignalID();
-            const string channelType = fReadoutMetadata->GetTypeForChannelDaqId(signalId);
-
-            if (fChannelType == channelType) {
-                signalsToProcess.push_back(signalPtr);
-            } else {
-                signalsToIgnore.push_back(signalPtr);
-            }
+    for (int signal = 0; signal < fInputEvent->GetNumberOfSignals(); signal++) {
+        TRestRawSignal* signalPtr = fInputEvent->GetSignal(signal);
+        const UShort_t signalId = signalPtr->GetSignalID();
+        if (fChannelType.empty() || fReadoutMetadata->GetTypeForChannelDaqId(signalId) == fChannelType) {
+            signals.push_back(signalPtr);
+        } else {
+            signalsToIgnore.push_back(signalPtr);
         }
     }
 
-    // add signals to ignore to the event
-    for (auto signal : signalsToIgnore) {
-        fOutputEvent->AddSignal(*signal);
-    }
+    if (!fInPlace) {
+        for (auto signal : signalsToIgnore) fOutputEvent->AddSignal(*signal);
+
+        Int_t first = fOutputEvent->GetNumberOfSignals();
+        for (auto signal : signals) fOutputEvent->AddSignal(*signal);
 
-    auto eventToProcess = TRestRawSignalEvent();
-    for (auto signal : signalsToProcess) {
-        eventToProcess.AddSignal(*signal);
+        signals.clear();
+        for (int signal = first; signal < fOutputEvent->GetNumberOfSignals(); signal++)
+            signals.push_back(fOutputEvent->GetSignal(signal));
     }
 
     // Event baseline determination.
     Double_t baseLineMean = 0;
-    for (int signal = 0; signal < eventToProcess.GetNumberOfSignals(); signal++) {
-        eventToProcess.GetSignal(signal)->CalculateBaseLine(20, 150);
-        Double_t baseline = eventToProcess.GetSignal(signal)->GetBaseLine();
+    for (auto signal : signals) {
+        signal->CalculateBaseLine(20, 150);
+        Double_t baseline = signal->GetBaseLine();
         baseLineMean += baseline;
     }
-    Double_t Baseline = baseLineMean / eventToProcess.GetNumberOfSignals();
+    Double_t Baseline = baseLineMean / signals.size();
+
+    // The threads are stopped at EndProcess, and they are not started if InitProcess was not called
+    if (fWorkers == nullptr) StartWorkers();
 
     if (fBlocks == 0) {
-        Int_t N = eventToProcess.GetNumberOfSignals();
+        SubtractCommonNoise(signals, Baseline, fTile[0], fCorrection[0]);
 
-        // if (GetVerboseLevel() >= REST_Debug) N = 1;
-        for (int signal = 0; signal < N; signal++) {
-            fOutputEvent->AddSignal(*eventToProcess.GetSignal(signal));
+        return outputEvent;
+    } else if (fBlocks == 1) {
+        // Only the noisy channels of each block take part in the correction
+        map<Int_t, vector<TRestRawSignal*>> blockSignals;
+        for (auto sgnl : signals) {
+            sgnl->CalculateBaseLine(20, 500);
+            if (sgnl->GetBaseLineSigma() < 3.3) continue;
+
+            Int_t block = sgnl->GetSignalID() / fBlockSize;
+            if (!fChannelBlock.empty()) {
+                auto it = fChannelBlock.find(sgnl->GetSignalID());
+                if (it == fChannelBlock.end()) continue;
+                block = it->second;
+            }
+            blockSignals[block].push_back(sgnl);
         }
 
-        Int_t nBins = eventToProcess.GetSignal(0)->GetNumberOfPoints();
-        vector<Double_t> signalValues(N, 0.0);
+        vector<vector<TRestRawSignal*>> blocks;
+        blocks.reserve(blockSignals.size());
+        for (auto& block : blockSignals) blocks.push_back(std::move(block.second));
 
-        for (Int_t bin = 0; bin < nBins; bin++) {
-            for (Int_t signal = 0; signal < N; signal++) {
-                signalValues[signal] = fOutputEvent->GetSignal(signal)->GetRawData(bin);
-            }
+        // The blocks contain different signals, so that they can be corrected at the same time
+        fWorkers->ForEach(blocks.size(), [&](Int_t block, Int_t thread) {
+            SubtractCommonNoise(blocks[block], Baseline, fTile[thread], fCorrection[thread]);
+        });
 
-            std::sort(signalValues.begin(), signalValues.end());
-
-            // Sorting the different methods
-            Int_t begin = 0, middle = 0, end = 0;
-            middle = (Int_t)N / 2;
-            Double_t norm = 1.0;
-
-            if (fMode == 0) {
-                // We take only the middle one
-                begin = (Int_t)((double_t)N / 2.0);
-                end = begin;
-                norm = 1.;
-            } else if (fMode == 1) {
-                // We take the average of the TRestDetectorSignals at the Center
-                begin = middle - (Int_t)(N * fCenterWidth * 0.01);
-                end = middle + (Int_t)(N * fCenterWidth * 0.01);
-                norm = (Double_t)end - begin;
-            }
+        return outputEvent;
+    }
+    return nullptr;
+}
+
+///////////////////////////////////////////////
+/// \brief It subtracts the common noise of the given signals, and adds baseLine to them.
+///
+/// The signals are first transposed into a time bins x channels tile, so that
+/// the values of each time bin are contiguous. The median (mode 0), or the
+/// central band (mode 1), of each row is then obtained using a partial
+/// selection instead of a full sort. Finally, the correction of each bin is
+/// added to every signal in a single pass over its data.
+///
+void TRestRawCommonNoiseReductionProcess::SubtractCommonNoise(const vector<TRestRawSignal*>& signals,
+                                                              Double_t baseLine, vector<Short_t>& tile,
+                                                              vector<Double_t>& correction) {
+    const Int_t N = signals.size();
+    if (N == 0) return;
+
+    Int_t nBins = signals[0]->GetNumberOfPoints();
+    for (const auto signal : signals) nBins = min(nBins, signal->GetNumberOfPoints());
+
+    // The range of ranked values used for the correction
+    Int_t begin = 0, middle = N / 2, end = 0;
+    Double_t norm = 1.0;
+    if (fMode == 0) {
+        // We take only the middle one
+        begin = middle;
+        end = begin;
+        norm = 1.;
+    } else if (fMode == 1) {
+        // We take the average of the TRestDetectorSignals at the Center
+        begin = middle - (Int_t)(N * fCenterWidth * 0.01);
+        end = middle + (Int_t)(N * fCenterWidth * 0.01);
+        norm = (Double_t)end - begin;
+    }
+    begin = max(begin, 0);
+    end = min(end, N - 1);
 
-            // Calculation of the correction to be made to each TRestRawSignal
-            Double_t binCorrection = 0.0;
-            for (Int_t i = begin; i <= end; i++) binCorrection += signalValues[i];
+    tile.resize((size_t)nBins * N);
+    for (Int_t signal = 0; signal < N; signal++) {
+        const Short_t* data = signals[signal]->GetSignalData();
+        for (Int_t bin = 0; bin < nBins; bin++) tile[(size_t)bin * N + signal] = data[bin];
+    }
 
-            binCorrection = binCorrection / norm;
+    correction.resize(nBins);
+    for (Int_t bin = 0; bin < nBins; bin++) {
+        Short_t* row = &tile[(size_t)bin * N];
 
-            // Correction applied.
-            for (Int_t signal = 0; signal < N; signal++)
-                fOutputEvent->GetSignal(signal)->IncreaseBinBy(bin, Baseline - binCorrection);
-        }
+        // After both selections the positions begin to end hold the same values than a sorted row
+        std::nth_element(row, row + begin, row + N);
+        if (end > begin) std::nth_element(row + begin + 1, row + end, row + N);
 
-        return fOutputEvent;
-    } else if (fBlocks == 1) {
-        Int_t N = 68;
-        Int_t nBlocks = 8;
-        Int_t firstID = 578;
-        Int_t gap = 4;
-
-        Int_t firstInBlock;
-        Int_t nSign;
-        Int_t sigID;
-
-        for (int block = 0; block < nBlocks; block++) {
-            firstInBlock = firstID + block * (N + gap);
-            nSign = 0;
-            // if (GetVerboseLevel() >= REST_Debug) N = 1;
-
-            for (Int_t signal = 0; signal < N; signal++) {
-                sigID = firstInBlock + signal;
-                eventToProcess.GetSignalById(sigID)->CalculateBaseLine(20, 500);
-                if (eventToProcess.GetSignalById(sigID)->GetBaseLineSigma() >= 3.3) {
-                    // debug << "Baseline1: " <<
-                    // eventToProcess.GetSignalById(sigID)->GetBaseLineSigma() <<
-                    // endl;
-                    fOutputEvent->AddSignal(*eventToProcess.GetSignalById(sigID));
-                    nSign++;
-                }
-            }
+        // The values are integers, so the sum does not depend on their order
+        Double_t binCorrection = 0.0;
+        for (Int_t i = begin; i <= end; i++) binCorrection += row[i];
 
-            Int_t nBins = eventToProcess.GetSignal(0)->GetNumberOfPoints();
-            vector<Double_t> signalValues(nSign, 0.0);
-
-            // debug << "nSign: " << nSign << endl;
-
-            for (Int_t bin = 0; bin < nBins; bin++) {
-                int i = 0;
-                for (Int_t signal = 0; signal < N; signal++) {
-                    sigID = firstInBlock + signal;
-                    if (eventToProcess.GetSignalById(sigID)->GetBaseLineSigma() >= 3.3) {
-                        // debug << "Baseline2: " <<
-                        // eventToProcess.GetSignalById(sigID)->GetBaseLineSigma() <<
-                        // endl;
-                        // debug << fOutputEvent->GetSignalById(sigID)->GetRawData(bin) <<
-                        // endl;
-                        signalValues[i] = fOutputEvent->GetSignalById(sigID)->GetRawData(bin);
-                        i++;
-                    }
-                }
-
-                std::sort(signalValues.begin(), signalValues.end());
-
-                // Sorting the different methods
-                Int_t begin = 0, middle = 0, end = 0;
-                middle = (Int_t)nSign / 2;
-                Double_t norm = 1.0;
-
-                if (fMode == 0) {
-                    // We take only the middle one
-                    begin = (Int_t)((double_t)nSign / 2.0);
-                    end = begin;
-                    norm = 1.;
-                } else if (fMode == 1) {
-                    // We take the average of the TRestDetectorSignals at the Center
-                    begin = middle - (Int_t)(nSign * fCenterWidth * 0.01);
-                    end = middle + (Int_t)(nSign * fCenterWidth * 0.01);
-                    norm = (Double_t)end - begin;
-                }
-
-                // Calculation of the correction to be made to each TRestRawSignal
-                Double_t binCorrection = 0.0;
-                for (Int_t i = begin; i <= end; i++) {
-                    binCorrection += signalValues[i];
-                }
-
-                binCorrection = binCorrection / norm;
-
-                // Correction applied.
-                for (Int_t signal = 0; signal < N; signal++) {
-                    if (eventToProcess.GetSignalById(firstInBlock + signal)->GetBaseLineSigma() >= 3.3) {
-                        fOutputEvent->GetSignalById(firstInBlock + signal)
-                            ->IncreaseBinBy(bin, Baseline - binCorrection);
-                    }
-                }
-            }
-            for (int signal = 0; signal < N; signal++) {
-                if (eventToProcess.GetSignalById(firstInBlock + signal)->GetBaseLineSigma() < 3.3) {
-                    fOutputEvent->AddSignal(*eventToProcess.GetSignalById(firstInBlock + signal));
-                }
-            }
-        }
-        return fOutputEvent;
+        correction[bin] = baseLine - binCorrection / norm;
+    }
+
+    // Correction applied. Same conversion than TRestRawSignal::IncreaseBinBy.
+    const Double_t* binCorrection = correction.data();
+    for (const auto signal : signals) {
+        Short_t* data = signal->GetSignalData();
+        for (Int_t bin = 0; bin < nBins; bin++) data[bin] = (Short_t)(data[bin] + binCorrection[bin]);
     }
-    return nullptr;
 }
 
 ///////////////////////////////////////////////
 /// \brief Function to include required actions after all events have been
 /// processed. This method will write the channels histogram.
 ///
-void TRestRawCommonNoiseReductionProcess::EndProcess() {}
+void TRestRawCommonNoiseReductionProcess::EndProcess() {
+    delete fWorkers;
+    fWorkers = nullptr;
+}
@@ -101,6 +101,8 @@ void TRestRawFEUDreamToSignalProcess::InitProcess() {
     tStart = 0;  // timeStamp of the run initially set to 0
     RESTInfo << "TRestRawFEUDreamToSignalProcess::InitProcess" << RESTendl;
 
+    InitChannelFilter();
+
     totalbytesRead = 0;
 }
 
@@ -354,7 +356,7 @@ bool TRestRawFEUDreamToSignalProcess::ReadDreamData(FeuReadOut& Feu) {
                          "ferror "
                       << ferror(fInputBinFile) << " feof " << feof(fInputBinFile) << " fInputBinFile "
                       << fInputBinFile << RESTendl;
-            fclose(fInputBinFile);
+            CloseInputFile(iCurFile);
             return true;  // failed
         }
         // debug<<" Reading DreamData ok, nbytes "<<nbytes<<endl;
@@ -415,7 +417,9 @@ bool TRestRawFEUDreamToSignalProcess::ReadDreamData(FeuReadOut& Feu) {
                     Feu.physChannel = Feu.asicN * NstripMax + Feu.channelN;  // channel's number on the DREAM
 
                     // loop on samples
-                    if (Feu.physChannel < MaxPhysChannel) {
+                    if (IsChannelSkipped(Feu.physChannel)) {
+                        // samples of skipped channels are not stored
+                    } else if (Feu.physChannel < MaxPhysChannel) {
                         Int_t sgnlIndex = fSignalEvent->GetSignalIndex(Feu.physChannel);
                         if (sgnlIndex == -1) {
                             sgnlIndex = fSignalEvent->GetNumberOfSignals();
@@ -471,7 +475,9 @@ bool TRestRawFEUDreamToSignalProcess::ReadDreamData(FeuReadOut& Feu) {
                                 << RESTendl;
                 }
 
-                if (Feu.physChannel < MaxPhysChannel) {
+                if (IsChannelSkipped(Feu.physChannel)) {
+                    // samples of skipped channels are not stored
+                } else if (Feu.physChannel < MaxPhysChannel) {
                     Int_t sgnlIndex = fSignalEvent->GetSignalIndex(Feu.physChannel);
                     if (sgnlIndex == -1) {
                         sgnlIndex = fSignalEvent->GetNumberOfSignals();
@@ -565,7 +571,7 @@ bool TRestRawFEUDreamToSignalProcess::ReadFeuTrailer(FeuReadOut& Feu) {
                 << "TRestRawFEUDreamToSignalProcess::ReadFeuTrailer: can't read new data from file, ferror "
                 << ferror(fInputBinFile) << " feof " << feof(fInputBinFile) << " fInputBinFile "
                 << fInputBinFile << RESTendl;
-            fclose(fInputBinFile);
+            CloseInputFile(iCurFile);
             return true;  // failed
         }
         RESTDebug << "TRestRawFEUDreamToSignalProcess::ReadFeuTrailer: Reading FeuTrailer ok, nbytes "
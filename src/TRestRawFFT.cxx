@@ -18,14 +18,64 @@
 #include "TRestRawFFT.h"
 
 #include <TComplex.h>
+#include <TRestRawSignalEvent.h>
 #include <TVirtualFFT.h>
 
+#include <map>
+#include <mutex>
+
 using namespace std;
 
 ClassImp(TRestRawFFT);
 
+namespace {
+/// The FFTW planner is not thread safe, plans must be created and destroyed one at a time
+std::mutex fftPlannerMutex;
+
+/// The forward (R2C) and backward (C2R) plans for one FFT size
+struct RawFFTPlans {
+    TVirtualFFT* forward = nullptr;
+    TVirtualFFT* backward = nullptr;
+};
+
+/// The plans of each FFT size used by one thread. Each thread owns its plans
+/// and their arrays, so that the transforms can run in parallel.
+class RawFFTPlanCache {
+   public:
+    ~RawFFTPlanCache() {
+        std::lock_guard<std::mutex> lock(fftPlannerMutex);
+        for (auto& plans : fPlans) {
+            delete plans.second.forward;
+            delete plans.second.backward;
+        }
+    }
+
+    RawFFTPlans& Get(Int_t n) {
+        auto it = fPlans.find(n);
+        if (it != fPlans.end()) return it->second;
+
+        std::lock_guard<std::mutex> lock(fftPlannerMutex);
+        RawFFTPlans& plans = fPlans[n];
+        plans.forward = TVirtualFFT::FFT(1, &n, "R2C M K");
+        plans.backward = TVirtualFFT::FFT(1, &n, "C2R M K");
+        if (plans.forward == nullptr || plans.backward == nullptr)
+            cout << "TRestRawFFT. Error! FFT is not available in this ROOT installation" << endl;
+        return plans;
+    }
+
+   private:
+    std::map<Int_t, RawFFTPlans> fPlans;
+};
+
+RawFFTPlans& GetRawFFTPlans(Int_t n) {
+    thread_local RawFFTPlanCache cache;
+    return cache.Get(n);
+}
+}  // namespace
+
 TRestRawFFT::TRestRawFFT() {
     // TRestRawFFT default constructor
+    fNfft = 0;
 }
 
 TRestRawFFT::~TRestRawFFT() {
@@ -35,75 +85,94 @@ TRestRawFFT::~TRestRawFFT() {
 void TRestRawFFT::SetNfft(Int_t n) {
     fNfft = n;
 
-    fTimeReal.Set(fNfft);
-    fTimeImg.Set(fNfft);
-    fFrequencyReal.Set(fNfft);
-    fFrequencyImg.Set(fNfft);
-}
-
-Double_t TRestRawFFT::GetFrequencyNorm2(Int_t n) {
-    Double_t norm2 = fFrequencyReal.GetArray()[n] * fFrequencyReal.GetArray()[n] +
-                     fFrequencyImg.GetArray()[n] * fFrequencyImg.GetArray()[n];
-
-    return norm2;
+    fTime.resize(fNfft);
+    fFrequency.resize(fNfft);
 }
 
 void TRestRawFFT::ForwardSignalFFT(TRestRawSignal* sgnl, Int_t fNStart, Int_t fNEnd) {
     Int_t n = sgnl->GetNumberOfPoints() - fNStart - fNEnd;
     SetNfft(n);
 
-    for (int i = fNStart; i < sgnl->GetNumberOfPoints() - fNEnd; i++) {
-        fTimeReal[i - fNStart] = sgnl->GetData(i);
-        fTimeImg[i - fNStart] = 0;
-    }
+    for (int i = fNStart; i < sgnl->GetNumberOfPoints() - fNEnd; i++) fTime[i - fNStart] = sgnl->GetData(i);
 
-    TVirtualFFT* forward = TVirtualFFT::FFT(1, &fNfft, "R2C");
-    forward->SetPointsComplex(fTimeReal.GetArray(), fTimeImg.GetArray());
-    forward->Transform();
+    Forward();
+}
 
-    for (int i = 0; i < fNfft; i++)
-        forward->GetPointComplex(i, fFrequencyReal.GetArray()[i], fFrequencyImg.GetArray()[i]);
+///////////////////////////////////////////////
+/// It transforms the given time data using nfft points. The data is padded
+/// with zeros, or truncated, to nfft points.
+///
+void TRestRawFFT::ForwardFFT(const vector<Double_t>& data, Int_t nfft) {
+    SetNfft(nfft);
+
+    const Int_t n = min((Int_t)data.size(), nfft);
+    for (int i = 0; i < n; i++) fTime[i] = data[i];
+    for (int i = n; i < nfft; i++) fTime[i] = 0;
+
+    Forward();
+}
+
+///////////////////////////////////////////////
+/// It transforms fTime into fFrequency, using the cached plan of this thread.
+///
+/// The transform only provides the first fNfft/2+1 nodes. The rest are the
+/// complex conjugate of those.
+///
+void TRestRawFFT::Forward() {
+    TVirtualFFT* forward = GetRawFFTPlans(fNfft).forward;
+    if (forward == nullptr) return;
+
+    forward->SetPoints(fTime.data());
+    forward->Transform();
+    forward->GetPointsComplex(reinterpret_cast<Double_t*>(fFrequency.data()));
 
-    delete forward;
+    for (int i = fNfft / 2 + 1; i < fNfft; i++) fFrequency[i] = conj(fFrequency[fNfft - i]);
 }
 
 void TRestRawFFT::BackwardFFT() {
-    TVirtualFFT* backward = TVirtualFFT::FFT(1, &fNfft, "C2R");
-    backward->SetPointsComplex(fFrequencyReal.GetArray(), fFrequencyImg.GetArray());
+    TVirtualFFT* backward = GetRawFFTPlans(fNfft).backward;
+    if (backward == nullptr) return;
+
+    // Only the first fNfft/2+1 nodes are used
+    backward->SetPoints(reinterpret_cast<const Double_t*>(fFrequency.data()));
     backward->Transform();
+    backward->GetPoints(fTime.data());
 
-    for (int i = 0; i < fNfft; i++) {
-        backward->GetPointComplex(i, fTimeReal.GetArray()[i], fTimeImg.GetArray()[i]);
-        fTimeReal.GetArray()[i] /= fNfft;
-        fTimeImg.GetArray()[i] /= fNfft;
-    }
+    const Double_t norm = 1. / fNfft;
+    for (int i = 0; i < fNfft; i++) fTime[i] *= norm;
+}
+
+///////////////////////////////////////////////
+/// It transforms all the signals of an event. The vector is resized to the
+/// number of signals, and the elements are reused between calls, so that
+/// neither plans nor arrays are created for each signal.
+///
+void TRestRawFFT::ForwardEventFFT(TRestRawSignalEvent* event, vector<TRestRawFFT>& fft, Int_t fNStart,
+                                  Int_t fNEnd) {
+    fft.resize(event->GetNumberOfSignals());
+    for (int n = 0; n < event->GetNumberOfSignals(); n++)
+        fft[n].ForwardSignalFFT(event->GetSignal(n), fNStart, fNEnd);
+}
 
-    delete backward;
+///////////////////////////////////////////////
+/// It transforms back all the spectra given.
+///
+void TRestRawFFT::BackwardEventFFT(vector<TRestRawFFT>& fft) {
+    for (auto& f : fft) f.BackwardFFT();
 }
 
 void TRestRawFFT::ProduceDelta(Int_t t_o, Int_t Nfft) {
     SetNfft(Nfft);
 
-    for (int i = 0; i < fNfft; i++) {
-        fTimeReal[i] = 0;
-        fTimeImg[i] = 0;
-
-        if (i == t_o) fTimeReal[i] = 1;
-    }
-
-    TVirtualFFT* forward = TVirtualFFT::FFT(1, &fNfft, "R2C");
-    forward->SetPointsComplex(fTimeReal.GetArray(), fTimeImg.GetArray());
-    forward->Transform();
-
-    for (int i = 0; i < fNfft; i++)
-        forward->GetPointComplex(i, fFrequencyReal.GetArray()[i], fFrequencyImg.GetArray()[i]);
+    for (int i = 0; i < fNfft; i++) fTime[i] = 0;
+    if (t_o >= 0 && t_o < fNfft) fTime[t_o] = 1;
 
-    delete forward;
+    Forward();
 }
 
 void TRestRawFFT::GetSignal(TRestRawSignal* sgnl) {
-    sgnl->Reset();
-    for (int i = 0; i < fNfft; i++) sgnl->AddPoint(fTimeReal.GetArray()[i]);
+    sgnl->Initialize();
+    for (int i = 0; i < fNfft; i++) sgnl->AddPoint(fTime[i]);
 }
 
 void TRestRawFFT::MultiplyBy(TRestRawFFT* fftInput, Int_t from, Int_t to) {
@@ -114,15 +183,14 @@ void TRestRawFFT::MultiplyBy(TRestRawFFT* fftInput, Int_t from, Int_t to) {
 
     if (to == 0) to = GetNfft() / 2;
 
-    for (int i = from; i < GetNfft() / 2; i++) {
-        TComplex top(this->GetFrequencyAmplitudeReal(i), this->GetFrequencyAmplitudeImg(i));
-        TComplex bottom(fftInput->GetFrequencyAmplitudeReal(i), fftInput->GetFrequencyAmplitudeImg(i));
-        TComplex product = top * bottom;
-        fFrequencyReal.GetArray()[i] = product.Re();
-        fFrequencyImg.GetArray()[i] = product.Im();
-        fFrequencyReal.GetArray()[fNfft - i - 1] = fFrequencyReal.GetArray()[i];
-        fFrequencyImg.GetArray()[fNfft - i - 1] = fFrequencyImg.GetArray()[i];
+    complex<Double_t>* top = fFrequency.data();
+    const complex<Double_t>* bottom = fftInput->GetFrequency();
+    for (int i = from; i < to; i++) {
+        const Double_t re = top[i].real() * bottom[i].real() - top[i].imag() * bottom[i].imag();
+        const Double_t im = top[i].real() * bottom[i].imag() + top[i].imag() * bottom[i].real();
+        top[i] = complex<Double_t>(re, im);
     }
+    for (int i = from; i < to; i++) top[fNfft - i - 1] = top[i];
 }
 
 void TRestRawFFT::DivideBy(TRestRawFFT* fftInput, Int_t from, Int_t to) {
@@ -133,15 +201,16 @@ void TRestRawFFT::DivideBy(TRestRawFFT* fftInput, Int_t from, Int_t to) {
 
     if (to == 0) to = GetNfft() / 2;
 
+    // Same arithmetic than TComplex division
+    complex<Double_t>* top = fFrequency.data();
+    const complex<Double_t>* bottom = fftInput->GetFrequency();
     for (int i = from; i < to; i++) {
-        TComplex top(this->GetFrequencyAmplitudeReal(i), this->GetFrequencyAmplitudeImg(i));
-        TComplex bottom(fftInput->GetFrequencyAmplitudeReal(i), fftInput->GetFrequencyAmplitudeImg(i));
-        TComplex cocient = top / bottom;
-        fFrequencyReal.GetArray()[i] = cocient.Re();
-        fFrequencyImg.GetArray()[i] = cocient.Im();
-        fFrequencyReal.GetArray()[fNfft - i - 1] = fFrequencyReal.GetArray()[i];
-        fFrequencyImg.GetArray()[fNfft - i - 1] = fFrequencyImg.GetArray()[i];
+        const Double_t norm = bottom[i].real() * bottom[i].real() + bottom[i].imag() * bottom[i].imag();
+        const Double_t re = (top[i].real() * bottom[i].real() + top[i].imag() * bottom[i].imag()) / norm;
+        const Double_t im = (-top[i].real() * bottom[i].imag() + top[i].imag() * bottom[i].real()) / norm;
+        top[i] = complex<Double_t>(re, im);
     }
+    for (int i = from; i < to; i++) top[fNfft - i - 1] = top[i];
 }
 
 void TRestRawFFT::ApplyResponse(TRestRawFFT* fftInput, Int_t cutOff) {
@@ -151,45 +220,33 @@ void TRestRawFFT::ApplyResponse(TRestRawFFT* fftInput, Int_t cutOff) {
     Double_t normCutOff = GetFrequencyNorm2(cutOff - 1);
     Double_t scaleFactor = normCutOff / GetFrequencyNorm2(cutOff);
     scaleFactor = TMath::Sqrt(scaleFactor);
-    for (int i = cutOff; i < GetNfft() / 2; i++) {
-        fFrequencyReal.GetArray()[i] *= scaleFactor;
-        fFrequencyImg.GetArray()[i] *= scaleFactor;
-        fFrequencyReal.GetArray()[fNfft - i - 1] = fFrequencyReal.GetArray()[i];
-        fFrequencyImg.GetArray()[fNfft - i - 1] = fFrequencyImg.GetArray()[i];
-    }
+    for (int i = cutOff; i < GetNfft() / 2; i++) fFrequency[i] *= scaleFactor;
+    for (int i = cutOff; i < GetNfft() / 2; i++) fFrequency[fNfft - i - 1] = fFrequency[i];
 }
 
 void TRestRawFFT::KillFrequencies(Int_t cutOff) {
-    for (int i = cutOff; i < GetNfft() / 2; i++) {
-        fFrequencyReal.GetArray()[i] = 0;
-        fFrequencyImg.GetArray()[i] = 0;
-        fFrequencyReal.GetArray()[fNfft - i - 1] = fFrequencyReal.GetArray()[i];
-        fFrequencyImg.GetArray()[fNfft - i - 1] = fFrequencyImg.GetArray()[i];
+    for (int i = max(cutOff, 0); i < GetNfft() / 2; i++) {
+        fFrequency[i] = 0;
+        fFrequency[fNfft - i - 1] = 0;
     }
 }
 
 void TRestRawFFT::ButterWorthFilter(Int_t cutOff, Int_t order)  //, Double_t amp, Double_t decay )
 {
     double cOffDouble = (double)cutOff;
-    for (int i = 0; i < fNfft / 2; i++) {
+    for (int i = max(cutOff + 1, 0); i < fNfft / 2; i++) {
         double iDouble = (double)i;
-        if (i > cutOff) {
-            fFrequencyReal.GetArray()[i] /= sqrt(1 + pow(iDouble / cOffDouble, 2 * order));
-            fFrequencyImg.GetArray()[i] /= sqrt(1 + pow(iDouble / cOffDouble, 2 * order));
-
-            fFrequencyReal.GetArray()[fNfft - i - 1] = fFrequencyReal.GetArray()[i];
-            fFrequencyImg.GetArray()[fNfft - i - 1] = fFrequencyImg.GetArray()[i];
-        }
+        fFrequency[i] /= sqrt(1 + pow(iDouble / cOffDouble, 2 * order));
     }
+    for (int i = max(cutOff + 1, 0); i < fNfft / 2; i++) fFrequency[fNfft - i - 1] = fFrequency[i];
 }
 
 void TRestRawFFT::ApplyLowPassFilter(Int_t cutFrequency) {
-    for (int i = 0; i < fNfft; i++) {
-        if (i >= cutFrequency && i < fNfft - cutFrequency) {
-            fFrequencyReal.GetArray()[i] = 0.;
-            fFrequencyImg.GetArray()[i] = 0.;
-        }
+    if (cutFrequency < 0) {
+        cout << "TRestRawFFT::ApplyLowPassFilter. cutFrequency < 0!!! The filter is not applied" << endl;
+        return;
     }
+    for (int i = cutFrequency; i < min(fNfft - cutFrequency, fNfft); i++) fFrequency[i] = 0.;
 }
 
 void TRestRawFFT::GaussianSecondOrderResponse(Double_t f1, Double_t f2, Double_t Ao, Double_t sigma) {
@@ -197,22 +254,18 @@ void TRestRawFFT::GaussianSecondOrderResponse(Double_t f1, Double_t f2, Double_t
     for (int i = 0; i < fNfft / 2; i++) {
         Double_t w = (double)2. * i / 3;
 
-        TComplex* cmplx1 = new TComplex((f1 * f2 - w * w), f1 * w);
+        TComplex cmplx1((f1 * f2 - w * w), f1 * w);
 
-        TComplex* cmplx2 = new TComplex(f1, 0);
+        TComplex cmplx2(f1, 0);
 
-        *cmplx2 /= *cmplx1;
+        cmplx2 /= cmplx1;
 
-        *cmplx2 *= a * TMath::Exp(-sigma * w * w);
+        cmplx2 *= a * TMath::Exp(-sigma * w * w);
 
-        fFrequencyReal.GetArray()[i] = cmplx2->Re();
-        fFrequencyImg.GetArray()[i] = cmplx2->Im();
+        fFrequency[i] = complex<Double_t>(cmplx2.Re(), cmplx2.Im());
     }
 
-    for (int i = fNfft / 2; i < fNfft; i++) {
-        fFrequencyReal.GetArray()[i] = fFrequencyReal.GetArray()[fNfft - i - 1];
-        fFrequencyImg.GetArray()[i] = fFrequencyImg.GetArray()[fNfft - i - 1];
-    }
+    for (int i = fNfft / 2; i < fNfft; i++) fFrequency[i] = fFrequency[fNfft - i - 1];
 
     // WriteFrequencyToTextFile( "frequencyResponse" );
 
@@ -225,23 +278,19 @@ void TRestRawFFT::SetSecondOrderAnalyticalResponse(Double_t f1, Double_t f2, Dou
     for (int i = 0; i < fNfft / 2; i++) {
         Double_t w = 2.59 * (double)i;
 
-        TComplex* cmplx1 = new TComplex(f1 * w, (f1 * f2 - w * w));
+        TComplex cmplx1(f1 * w, (f1 * f2 - w * w));
 
-        TComplex* cmplx2 = new TComplex(f1, 0);
+        TComplex cmplx2(f1, 0);
 
-        *cmplx2 /= *cmplx1;
+        cmplx2 /= cmplx1;
 
         TComplex phase(TComplex::Exp(TComplex(0, -w * to)));
 
-        *cmplx2 *= phase;
+        cmplx2 *= phase;
 
-        fFrequencyReal.GetArray()[i] = cmplx2->Re();
-        fFrequencyImg.GetArray()[i] = cmplx2->Im();
-    }
-    for (int i = fNfft / 2; i < fNfft; i++) {
-        fFrequencyReal.GetArray()[i] = fFrequencyReal.GetArray()[fNfft - i - 1];
-        fFrequencyImg.GetArray()[i] = fFrequencyImg.GetArray()[fNfft - i - 1];
+        fFrequency[i] = complex<Double_t>(cmplx2.Re(), cmplx2.Im());
     }
+    for (int i = fNfft / 2; i < fNfft; i++) fFrequency[i] = fFrequency[fNfft - i - 1];
 
     WriteFrequencyToTextFile("/home/javier/tmp/frequencyResponse");
 
@@ -258,23 +307,19 @@ void TRestRawFFT::RemoveBaseline() {
 }
 
 void TRestRawFFT::RenormalizeNode(Int_t n, Double_t factor) {
-    fFrequencyReal.GetArray()[fNfft - n - 1] = fFrequencyReal.GetArray()[n] / factor;
-    fFrequencyImg.GetArray()[fNfft - n - 1] = fFrequencyImg.GetArray()[n] / factor;
-
-    fFrequencyReal.GetArray()[n] = fFrequencyReal.GetArray()[n] / factor;
-    fFrequencyImg.GetArray()[n] = fFrequencyImg.GetArray()[n] / factor;
+    fFrequency[fNfft - n - 1] = fFrequency[n] / factor;
+    fFrequency[n] = fFrequency[n] / factor;
 }
 
 void TRestRawFFT::WriteFrequencyToTextFile(TString filename) {
     FILE* fff = fopen(filename.Data(), "w");
     for (int i = 0; i < fNfft; i++)
-        fprintf(fff, "%d\t%17.14e\t%17.14e\n", i, fFrequencyReal.GetArray()[i], fFrequencyImg.GetArray()[i]);
+        fprintf(fff, "%d\t%17.14e\t%17.14e\n", i, fFrequency[i].real(), fFrequency[i].imag());
     fclose(fff);
 }
 
 void TRestRawFFT::WriteTimeSignalToTextFile(TString filename) {
     FILE* fff = fopen(filename.Data(), "w");
-    for (int i = 0; i < fNfft; i++)
-        fprintf(fff, "%d\t%e\t%e\n", i, fTimeReal.GetArray()[i], fTimeImg.GetArray()[i]);
+    for (int i = 0; i < fNfft; i++) fprintf(fff, "%d\t%e\t%e\n", i, fTime[i], 0.);
     fclose(fff);
 }
@@ -71,6 +71,17 @@
 ///               in the main loop to avoid continues request of shared
 ///               resources, and therefore collision with the daq access.
 ///
+/// The macro `REST_Raw_MemoryBufferEmulator.C` emulates the daq side of this
+/// protocol. It creates the shared resources using the same keys, it pushes
+/// synthetic events at a given rate, number of channels and maxSamples, and it
+/// reports the latency percentiles and the number of events dropped while the
+/// buffer was still owned by this process. It allows to test and tune this
+/// process without a real daq.
+///
+/// \code
+/// restRoot -b -q 'REST_Raw_MemoryBufferEmulator.C(1000, 50, 256, 512)'
+/// \endcode
+///
 /// \todo We could have two semaphores, one to access the buffer and one to
 /// access the daqInfo structure.
 ///
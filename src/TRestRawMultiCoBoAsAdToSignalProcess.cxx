@@ -132,6 +132,8 @@ void TRestRawMultiCoBoAsAdToSignalProcess::InitProcess() {
     fRunOrigin = fRunInfo->GetRunNumber();
     fCurrentEvent = -1;
 
+    InitChannelFilter();
+
     if (fRunInfo->GetStartTimestamp() != 0) {
         fStartTimeStamp = TTimeStamp(fRunInfo->GetStartTimestamp());
     }
@@ -149,6 +151,8 @@ Bool_t TRestRawMultiCoBoAsAdToSignalProcess::AddInputFile(const string& file) {
         fileerrors.push_back(0);
 
         int i = fHeaderFrame.size() - 1;
+        // Files opened on demand get their first header read by FillBuffer
+        if (fInputFiles[i] == nullptr) return true;
         if (fread(fHeaderFrame[i].frameHeader, 256, 1, fInputFiles[i]) != 1 || feof(fInputFiles[i])) {
             fclose(fInputFiles[i]);
             fInputFiles[i] = nullptr;
@@ -177,12 +181,17 @@ Bool_t TRestRawMultiCoBoAsAdToSignalProcess::AddInputFile(const string& file) {
 TRestEvent* TRestRawMultiCoBoAsAdToSignalProcess::ProcessEvent(TRestEvent* inputEvent) {
     fSignalEvent->Initialize();
 
-    if (EndReading()) {
-        return nullptr;
-    }
-    if (!FillBuffer()) {
-        fSignalEvent->SetOK(false);
-        return fSignalEvent;
+    // Events rejected by the event selection are jumped over inside FillBuffer
+    while (true) {
+        if (EndReading()) {
+            return nullptr;
+        }
+        if (!FillBuffer()) {
+            fSignalEvent->SetOK(false);
+            return fSignalEvent;
+        }
+        if (!fSkipEvent) break;
+        if (IsSelectionFinished(fCurrentEvent)) return nullptr;
     }
 
     // Int_t nextId = GetLowestEventId();
@@ -253,9 +262,14 @@ void TRestRawMultiCoBoAsAdToSignalProcess::EndProcess() {
 // true: finish filling
 // false: error when filling
 bool TRestRawMultiCoBoAsAdToSignalProcess::FillBuffer() {
-    // if the file is opened but not read, read header frame
+    // if the file is opened but not read, read header frame. All the files are read in parallel, so the
+    // files that are not kept open are opened here, before the first event is decoded
     for (unsigned int i = 0; i < fInputFiles.size(); i++) {
-        if (fInputFiles[i] && ftell(fInputFiles[i]) == 0) {
+        if (GetInputFile(i) == nullptr) {
+            fHeaderFrame[i].eventIdx = (unsigned int)4294967295;
+            continue;
+        }
+        if (ftell(fInputFiles[i]) == 0) {
             if (fread(fHeaderFrame[i].frameHeader, 256, 1, fInputFiles[i]) != 1 || feof(fInputFiles[i])) {
                 fclose(fInputFiles[i]);
                 fInputFiles[i] = nullptr;
@@ -281,11 +295,20 @@ bool TRestRawMultiCoBoAsAdToSignalProcess::FillBuffer() {
     // normally:
     // 1.use the smallest event id in header frames as current event id
     unsigned int evt = fHeaderFrame[0].eventIdx;
+    Long64_t evtTime = fHeaderFrame[0].eventTime;
     for (unsigned int i = 1; i < fHeaderFrame.size(); i++) {
-        if (fHeaderFrame[i].eventIdx < evt) evt = fHeaderFrame[i].eventIdx;
+        if (fHeaderFrame[i].eventIdx < evt) {
+            evt = fHeaderFrame[i].eventIdx;
+            evtTime = fHeaderFrame[i].eventTime;
+        }
     }
     fCurrentEvent = evt;
 
+    // 2.decide from the header if the data frames of this event must be decoded
+    fSkipEvent = SkipByPrescale();
+    if (!fSkipEvent && IsEventOutOfSelection(fCurrentEvent, fStartTimeStamp.AsDouble() + evtTime * 1.e-9))
+        fSkipEvent = true;
+
     // loop for each file
     for (unsigned int i = 0; i < fHeaderFrame.size(); i++) {
         if (fInputFiles[i] == nullptr) {
@@ -308,7 +331,15 @@ bool TRestRawMultiCoBoAsAdToSignalProcess::FillBuffer() {
 
             // reading data according to the header
             unsigned int type = fHeaderFrame[i].frameType;
-            if (fHeaderFrame[i].frameHeader[0] == 0x08 && type == 1)  // partial readout
+            if (fSkipEvent)  // the frame size is used to jump over the data
+            {
+                if (!SkipInputBytes(fInputFiles[i], (Long64_t)fHeaderFrame[i].frameSize - 256)) {
+                    fclose(fInputFiles[i]);
+                    fInputFiles[i] = nullptr;
+                    fHeaderFrame[i].eventIdx = (unsigned int)4294967295;
+                    break;
+                }
+            } else if (fHeaderFrame[i].frameHeader[0] == 0x08 && type == 1)  // partial readout
             {
                 ReadFrameDataP(fInputFiles[i], fHeaderFrame[i]);
             } else if (fHeaderFrame[i].frameHeader[0] == 0x08 && type == 2)  // full readout
@@ -528,6 +559,8 @@ bool TRestRawMultiCoBoAsAdToSignalProcess::ReadFrameDataP(FILE* f, CoBoHeaderFra
                 continue;
             }
 
+            if (IsChannelSkipped(chTmp + asadid * 272)) continue;
+
             dataf.chHit[chTmp] = kTRUE;
             dataf.data[chTmp][buckIdx] = sample;
         }
@@ -590,6 +623,7 @@ bool TRestRawMultiCoBoAsAdToSignalProcess::ReadFrameDataF(CoBoHeaderFrame& hdr)
                 continue;
             }
             chTmp = agetIdx * 68 + chanIdx;
+            if (IsChannelSkipped(chTmp + asadid * 272)) continue;
             dataf.chHit[chTmp] = kTRUE;
             dataf.data[chTmp][i] = sample;
         }
@@ -607,6 +641,11 @@ bool TRestRawMultiCoBoAsAdToSignalProcess::ReadFrameDataF(CoBoHeaderFrame& hdr)
 }
 
 Bool_t TRestRawMultiCoBoAsAdToSignalProcess::EndReading() {
+    // Files opened on demand have no header frame until FillBuffer opens them
+    for (int n = 0; n < nFiles; n++) {
+        if (!fInputFileOpened[n]) return false;
+    }
+
     for (auto& m : fDataFrame) {
         m.second.finished = true;
     }
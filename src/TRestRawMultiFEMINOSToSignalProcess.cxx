@@ -220,7 +220,11 @@ void TRestRawMultiFEMINOSToSignalProcess::InitProcess() {
     // Reading binary file header
     TRestRawToSignalProcess::InitProcess();
 
-    if (!fInputFileNames.empty() && TRestTools::GetFileNameExtension(fInputFileNames[0]) != "aqs") {
+    // A compressed file, i.e. file.aqs.gz, is checked against its uncompressed extension
+    string inputFileName = fInputFileNames.empty() ? "" : fInputFileNames[0];
+    if (IsCompressedFile(inputFileName)) inputFileName = inputFileName.substr(0, inputFileName.rfind('.'));
+
+    if (!fInputFileNames.empty() && TRestTools::GetFileNameExtension(inputFileName) != "aqs") {
         RESTError << "The input file extension should be .aqs" << RESTendl;
         RESTError << "Filename : " << fInputFileNames[0] << RESTendl;
         exit(1);
@@ -290,6 +294,8 @@ TRestEvent* TRestRawMultiFEMINOSToSignalProcess::ProcessEvent(TRestEvent* inputE
 
         nChannels = 0;
         Bool_t endOfEvent = false;
+        Bool_t payloadSkipped = false;
+        fSkipEvent = false;
 
         fSignalEvent->Initialize();
 
@@ -334,6 +340,15 @@ TRestEvent* TRestRawMultiFEMINOSToSignalProcess::ProcessEvent(TRestEvent* inputE
                     nb_sh -= 3;         // we have already read three short words from this event
                     fr_offset = 8;
 
+                    // A built event rejected by the prescale is jumped over using its size
+                    if (SkipByPrescale()) {
+                        if (!SkipInputBytes(fInputBinFile, sizeof(unsigned short) * nb_sh)) return nullptr;
+                        // The header of the next event possibly stored at the end of this one is lost
+                        fLastEventId = 0;
+                        fSkipEvent = true;
+                        payloadSkipped = true;
+                    }
+
                     done = 1;
                 } else if (((*sh & PFX_9_BIT_CONTENT_MASK) == PFX_START_OF_DFRAME) ||
                            ((*sh & PFX_9_BIT_CONTENT_MASK) == PFX_START_OF_CFRAME) ||
@@ -361,7 +376,7 @@ TRestEvent* TRestRawMultiFEMINOSToSignalProcess::ProcessEvent(TRestEvent* inputE
             }
 
             // Read binary frame
-            if (!endOfEvent) {
+            if (!endOfEvent && !payloadSkipped) {
                 if (fread(&(cur_fr[fr_offset]), sizeof(unsigned short), nb_sh, fInputBinFile) != nb_sh) {
                     printf("Error: could not read %d bytes.\n", (nb_sh * 2));
                     return nullptr;  // exit(1);
@@ -375,12 +390,19 @@ TRestEvent* TRestRawMultiFEMINOSToSignalProcess::ProcessEvent(TRestEvent* inputE
 
                 endOfEvent = ReadFrame((void*)&(cur_fr[2]), fr_sz);
             }
+            payloadSkipped = false;
         }
 
         if (fSignalEvent->GetID() == 0 && fLastEventId != 0) {
             fSignalEvent->SetID(fLastEventId);
             fSignalEvent->SetTime(fLastTimeStamp);
             fLastEventId = 0;
+            ApplyEventSelection();
+        }
+
+        if (fSkipEvent) {
+            if (fSignalEvent->GetID() != 0 && IsSelectionFinished(fSignalEvent->GetID())) return nullptr;
+            continue;
         }
 
         if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Info) {
@@ -408,6 +430,17 @@ TRestEvent* TRestRawMultiFEMINOSToSignalProcess::ProcessEvent(TRestEvent* inputE
     return nullptr;
 }
 
+///////////////////////////////////////////////
+/// \brief It marks the current event to be skipped if it is rejected by the
+/// prescale or it is out of the event selection. It must be called once the
+/// event id and time have been assigned.
+///
+void TRestRawMultiFEMINOSToSignalProcess::ApplyEventSelection() {
+    // In TCM mode the prescale is applied to the built events
+    if (fElectronicsType == "SingleFeminos" && SkipByPrescale()) fSkipEvent = true;
+    if (IsEventOutOfSelection(fSignalEvent->GetID(), fSignalEvent->GetTime())) fSkipEvent = true;
+}
+
 Bool_t TRestRawMultiFEMINOSToSignalProcess::ReadFrame(void* fr, int fr_sz) {
     Bool_t endOfEvent = false;
 
@@ -456,6 +489,14 @@ Bool_t TRestRawMultiFEMINOSToSignalProcess::ReadFrame(void* fr, int fr_sz) {
             sgnl.Initialize();
             sgnl.SetSignalID(daqChannel);
 
+            // The samples of a skipped channel or event are jumped over without decoding them
+            if (fSkipEvent || IsChannelSkipped(daqChannel)) {
+                sgnl.SetSignalID(-1);
+                while ((*p & PFX_12_BIT_CONTENT_MASK) == PFX_ADC_SAMPLE ||
+                       (*p & PFX_9_BIT_CONTENT_MASK) == PFX_TIME_BIN_IX)
+                    p++;
+            }
+
         }
         // Is it a prefix for 12-bit content?
         else if ((*p & PFX_12_BIT_CONTENT_MASK) == PFX_ADC_SAMPLE) {
@@ -520,6 +561,8 @@ Bool_t TRestRawMultiFEMINOSToSignalProcess::ReadFrame(void* fr, int fr_sz) {
                     fSignalEvent->SetID(fLastEventId);
                     fSignalEvent->SetTime(fLastTimeStamp);
                 }
+
+                ApplyEventSelection();
             }
 
             fLastEventId = tmp;
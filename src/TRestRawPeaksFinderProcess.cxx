@@ -1,13 +1,43 @@
 
 #include "TRestRawPeaksFinderProcess.h"
 
+#include <algorithm>
 #include <utility>
 
 ClassImp(TRestRawPeaksFinderProcess);
 
 using namespace std;
 
-void TRestRawPeaksFinderProcess::InitProcess() {}
+void TRestRawPeaksFinderProcess::InitProcess() {
+    if (fFinderThreads < 1) fFinderThreads = 1;
+
+    delete fWorkers;
+    fWorkers = new TRestRawWorkerPool(fFinderThreads);
+    fThreadPeaks.resize(fFinderThreads);
+}
+
+void TRestRawPeaksFinderProcess::EndProcess() {
+    delete fWorkers;
+    fWorkers = nullptr;
+}
+
+/// It fills fChannelMask, indexed by channel daq id, with the type bits of each readout channel
+void TRestRawPeaksFinderProcess::BuildChannelMask() {
+    fChannelMask.clear();
+    if (fReadoutMetadata == nullptr) {
+        return;
+    }
+
+    for (const auto& [daqId, info] : fReadoutMetadata->fChannelInfo) {
+        UChar_t mask = 0;
+        if (fChannelTypes.find(info.type) != fChannelTypes.end()) mask |= kSelectedChannel;
+        if (info.type == "tpc") mask |= kTPCChannel;
+        if (info.type == "veto") mask |= kVetoChannel;
+
+        if (daqId >= fChannelMask.size()) fChannelMask.resize(daqId + 1, 0);
+        fChannelMask[daqId] = mask;
+    }
+}
 
 TRestEvent* TRestRawPeaksFinderProcess::ProcessEvent(TRestEvent* inputEvent) {
     fInputEvent = dynamic_cast<TRestRawSignalEvent*>(inputEvent);
@@ -19,6 +49,7 @@ TRestEvent* TRestRawPeaksFinderProcess::ProcessEvent(TRestEvent* inputEvent) {
 
     if (fReadoutMetadata == nullptr) {
         fReadoutMetadata = fInputEvent->GetReadoutMetadata();
+        BuildChannelMask();
     }
 
     if (fReadoutMetadata == nullptr && !fChannelTypes.empty()) {
@@ -28,120 +59,119 @@ TRestEvent* TRestRawPeaksFinderProcess::ProcessEvent(TRestEvent* inputEvent) {
         exit(1);
     }
 
-    vector<tuple<UShort_t, UShort_t, double, double>>
-        eventPeaks;  // signalId, time, amplitude, amplitudeBaseLineCorrected
+    // The threads are deleted at EndProcess, and they are not created if InitProcess was not called
+    if (fWorkers == nullptr) InitProcess();
+
+    const Int_t nSignals = fInputEvent->GetNumberOfSignals();
+    fSignalMask.assign(nSignals, 0);
+    for (int signalIndex = 0; signalIndex < nSignals; signalIndex++) {
+        const UShort_t signalId = fInputEvent->GetSignal(signalIndex)->GetSignalID();
+        if (signalId < fChannelMask.size()) fSignalMask[signalIndex] = fChannelMask[signalId];
+    }
+    fSignalPeaksCount.assign(nSignals, 0);
+    const UChar_t selectedTPC = kSelectedChannel | kTPCChannel;
+    for (auto& peaks : fThreadPeaks) peaks.clear();
+
+    // Calculate the baselines. Veto peaks do not depend on the other signals, and they are found here
+    fWorkers->ForEach(nSignals, [this](Int_t signalIndex, Int_t thread) {
+        const UChar_t mask = fSignalMask[signalIndex];
+        if (!(mask & kSelectedChannel)) {
+            return;
+        }
+
+        const auto signal = fInputEvent->GetSignal(signalIndex);
+        if (mask & kTPCChannel) {
+            signal->CalculateBaseLine(fBaselineRange.X(), fBaselineRange.Y());
+        } else if (mask & kVetoChannel) {
+            // For veto signals the baseline is calculated over the whole range, as we don´t know where the
+            // signal will be.
+            signal->CalculateBaseLine(0, 511, "OUTLIERS");
+            double signalBaseLine = signal->GetBaseLine();
+            // For veto signals the threshold is selected by the user.
+            const auto peaks =
+                signal->GetPeaksVeto(signalBaseLine + fThresholdOverBaseline, fDistance, signalBaseLine);
+
+            const UShort_t signalId = signal->GetSignalID();
+            for (const auto& [time, amplitude, amplitudeBaseLineCorrected] : peaks) {
+                fThreadPeaks[thread].emplace_back(signalId, time, amplitude, amplitudeBaseLineCorrected);
+            }
+            fSignalPeaksCount[signalIndex] = peaks.size();
+        }
+    });
 
     // Calculate average baseline and sigma of all the TPC signals
     double BaseLineMean = 0.0;
     double BaseLineSigmaMean = 0.0;
     unsigned int countTPC = 0;
 
-    for (int signalIndex = 0; signalIndex < fInputEvent->GetNumberOfSignals(); signalIndex++) {
-        const auto signal = fInputEvent->GetSignal(signalIndex);
-        const UShort_t signalId = signal->GetSignalID();
-
-        const string channelType = fReadoutMetadata->GetTypeForChannelDaqId(signalId);
-        const string channelName = fReadoutMetadata->GetNameForChannelDaqId(signalId);
-
-        // Check if channel type is in the list of selected channel types
-        if (fChannelTypes.find(channelType) == fChannelTypes.end()) {
+    for (int signalIndex = 0; signalIndex < nSignals; signalIndex++) {
+        if ((fSignalMask[signalIndex] & selectedTPC) != selectedTPC) {
             continue;
         }
-
-        // Choose appropriate function based on channel type
-        if (channelType == "tpc") {
-            signal->CalculateBaseLine(fBaselineRange.X(), fBaselineRange.Y());
-            // Accumulate the baseline and sigma values
-            BaseLineMean += signal->GetBaseLine();
-            BaseLineSigmaMean += signal->GetBaseLineSigma();
-            countTPC++;  // Count the signals considered
-        }
+        const auto signal = fInputEvent->GetSignal(signalIndex);
+        // Accumulate the baseline and sigma values
+        BaseLineMean += signal->GetBaseLine();
+        BaseLineSigmaMean += signal->GetBaseLineSigma();
+        countTPC++;  // Count the signals considered
     }
 
     // Calculate the average if there were any matching signals
     if (countTPC > 0) {
         BaseLineMean /= countTPC;
         BaseLineSigmaMean /= countTPC;
-    }
-
-    for (int signalIndex = 0; signalIndex < fInputEvent->GetNumberOfSignals(); signalIndex++) {
-        const auto signal = fInputEvent->GetSignal(signalIndex);
-        const UShort_t signalId = signal->GetSignalID();
 
-        const string channelType = fReadoutMetadata->GetTypeForChannelDaqId(signalId);
-        const string channelName = fReadoutMetadata->GetNameForChannelDaqId(signalId);
-
-        // check if channel type is in the list of selected channel types
-        if (fChannelTypes.find(channelType) == fChannelTypes.end()) {
-            continue;
-        }
-
-        // Choose appropriate function based on channel type
-        if (channelType == "tpc") {
-            signal->CalculateBaseLine(fBaselineRange.X(), fBaselineRange.Y());
-            double signalBaseLine = signal->GetBaseLine();
-
-            // I think count will never be 0, just in case
-            if (countTPC <= 0) {
-                cerr << "TRestRawPeaksFinderProcess::ProcessEvent: TPC count is 0 in TPC loop, this should "
-                        "not happen"
-                     << endl;
-                exit(1);
+        const double threshold = BaseLineMean + fSigmaOverBaseline * BaseLineSigmaMean;
+        fWorkers->ForEach(nSignals, [this, threshold, selectedTPC](Int_t signalIndex, Int_t thread) {
+            const UChar_t mask = fSignalMask[signalIndex];
+            if ((mask & selectedTPC) != selectedTPC) {
+                return;
             }
 
-            const double threshold = BaseLineMean + fSigmaOverBaseline * BaseLineSigmaMean;
-            const auto peaks = signal->GetPeaks(threshold, fDistance, signalBaseLine);
-
-            for (const auto& [time, amplitude, amplitudeBaseLineCorrected] : peaks) {
-                eventPeaks.emplace_back(signalId, time, amplitude, amplitudeBaseLineCorrected);
-            }
-        } else if (channelType == "veto") {
-            // For veto signals the baseline is calculated over the whole range, as we don´t know where the
-            // signal will be.
-            signal->CalculateBaseLine(0, 511, "OUTLIERS");
-            double signalBaseLine = signal->GetBaseLine();
-            // For veto signals the threshold is selected by the user.
-            const auto peaks =
-                signal->GetPeaksVeto(signalBaseLine + fThresholdOverBaseline, fDistance, signalBaseLine);
+            const auto signal = fInputEvent->GetSignal(signalIndex);
+            const auto peaks = signal->GetPeaks(threshold, fDistance, signal->GetBaseLine());
 
+            const UShort_t signalId = signal->GetSignalID();
             for (const auto& [time, amplitude, amplitudeBaseLineCorrected] : peaks) {
-                eventPeaks.emplace_back(signalId, time, amplitude, amplitudeBaseLineCorrected);
+                fThreadPeaks[thread].emplace_back(signalId, time, amplitude, amplitudeBaseLineCorrected);
             }
-        }
+            fSignalPeaksCount[signalIndex] = peaks.size();
+        });
     }
 
-    // sort eventPeaks by time, then signal id
-    sort(eventPeaks.begin(), eventPeaks.end(),
-         [](const tuple<UShort_t, UShort_t, double, double>& a,
-            const tuple<UShort_t, UShort_t, double, double>& b) {
-             return tie(get<1>(a), get<0>(a)) < tie(get<1>(b), get<0>(b));
-         });
+    // sort eventPeaks by time, then signal id. Each thread buffer is sorted and then merged
+    const auto peakOrder = [](const PeakTuple& a, const PeakTuple& b) {
+        return tie(get<1>(a), get<0>(a)) < tie(get<1>(b), get<0>(b));
+    };
+    auto& eventPeaks = fEventPeaks;  // signalId, time, amplitude, amplitudeBaseLineCorrected
+    eventPeaks.clear();
+    for (auto& peaks : fThreadPeaks) {
+        sort(peaks.begin(), peaks.end(), peakOrder);
+        const auto middle = eventPeaks.size();
+        eventPeaks.insert(eventPeaks.end(), peaks.begin(), peaks.end());
+        inplace_merge(eventPeaks.begin(), eventPeaks.begin() + middle, eventPeaks.end(), peakOrder);
+    }
 
-    vector<UShort_t> peaksChannelId;
-    vector<UShort_t> peaksTime;
-    vector<double> peaksAmplitude;
-    vector<double> peaksAmplitudeBaseLineCorrected;
+    vector<UShort_t> peaksChannelId(eventPeaks.size());
+    vector<UShort_t> peaksTime(eventPeaks.size());
+    vector<double> peaksAmplitude(eventPeaks.size());
+    vector<double> peaksAmplitudeBaseLineCorrected(eventPeaks.size());
 
     double peaksEnergy = 0.0;
     double peaksEnergyBaseLineCorrected = 0.0;
-    UShort_t peaksCount = 0;
-    UShort_t peaksCountUnique = 0;
+    UShort_t peaksCount = eventPeaks.size();
+    // signal ids are unique in the event, so each signal with peaks is one unique channel
+    UShort_t peaksCountUnique =
+        count_if(fSignalPeaksCount.begin(), fSignalPeaksCount.end(), [](UShort_t n) { return n > 0; });
 
-    set<UShort_t> uniquePeaks;
-    for (const auto& [channelId, time, amplitude, amplitudeBaseLineCorrected] : eventPeaks) {
-        peaksChannelId.push_back(channelId);
-        peaksTime.push_back(time);
-        peaksAmplitude.push_back(amplitude);
-        peaksAmplitudeBaseLineCorrected.push_back(amplitudeBaseLineCorrected);
+    for (size_t peakIndex = 0; peakIndex < eventPeaks.size(); peakIndex++) {
+        const auto& [channelId, time, amplitude, amplitudeBaseLineCorrected] = eventPeaks[peakIndex];
+        peaksChannelId[peakIndex] = channelId;
+        peaksTime[peakIndex] = time;
+        peaksAmplitude[peakIndex] = amplitude;
+        peaksAmplitudeBaseLineCorrected[peakIndex] = amplitudeBaseLineCorrected;
 
         peaksEnergy += amplitude;
         peaksEnergyBaseLineCorrected += amplitudeBaseLineCorrected;
-        peaksCount++;
-
-        if (uniquePeaks.find(channelId) == uniquePeaks.end()) {
-            uniquePeaks.insert(channelId);
-            peaksCountUnique++;
-        }
     }
 
     SetObservableValue("peaksChannelId", peaksChannelId);
@@ -158,69 +188,39 @@ TRestEvent* TRestRawPeaksFinderProcess::ProcessEvent(TRestEvent* inputEvent) {
     vector<UShort_t> windowPeakCenter(eventPeaks.size(), 0);
     vector<UShort_t> windowPeakMultiplicity(eventPeaks.size(), 0);
 
-    UShort_t window_index = 0;
-    for (size_t peakIndex = 0; peakIndex < eventPeaks.size(); peakIndex++) {
-        const auto& [channelId, time, amplitude, amplitudeBaseLineCorrected] = eventPeaks[peakIndex];
-        const auto windowTimeStart = time - fWindow / 2;
-        const auto windowTimeEnd = time + fWindow / 2;
-
-        // check if the peak is already in a window
-        if (windowPeakIndex[peakIndex] != std::numeric_limits<UShort_t>::max()) {
-            continue;
-        }
-
-        UShort_t window_center_time = time;
-
-        set<UShort_t> windowPeaksIndex;
-
-        // add the peak to the window
-        windowPeaksIndex.insert(peakIndex);
-
-        // add the peaks that are in the window
-        for (size_t otherPeakIndex = peakIndex + 1; otherPeakIndex < eventPeaks.size(); otherPeakIndex++) {
-            const auto& [otherChannelId, otherTime, otherAmplitude, otherAmplitudeBaseLineCorrected] =
-                eventPeaks[otherPeakIndex];
-
-            if (otherTime < windowTimeStart) {
-                continue;
-            }
-
-            if (otherTime > windowTimeEnd) {
-                break;
-            }
+    vector<UShort_t> windowCenter;
+    vector<UShort_t> windowMultiplicity;
 
-            windowPeaksIndex.insert(otherPeakIndex);
+    // The peaks are sorted by time, so each window is the run of peaks starting at the first peak not
+    // yet in a window and ending at the last peak within fWindow / 2 of it
+    UShort_t window_index = 0;
+    size_t peakIndex = 0;
+    while (peakIndex < eventPeaks.size()) {
+        const UShort_t window_center_time = get<1>(eventPeaks[peakIndex]);
+        const auto windowTimeEnd = window_center_time + fWindow / 2;
+
+        size_t windowEnd = peakIndex + 1;
+        while (windowEnd < eventPeaks.size() && get<1>(eventPeaks[windowEnd]) <= windowTimeEnd) {
+            windowEnd++;
         }
 
-        for (const auto& index : windowPeaksIndex) {
+        const UShort_t multiplicity = windowEnd - peakIndex;
+        for (size_t index = peakIndex; index < windowEnd; index++) {
             windowPeakIndex[index] = window_index;
             windowPeakCenter[index] = window_center_time;
-            windowPeakMultiplicity[index] = windowPeaksIndex.size();
+            windowPeakMultiplicity[index] = multiplicity;
         }
+        windowCenter.push_back(window_center_time);
+        windowMultiplicity.push_back(multiplicity);
 
         window_index++;
+        peakIndex = windowEnd;
     }
 
     SetObservableValue("windowPeakIndex", windowPeakIndex);
     SetObservableValue("windowPeakTimeBin", windowPeakCenter);
     SetObservableValue("windowPeakMultiplicity", windowPeakMultiplicity);
 
-    vector<UShort_t> windowCenter;
-    vector<UShort_t> windowMultiplicity;
-
-    set<UShort_t> windowPeaksIndexInserted;
-    for (size_t peakIndex = 0; peakIndex < eventPeaks.size(); peakIndex++) {
-        const auto& window_peak_index = windowPeakIndex[peakIndex];
-        if (windowPeaksIndexInserted.find(window_peak_index) != windowPeaksIndexInserted.end()) {
-            continue;
-        }
-
-        windowPeaksIndexInserted.insert(window_peak_index);
-
-        windowCenter.push_back(windowPeakCenter[peakIndex]);
-        windowMultiplicity.push_back(windowPeakMultiplicity[peakIndex]);
-    }
-
     SetObservableValue("windowTimeBin", windowCenter);
     SetObservableValue("windowMultiplicity", windowMultiplicity);
 
@@ -290,40 +290,15 @@ TRestEvent* TRestRawPeaksFinderProcess::ProcessEvent(TRestEvent* inputEvent) {
         SetObservableValue("peaksEnergySum", peaksEnergySum);
     }
 
-    // Remove peak-less veto signals after the peak finding if chosen
-    if (fRemovePeaklessVetoes && !fRemoveAllVetoes) {
-        set<UShort_t> peakSignalIds;
-        for (const auto& [channelId, time, amplitude, amplitudeBaseLineCorrected] : eventPeaks) {
-            peakSignalIds.insert(channelId);
-        }
-
+    // Remove veto signals after the peak finding if chosen: all of them, or only the peak-less ones
+    if (fRemoveAllVetoes || fRemovePeaklessVetoes) {
         vector<UShort_t> signalsToRemove;
-        for (int signalIndex = 0; signalIndex < fInputEvent->GetNumberOfSignals(); signalIndex++) {
-            const auto signal = fInputEvent->GetSignal(signalIndex);
-            const UShort_t signalId = signal->GetSignalID();
-            const string signalType = fReadoutMetadata->GetTypeForChannelDaqId(signalId);
-
-            if (signalType == "veto" && peakSignalIds.find(signalId) == peakSignalIds.end()) {
-                signalsToRemove.push_back(signalId);
+        for (int signalIndex = 0; signalIndex < nSignals; signalIndex++) {
+            if (!(fSignalMask[signalIndex] & kVetoChannel)) {
+                continue;
             }
-        }
-
-        // Now remove all veto signals identified
-        for (const auto& signalId : signalsToRemove) {
-            fInputEvent->RemoveSignalWithId(signalId);
-        }
-    }
-
-    // Remove all veto signals after the peak finding if chosen
-    if (fRemoveAllVetoes) {
-        vector<UShort_t> signalsToRemove;
-        for (int signalIndex = 0; signalIndex < fInputEvent->GetNumberOfSignals(); signalIndex++) {
-            const auto signal = fInputEvent->GetSignal(signalIndex);
-            const UShort_t signalId = signal->GetSignalID();
-            const string signalType = fReadoutMetadata->GetTypeForChannelDaqId(signalId);
-
-            if (signalType == "veto") {
-                signalsToRemove.push_back(signalId);
+            if (fRemoveAllVetoes || fSignalPeaksCount[signalIndex] == 0) {
+                signalsToRemove.push_back(fInputEvent->GetSignal(signalIndex)->GetSignalID());
             }
         }
 
@@ -381,6 +356,7 @@ void TRestRawPeaksFinderProcess::InitFromConfigFile() {
     fWindow = UShort_t(GetDblParameterWithUnits("window", fWindow));
     fRemoveAllVetoes = StringToBool(GetParameter("removeAllVetoes", fRemoveAllVetoes));
     fRemovePeaklessVetoes = StringToBool(GetParameter("removePeaklessVetoes", fRemovePeaklessVetoes));
+    fFinderThreads = StringToInteger(GetParameter("finderThreads", fFinderThreads));
 
     fTimeBinToTimeFactorMultiplier = GetDblParameterWithUnits("sampling", fTimeBinToTimeFactorMultiplier);
     fTimeBinToTimeFactorOffset = GetDblParameterWithUnits("trigDelay", fTimeBinToTimeFactorOffset);
@@ -453,6 +429,7 @@ void TRestRawPeaksFinderProcess::PrintMetadata() {
 
     RESTMetadata << "Distance: " << fDistance << RESTendl;
     RESTMetadata << "Window: " << fWindow << RESTendl;
+    RESTMetadata << "Finder threads: " << fFinderThreads << RESTendl;
 
     EndPrintProcess();
 }
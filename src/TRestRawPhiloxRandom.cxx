@@ -0,0 +1,140 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+/// TRestRawPhiloxRandom is the Philox4x32-10 counter-based random number
+/// generator (J. K. Salmon et al., "Parallel random numbers: as easy as 1, 2,
+/// 3", SC11). Each value is a function of a 64-bit key and a 128-bit counter,
+/// so that there is no state to keep or to share between threads. The same
+/// key and counter always give the same random words, whatever the order in
+/// which they are requested.
+///
+/// FillGaussian fills an array with gaussian values obtained with the
+/// Box-Muller transform. The first counter word is the position in the array
+/// (4 uniform values per counter), and the three other words are given by
+/// the caller to identify the array, e.g. the event and signal ids.
+///
+/// \code
+/// TRestRawPhiloxRandom random(seed, runNumber);
+/// vector<Double_t> noise(512);
+/// random.FillGaussian(noise.data(), noise.size(), eventId, signalId, subEventId, 10.);
+/// \endcode
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: First implementation, for TRestRawSignalAddNoiseProcess.
+///
+/// \class      TRestRawPhiloxRandom
+///
+/// <hr>
+///
+#include "TRestRawPhiloxRandom.h"
+
+#include <cmath>
+
+using namespace std;
+
+ClassImp(TRestRawPhiloxRandom);
+
+namespace {
+/// The Philox4x32 multipliers and key increments (Weyl sequence)
+const ULong64_t kPhiloxM0 = 0xD2511F53;
+const ULong64_t kPhiloxM1 = 0xCD9E8D57;
+const UInt_t kPhiloxW0 = 0x9E3779B9;
+const UInt_t kPhiloxW1 = 0xBB67AE85;
+const Int_t kPhiloxRounds = 10;
+}  // namespace
+
+TRestRawPhiloxRandom::TRestRawPhiloxRandom(UInt_t key0, UInt_t key1) { SetKey(key0, key1); }
+
+TRestRawPhiloxRandom::~TRestRawPhiloxRandom() {}
+
+///////////////////////////////////////////////
+/// \brief It computes the 4 random words of the given counter (4 words) and
+/// key (2 words).
+///
+void TRestRawPhiloxRandom::Generate(const UInt_t* counter, const UInt_t* key, UInt_t* result) {
+    UInt_t x0 = counter[0], x1 = counter[1], x2 = counter[2], x3 = counter[3];
+    UInt_t k0 = key[0], k1 = key[1];
+
+    for (int round = 0; round < kPhiloxRounds; round++) {
+        if (round > 0) {
+            k0 += kPhiloxW0;
+            k1 += kPhiloxW1;
+        }
+
+        const ULong64_t product0 = kPhiloxM0 * x0;
+        const ULong64_t product1 = kPhiloxM1 * x2;
+
+        x0 = (UInt_t)(product1 >> 32) ^ x1 ^ k0;
+        x1 = (UInt_t)product1;
+        x2 = (UInt_t)(product0 >> 32) ^ x3 ^ k1;
+        x3 = (UInt_t)product0;
+    }
+
+    result[0] = x0;
+    result[1] = x1;
+    result[2] = x2;
+    result[3] = x3;
+}
+
+///////////////////////////////////////////////
+/// \brief It fills values[0..n-1] with gaussian values of mean 0 and the given
+/// sigma. The values depend only on the key, the stream words and their
+/// position.
+///
+/// The random words are first converted to uniform values in (0, 1), and the
+/// Box-Muller transform is then applied to consecutive pairs, giving two
+/// gaussian values for each pair. Both loops work on contiguous arrays
+/// without branches, so that they can be vectorized by the compiler.
+///
+void TRestRawPhiloxRandom::FillGaussian(Double_t* values, Int_t n, UInt_t stream0, UInt_t stream1,
+                                        UInt_t stream2, Double_t sigma) {
+    if (n <= 0) return;
+
+    const Int_t nBlocks = (n + 3) / 4;
+    fUniform.resize(4 * nBlocks);
+
+    UInt_t counter[4] = {0, stream0, stream1, stream2};
+    UInt_t words[4];
+    for (int block = 0; block < nBlocks; block++) {
+        counter[0] = block;
+        Generate(counter, fKey, words);
+        // The half offset keeps the values away from 0, where the logarithm diverges
+        for (int i = 0; i < 4; i++) fUniform[4 * block + i] = (words[i] + 0.5) * (1. / 4294967296.);
+    }
+
+    const Double_t* u = fUniform.data();
+    const Int_t nPairs = n / 2;
+    for (int pair = 0; pair < nPairs; pair++) {
+        const Double_t radius = sigma * sqrt(-2. * log(u[2 * pair]));
+        const Double_t angle = 2. * M_PI * u[2 * pair + 1];
+        values[2 * pair] = radius * cos(angle);
+        values[2 * pair + 1] = radius * sin(angle);
+    }
+
+    if (n % 2 == 1) values[n - 1] = sigma * sqrt(-2. * log(u[n - 1])) * cos(2. * M_PI * u[n]);
+}
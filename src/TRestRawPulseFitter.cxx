@@ -0,0 +1,333 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+
+//////////////////////////////////////////////////////////////////////////
+/// TRestRawPulseFitter fits a raw signal to the AGET shaperSin pulse
+///
+/// \f$ f(x) = B + A\, e^{-3u} u^3 \sin(u), \quad u = (x-t_0)/\tau \f$
+///
+/// with \f$ f(x) = B \f$ before the start position \f$ t_0 \f$. This is the
+/// function used by TRestRawSignalFittingProcess, where the logistic factor
+/// selecting \f$ x > t_0 \f$ is replaced by a step.
+///
+/// The fit minimizes the sum of the squared residuals using the
+/// Levenberg-Marquardt algorithm with analytical derivatives. The initial
+/// parameters are obtained from a linear fit of baseline and amplitude for
+/// a set of shaping times, placing the pulse maximum at the maximum of the
+/// signal.
+///
+/// The data, model and jacobian arrays are kept between fits, so that no
+/// memory is allocated once the fitter has been used with the largest signal.
+/// A fitter does not share any state with other fitters, and different
+/// signals can be fitted in parallel using one fitter per thread.
+///
+/// \code
+/// TRestRawPulseFitter fitter;
+/// if (fitter.Fit(signal))
+///     cout << "Amplitude : " << fitter.GetParameter(TRestRawPulseFitter::kAmplitude) << endl;
+/// \endcode
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: First implementation, to replace the TF1 fit of
+///               TRestRawSignalFittingProcess.
+///
+/// \class      TRestRawPulseFitter
+///
+/// <hr>
+///
+#include "TRestRawPulseFitter.h"
+
+#include <cmath>
+
+using namespace std;
+
+ClassImp(TRestRawPulseFitter);
+
+namespace {
+/// The value of u where the shape is maximum
+const Double_t kShapePeak = 1.1664004579572074;
+/// The shape value at its maximum
+const Double_t kShapeMaximum = 0.044089531093414534;
+}  // namespace
+
+///////////////////////////////////////////////
+/// \brief It solves the linear system a x = b of n equations, using gaussian
+/// elimination with partial pivoting. The matrix a is given by rows. The
+/// matrix and vector are modified.
+///
+/// It returns false if the matrix is singular.
+///
+Bool_t TRestRawPulseFitter::SolveLinearSystem(Double_t* a, Double_t* b, Double_t* x, Int_t n) {
+    for (int c = 0; c < n; c++) {
+        Int_t pivot = c;
+        for (int r = c + 1; r < n; r++)
+            if (abs(a[r * n + c]) > abs(a[pivot * n + c])) pivot = r;
+        if (a[pivot * n + c] == 0) return false;
+
+        if (pivot != c) {
+            for (int k = 0; k < n; k++) swap(a[c * n + k], a[pivot * n + k]);
+            swap(b[c], b[pivot]);
+        }
+
+        for (int r = c + 1; r < n; r++) {
+            const Double_t factor = a[r * n + c] / a[c * n + c];
+            for (int k = c; k < n; k++) a[r * n + k] -= factor * a[c * n + k];
+            b[r] -= factor * b[c];
+        }
+    }
+
+    for (int r = n - 1; r >= 0; r--) {
+        Double_t sum = b[r];
+        for (int k = r + 1; k < n; k++) sum -= a[r * n + k] * x[k];
+        x[r] = sum / a[r * n + r];
+    }
+    return true;
+}
+
+///////////////////////////////////////////////
+/// \brief Default constructor
+///
+TRestRawPulseFitter::TRestRawPulseFitter() {}
+
+///////////////////////////////////////////////
+/// \brief Default destructor
+///
+TRestRawPulseFitter::~TRestRawPulseFitter() {}
+
+///////////////////////////////////////////////
+/// \brief The pulse shape, exp(-3u) u^3 sin(u), which is 0 for u <= 0
+///
+Double_t TRestRawPulseFitter::Shape(Double_t u) {
+    if (u <= 0) return 0;
+    return exp(-3. * u) * u * u * u * sin(u);
+}
+
+///////////////////////////////////////////////
+/// \brief The derivative of the pulse shape with respect to u
+///
+Double_t TRestRawPulseFitter::ShapeDerivative(Double_t u) {
+    if (u <= 0) return 0;
+    return exp(-3. * u) * u * u * ((3. - 3. * u) * sin(u) + u * cos(u));
+}
+
+///////////////////////////////////////////////
+/// \brief It evaluates the model at x for the given parameters
+///
+Double_t TRestRawPulseFitter::Evaluate(Double_t x, const Double_t* par) {
+    return par[kBaseline] + par[kAmplitude] * Shape((x - par[kStartPosition]) / par[kShapingTime]);
+}
+
+///////////////////////////////////////////////
+/// \brief It fills the model for the given parameters and returns the chi
+/// square with respect to fData
+///
+Double_t TRestRawPulseFitter::ComputeModel(const Double_t* par, vector<Double_t>& model) const {
+    const Int_t nBins = fData.size();
+    const Double_t invTau = 1. / par[kShapingTime];
+
+    Double_t chiSquare = 0;
+    for (int i = 0; i < nBins; i++) {
+        model[i] = par[kBaseline] + par[kAmplitude] * Shape((i - par[kStartPosition]) * invTau);
+        const Double_t residual = fData[i] - model[i];
+        chiSquare += residual * residual;
+    }
+    return chiSquare;
+}
+
+///////////////////////////////////////////////
+/// \brief It fills the jacobian of the model at the fitted parameters, with
+/// the kNParameters derivatives of each bin stored contiguously
+///
+void TRestRawPulseFitter::ComputeJacobian() {
+    const Int_t nBins = fData.size();
+    const Double_t amplitude = fParameters[kAmplitude];
+    const Double_t invTau = 1. / fParameters[kShapingTime];
+
+    for (int i = 0; i < nBins; i++) {
+        const Double_t u = (i - fParameters[kStartPosition]) * invTau;
+        const Double_t derivative = amplitude * ShapeDerivative(u) * invTau;
+
+        Double_t* row = &fJacobian[i * kNParameters];
+        row[kBaseline] = 1;
+        row[kAmplitude] = Shape(u);
+        row[kShapingTime] = -derivative * u;
+        row[kStartPosition] = -derivative;
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief It obtains the initial parameters of the fit.
+///
+/// The pulse maximum is placed at the maximum of the data. For each shaping
+/// time in a geometric series, the baseline and amplitude are obtained by a
+/// linear fit, and the shaping time with the lowest chi square is used.
+///
+void TRestRawPulseFitter::InitialParameters() {
+    const Int_t nBins = fData.size();
+
+    Int_t maxBin = 0;
+    for (int i = 1; i < nBins; i++)
+        if (fData[i] > fData[maxBin]) maxBin = i;
+
+    Double_t sumY = 0, sumYY = 0;
+    for (int i = 0; i < nBins; i++) {
+        sumY += fData[i];
+        sumYY += fData[i] * fData[i];
+    }
+
+    // A first guess, in case the linear fits fail
+    const Int_t nBaseline = max(1, min(maxBin / 2, 64));
+    Double_t baseline = 0;
+    for (int i = 0; i < nBaseline; i++) baseline += fData[i];
+    baseline /= nBaseline;
+
+    fParameters[kBaseline] = baseline;
+    fParameters[kShapingTime] = max(1., nBins / 16.);
+    fParameters[kStartPosition] = maxBin - kShapePeak * fParameters[kShapingTime];
+    fParameters[kAmplitude] = (fData[maxBin] - baseline) / kShapeMaximum;
+
+    Double_t bestChiSquare = -1;
+    for (Double_t tau = 1; tau <= nBins / 2.; tau *= 1.5) {
+        const Double_t start = maxBin - kShapePeak * tau;
+
+        Double_t sumG = 0, sumGG = 0, sumYG = 0;
+        for (int i = max(0, (Int_t)ceil(start)); i < nBins; i++) {
+            const Double_t g = Shape((i - start) / tau);
+            sumG += g;
+            sumGG += g * g;
+            sumYG += fData[i] * g;
+        }
+
+        const Double_t determinant = nBins * sumGG - sumG * sumG;
+        if (determinant <= 0) continue;
+
+        const Double_t b = (sumGG * sumY - sumG * sumYG) / determinant;
+        const Double_t a = (nBins * sumYG - sumG * sumY) / determinant;
+        const Double_t chiSquare = sumYY - b * sumY - a * sumYG;
+
+        if (bestChiSquare < 0 || chiSquare < bestChiSquare) {
+            bestChiSquare = chiSquare;
+            fParameters[kBaseline] = b;
+            fParameters[kAmplitude] = a;
+            fParameters[kShapingTime] = tau;
+            fParameters[kStartPosition] = start;
+        }
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief It fits the given raw data, without baseline subtraction.
+///
+/// It returns false if the fit did not converge within the maximum number of
+/// iterations. The parameters, chi square and model of the last iteration
+/// are available in any case.
+///
+Bool_t TRestRawPulseFitter::Fit(const Short_t* data, Int_t nBins) {
+    fIterations = 0;
+    fConverged = false;
+    fChiSquare = 0;
+    if (nBins < kNParameters) return false;
+
+    fData.resize(nBins);
+    fModel.resize(nBins);
+    fTrial.resize(nBins);
+    fJacobian.resize(nBins * kNParameters);
+    for (int i = 0; i < nBins; i++) fData[i] = data[i];
+
+    InitialParameters();
+    fChiSquare = ComputeModel(fParameters, fModel);
+
+    Double_t lambda = 1.e-3;
+    Double_t alpha[kNParameters][kNParameters];
+    Double_t beta[kNParameters];
+    Double_t matrix[kNParameters][kNParameters];
+    Double_t rhs[kNParameters];
+    Double_t step[kNParameters];
+    Double_t trial[kNParameters];
+
+    while (fIterations < fMaxIterations && !fConverged) {
+        fIterations++;
+
+        // The normal equations, J^T J and J^T r
+        ComputeJacobian();
+        for (int p = 0; p < kNParameters; p++) {
+            beta[p] = 0;
+            for (int q = 0; q < kNParameters; q++) alpha[p][q] = 0;
+        }
+        for (int i = 0; i < nBins; i++) {
+            const Double_t* row = &fJacobian[i * kNParameters];
+            const Double_t residual = fData[i] - fModel[i];
+            for (int p = 0; p < kNParameters; p++) {
+                beta[p] += row[p] * residual;
+                for (int q = 0; q <= p; q++) alpha[p][q] += row[p] * row[q];
+            }
+        }
+        for (int p = 0; p < kNParameters; p++)
+            for (int q = p + 1; q < kNParameters; q++) alpha[p][q] = alpha[q][p];
+
+        // The damping is increased until the chi square decreases
+        Bool_t improved = false;
+        while (!improved && lambda < 1.e10) {
+            for (int p = 0; p < kNParameters; p++) {
+                for (int q = 0; q < kNParameters; q++) matrix[p][q] = alpha[p][q];
+                matrix[p][p] += lambda * (alpha[p][p] > 0 ? alpha[p][p] : 1);
+                rhs[p] = beta[p];
+            }
+
+            if (SolveLinearSystem(&matrix[0][0], rhs, step, kNParameters)) {
+                for (int p = 0; p < kNParameters; p++) trial[p] = fParameters[p] + step[p];
+
+                if (trial[kShapingTime] > 0) {
+                    const Double_t chiSquare = ComputeModel(trial, fTrial);
+                    if (chiSquare <= fChiSquare) {
+                        fConverged = fChiSquare - chiSquare <= fTolerance * fChiSquare;
+                        fChiSquare = chiSquare;
+                        for (int p = 0; p < kNParameters; p++) fParameters[p] = trial[p];
+                        fModel.swap(fTrial);
+                        lambda = max(lambda / 10, 1.e-10);
+                        improved = true;
+                        continue;
+                    }
+                }
+            }
+            lambda *= 10;
+        }
+
+        // No step reduces the chi square, we are at the minimum
+        if (!improved) fConverged = true;
+    }
+
+    return fConverged;
+}
+
+///////////////////////////////////////////////
+/// \brief It fits the raw data of the given signal
+///
+Bool_t TRestRawPulseFitter::Fit(const TRestRawSignal* signal) {
+    return Fit(signal->GetSignalData(), signal->GetNumberOfPoints());
+}
@@ -0,0 +1,170 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+
+//////////////////////////////////////////////////////////////////////////
+/// TRestRawPulseTemplateBank tabulates the AGET shaperSin pulse of
+/// TRestRawPulseFitter::Shape convoluted with a normalized gaussian.
+///
+/// The convolution of the pulse with shaping time \f$\tau\f$ and a gaussian
+/// of width \f$\sigma\f$ only depends on \f$ u = (x-t_0)/\tau \f$ and on the
+/// ratio \f$ s = \sigma/\tau \f$, so that a single table G(u, s) describes
+/// all the shaping times and widths. The table and its derivative in u are
+/// computed once by Build, and Evaluate interpolates them bilinearly.
+///
+/// With the default grid, u from -5 to 15 in steps of 0.02 and s up to 1 in
+/// steps of 0.01, the relative interpolation error at the pulse maximum is
+/// below 1e-4.
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: First implementation, to replace the TF1Convolution of
+///               TRestRawSignalConvolutionFittingProcess.
+///
+/// \class      TRestRawPulseTemplateBank
+///
+/// <hr>
+///
+#include "TRestRawPulseTemplateBank.h"
+
+#include <cmath>
+
+#include "TRestRawPulseFitter.h"
+
+using namespace std;
+
+ClassImp(TRestRawPulseTemplateBank);
+
+///////////////////////////////////////////////
+/// \brief Default constructor
+///
+TRestRawPulseTemplateBank::TRestRawPulseTemplateBank() {}
+
+///////////////////////////////////////////////
+/// \brief Constructor defining the grid of the table
+///
+TRestRawPulseTemplateBank::TRestRawPulseTemplateBank(Double_t minU, Double_t maxU, Double_t stepU,
+                                                     Double_t maxS, Double_t stepS)
+    : fMinU(minU), fMaxU(maxU), fStepU(stepU), fMaxS(maxS), fStepS(stepS) {}
+
+///////////////////////////////////////////////
+/// \brief Default destructor
+///
+TRestRawPulseTemplateBank::~TRestRawPulseTemplateBank() {}
+
+///////////////////////////////////////////////
+/// \brief It computes the table. The gaussian is sampled with the step of u
+/// up to 6 sigmas, and normalized to unit sum.
+///
+void TRestRawPulseTemplateBank::Build() {
+    fNu = (Int_t)round((fMaxU - fMinU) / fStepU) + 1;
+    fNs = max((Int_t)round(fMaxS / fStepS) + 1, 2);
+
+    // The pulse and its derivative sampled beyond the table, to cover the widest gaussian
+    const Int_t margin = (Int_t)ceil(6 * fMaxS / fStepU);
+    vector<Double_t> shape(fNu + 2 * margin);
+    vector<Double_t> derivative(fNu + 2 * margin);
+    for (int k = 0; k < (Int_t)shape.size(); k++) {
+        const Double_t u = fMinU + (k - margin) * fStepU;
+        shape[k] = TRestRawPulseFitter::Shape(u);
+        derivative[k] = TRestRawPulseFitter::ShapeDerivative(u);
+    }
+
+    fTemplate.assign(fNs * fNu, 0);
+    fDerivative.assign(fNs * fNu, 0);
+
+    vector<Double_t> weights;
+    for (int is = 0; is < fNs; is++) {
+        const Double_t s = is * fStepS;
+        const Int_t width = s > 0 ? min((Int_t)ceil(6 * s / fStepU), margin) : 0;
+
+        weights.resize(2 * width + 1);
+        Double_t sum = 0;
+        for (int j = -width; j <= width; j++) {
+            const Double_t v = j * fStepU / (s > 0 ? s : 1);
+            weights[j + width] = exp(-0.5 * v * v);
+            sum += weights[j + width];
+        }
+        for (auto& w : weights) w /= sum;
+
+        Double_t* row = &fTemplate[is * fNu];
+        Double_t* rowDerivative = &fDerivative[is * fNu];
+        for (int iu = 0; iu < fNu; iu++) {
+            const Int_t center = iu + margin;
+            Double_t value = 0, valueDerivative = 0;
+            for (int j = -width; j <= width; j++) {
+                value += weights[j + width] * shape[center - j];
+                valueDerivative += weights[j + width] * derivative[center - j];
+            }
+            row[iu] = value;
+            rowDerivative[iu] = valueDerivative;
+        }
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief It returns the convoluted pulse at u for the width ratio s, and
+/// optionally its derivatives.
+///
+/// Outside the table the pulse is taken as 0. The width ratio is limited to
+/// the table range, where the derivative in s is 0.
+///
+Double_t TRestRawPulseTemplateBank::Evaluate(Double_t u, Double_t s, Double_t* dGdu, Double_t* dGds) const {
+    if (dGdu) *dGdu = 0;
+    if (dGds) *dGds = 0;
+    if (!IsBuilt() || u < fMinU || u >= fMaxU) return 0;
+
+    const Double_t xu = (u - fMinU) / fStepU;
+    const Int_t iu = min((Int_t)xu, fNu - 2);
+    const Double_t fu = xu - iu;
+
+    Bool_t insideS = true;
+    Double_t xs = s / fStepS;
+    if (xs < 0) {
+        xs = 0;
+        insideS = false;
+    } else if (xs > fNs - 1) {
+        xs = fNs - 1;
+        insideS = false;
+    }
+    const Int_t is = min((Int_t)xs, fNs - 2);
+    const Double_t fs = xs - is;
+
+    const Double_t* low = &fTemplate[is * fNu + iu];
+    const Double_t* high = low + fNu;
+    const Double_t lowValue = (1 - fu) * low[0] + fu * low[1];
+    const Double_t highValue = (1 - fu) * high[0] + fu * high[1];
+
+    if (dGdu) {
+        const Double_t* lowDerivative = &fDerivative[is * fNu + iu];
+        const Double_t* highDerivative = lowDerivative + fNu;
+        *dGdu = (1 - fs) * ((1 - fu) * lowDerivative[0] + fu * lowDerivative[1]) +
+                fs * ((1 - fu) * highDerivative[0] + fu * highDerivative[1]);
+    }
+    if (dGds && insideS) *dGds = (highValue - lowValue) / fStepS;
+
+    return (1 - fs) * lowValue + fs * highValue;
+}
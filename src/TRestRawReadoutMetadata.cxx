@@ -52,3 +52,12 @@ std::vector<UShort_t> TRestRawReadoutMetadata::GetChannelDaqIDsForType(const std
     }
     return result;
 }
+
+std::vector<UShort_t> TRestRawReadoutMetadata::GetChannelDaqIDs() const {
+    std::vector<UShort_t> result;
+    result.reserve(fChannelInfo.size());
+    for (const auto& channel : fChannelInfo) {
+        result.push_back(channel.first);
+    }
+    return result;
+}
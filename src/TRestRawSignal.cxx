@@ -65,6 +65,7 @@
 #include <TMath.h>
 #include <TRandom3.h>
 
+#include <algorithm>
 #include <numeric>
 
 using namespace std;
@@ -92,6 +93,25 @@ TRestRawSignal::TRestRawSignal(Int_t nBins) {
     fSignalData.resize(nBins, 0);
 }
 
+///////////////////////////////////////////////
+/// \brief It clears the values calculated from the data points (baseline,
+/// points over threshold, threshold integral and range), keeping the signal id
+/// and data. It must be called after the data points are modified in place, so
+/// that the signal is equivalent to a new signal built with AddPoint. The seed
+/// is also set again as for a new signal.
+///
+void TRestRawSignal::ResetCalculatedValues() {
+    fSeed = gRandom->GetSeed();
+
+    fPointsOverThreshold.clear();
+    fThresholdIntegral = -1;
+
+    fBaseLine = 0;
+    fBaseLineSigma = 0;
+
+    fRange = TVector2(0, 0);
+}
+
 ///////////////////////////////////////////////
 /// \brief Default destructor
 ///
@@ -192,6 +212,19 @@ void TRestRawSignal::IncreaseBinBy(Int_t bin, Double_t data) {
     fSignalData[bin] += data;
 }
 
+///////////////////////////////////////////////
+/// \brief It sets the value of point *n*. The value is limited to the Short_t
+/// range, as in AddPoint. No check is done on *n*.
+///
+void TRestRawSignal::SetPoint(Int_t n, Double_t value) {
+    if (value > numeric_limits<Short_t>::max()) {
+        value = numeric_limits<Short_t>::max();
+    } else if (value < numeric_limits<Short_t>::min()) {
+        value = numeric_limits<Short_t>::min();
+    }
+    fSignalData[n] = (Short_t)value;
+}
+
 ///////////////////////////////////////////////
 /// \brief It initializes the fPointsOverThreshold array with the indexes of
 /// data points that are found over
@@ -656,7 +689,8 @@ void TRestRawSignal::GetSignalSmoothed(TRestRawSignal* smoothedSignal, Int_t ave
 /// points used to average the signal
 ///
 /// \param option If the option is set to "EXCLUDE OUTLIERS", points that are too far away from the median
-/// baseline will be ignored to improve the smoothing result
+/// baseline will be ignored to improve the smoothing result. If it is set to "MEDIAN", the running median
+/// is used instead of the average.
 ///
 std::vector<Float_t> TRestRawSignal::GetSignalSmoothed(Int_t averagingPoints, std::string option) {
     std::vector<Float_t> result;
@@ -680,6 +714,8 @@ std::vector<Float_t> TRestRawSignal::GetSignalSmoothed(Int_t averagingPoints, st
             result[i] = sumAvg;
     } else if (ToUpper(option) == "EXCLUDE OUTLIERS") {
         result = GetSignalSmoothed_ExcludeOutliers(averagingPoints);
+    } else if (ToUpper(option) == "MEDIAN") {
+        result = GetSignalSmoothed_Median(averagingPoints);
     } else {
         cout << "TRestRawSignal::GetSignalSmoothed. Error! No such option!" << endl;
     }
@@ -724,6 +760,60 @@ std::vector<Float_t> TRestRawSignal::GetSignalSmoothed_ExcludeOutliers(Int_t ave
     return result;
 }
 
+///////////////////////////////////////////////
+/// \brief It smooths the existing signal using a running median, and returns it in a vector of Float_t
+/// values. Since the median is not affected by the outliers (e.g. signals), no baseline calculation is
+/// needed.
+///
+/// The values of the window are kept sorted. When the window moves, the value leaving the window is
+/// replaced by the new one, and the values in between are shifted by one position. Consecutive baseline
+/// values are close to each other, so that only a few elements are moved on average.
+///
+/// \param averagingPoints It defines the number of neighbour consecutive
+/// points used to obtain the median. Values below 1 are taken as 1.
+///
+std::vector<Float_t> TRestRawSignal::GetSignalSmoothed_Median(Int_t averagingPoints) {
+    const Int_t nPoints = GetNumberOfPoints();
+    std::vector<Float_t> result(nPoints);
+    if (nPoints == 0) return result;
+
+    if (averagingPoints < 1) averagingPoints = 1;
+    averagingPoints = (averagingPoints / 2) * 2 + 1;  // make it odd >= averagingPoints
+    if (averagingPoints > nPoints) averagingPoints = ((nPoints - 1) / 2) * 2 + 1;
+    const Int_t half = averagingPoints / 2;
+
+    std::vector<Short_t> window(fSignalData.begin(), fSignalData.begin() + averagingPoints);
+    std::sort(window.begin(), window.end());
+
+    // Points at the beginning, where we cannot calculate a running median. They take the first median.
+    for (int i = 0; i <= half; i++) result[i] = window[half];
+
+    // Points in the middle
+    for (int i = half + 1; i < nPoints - half; i++) {
+        const Short_t oldValue = fSignalData[i - half - 1];
+        const Short_t newValue = fSignalData[i + half];
+
+        if (newValue != oldValue) {
+            auto from = std::lower_bound(window.begin(), window.end(), oldValue);
+            if (newValue > oldValue) {
+                auto to = std::lower_bound(from + 1, window.end(), newValue);
+                std::move(from + 1, to, from);
+                *(to - 1) = newValue;
+            } else {
+                auto to = std::upper_bound(window.begin(), from, newValue);
+                std::move_backward(to, from, from + 1);
+                *to = newValue;
+            }
+        }
+
+        result[i] = window[half];
+    }
+
+    // Points at the end, where we cannot calculate a running median. They take the last median.
+    for (int i = nPoints - half; i < nPoints; i++) result[i] = window[half];
+    return result;
+}
+
 ///////////////////////////////////////////////
 /// \brief It applies the moving average filter (GetSignalSmoothed) to the signal, which is then subtracted
 /// from the raw data, resulting in a corrected baseline. The returned signal is placed at the signal pointer
@@ -734,10 +824,13 @@ std::vector<Float_t> TRestRawSignal::GetSignalSmoothed_ExcludeOutliers(Int_t ave
 /// \param averagingPoints It defines the number of neighbour consecutive
 /// points used to average the signal
 ///
-void TRestRawSignal::GetBaseLineCorrected(TRestRawSignal* smoothedSignal, Int_t averagingPoints) {
+/// \param option The GetSignalSmoothed option, "EXCLUDE OUTLIERS" or "MEDIAN"
+///
+void TRestRawSignal::GetBaseLineCorrected(TRestRawSignal* smoothedSignal, Int_t averagingPoints,
+                                          const std::string& option) {
     smoothedSignal->Initialize();
 
-    std::vector<Float_t> averagedSignal = GetSignalSmoothed(averagingPoints, "EXCLUDE OUTLIERS");
+    std::vector<Float_t> averagedSignal = GetSignalSmoothed(averagingPoints, option);
 
     for (int i = 0; i < GetNumberOfPoints(); i++) {
         smoothedSignal->AddPoint(GetRawData(i) - averagedSignal[i]);
@@ -24,15 +24,28 @@
 /// TRestRawSignalAddNoiseProcess is a process that allows to add a
 /// random gaussian noise to the input TRestRawSignalEvent.
 ///
-/// The process makes use of TRestRawSignal::GetWhiteNoiseSignal which simply
-/// adds a random gaussian value centered on zero and with a sigma given
-/// by the parameter `noiseLevel`.
+/// The process adds to each point a random gaussian value centered on zero
+/// and with a sigma given by the parameter `noiseLevel`.
+///
+/// By default the noise is produced by the counter-based generator
+/// TRestRawPhiloxRandom. The generator key is built from the parameter `seed`
+/// and the run number, and the noise of each signal is identified by the
+/// event id, the sub-event id and the signal id. The noise added to a signal
+/// is therefore the same whatever the number of threads or the order in
+/// which the events are processed, and two different signals never share the
+/// same noise.
+///
+/// The parameter `generator` can be set to `TRandom3` to recover the previous
+/// behaviour, where TRestRawSignal::GetWhiteNoiseSignal was used. In that
+/// case the noise is obtained from a TRandom3 generator seeded with the seed
+/// of each signal. Any other value is replaced by `philox` at InitProcess.
 ///
 /// The process can be defined as follows:
 ///
 /// \code
 /// <TRestRawSignalAddNoiseProcess name="noise" >
 ///     <parameter name="noiseLevel" value="10" />
+///     <parameter name="seed" value="17" />
 /// </TRestRawSignalAddNoiseProcess>
 /// \endcode
 ///
@@ -42,6 +55,9 @@
 /// <TRestRawSignalAddNoiseProcess name="noise" noiseLevel="10" />
 /// \endcode
 ///
+/// If the parameter `inPlace` is set to true, the noise is added directly to
+/// the signals of the input event, which is then returned as the output event.
+///
 /// <hr>
 ///
 /// \warning **⚠ REST is under continuous development.** This documentation
@@ -64,6 +80,10 @@
 /// process.
 /// \author     Javier Gracia
 ///
+/// 2026-October: In place mode.
+///
+/// 2026-October: Counter-based noise generator, keyed by run, event and signal.
+///
 /// \class TRestRawSignalAddNoiseProcess
 ///
 /// <hr>
@@ -72,6 +92,7 @@
 #include "TRestRawSignalAddNoiseProcess.h"
 
 #include <TFile.h>
+#include <TRandom3.h>
 
 using namespace std;
 
@@ -147,6 +168,16 @@ void TRestRawSignalAddNoiseProcess::LoadConfig(const string& configFilename, con
     }
 }
 
+///////////////////////////////////////////////
+/// \brief Process initialization. It checks the noise generator.
+///
+void TRestRawSignalAddNoiseProcess::InitProcess() {
+    if (fGenerator != "philox" && fGenerator != "TRandom3") {
+        RESTWarning << "Generator : " << fGenerator << " is not defined. Using philox." << RESTendl;
+        fGenerator = "philox";
+    }
+}
+
 ///////////////////////////////////////////////
 /// \brief The main processing event function
 ///
@@ -157,15 +188,70 @@ TRestEvent* TRestRawSignalAddNoiseProcess::ProcessEvent(TRestEvent* inputEvent)
         return nullptr;
     }
 
+    SetEventKey(fInputSignalEvent);
+
+    if (fInPlace) {
+        for (int n = 0; n < fInputSignalEvent->GetNumberOfSignals(); n++) {
+            ProcessSignal(fInputSignalEvent->GetSignal(n));
+        }
+        return fInputSignalEvent;
+    }
+
     for (int n = 0; n < fInputSignalEvent->GetNumberOfSignals(); n++) {
+        const TRestRawSignal* signal = fInputSignalEvent->GetSignal(n);
         TRestRawSignal noiseSignal;
 
         // Assign ID and add noise
-        fInputSignalEvent->GetSignal(n)->GetWhiteNoiseSignal(&noiseSignal, fNoiseLevel);
-        noiseSignal.SetSignalID(fInputSignalEvent->GetSignal(n)->GetSignalID());
+        GenerateNoise(signal);
+        for (int i = 0; i < signal->GetNumberOfPoints(); i++) {
+            noiseSignal.AddPoint(signal->GetData(i) + fNoise[i]);
+        }
+        noiseSignal.SetSignalID(signal->GetSignalID());
 
         fOutputSignalEvent->AddSignal(noiseSignal);
     }
 
     return fOutputSignalEvent;
 }
+
+///////////////////////////////////////////////
+/// \brief It defines the generator key and counters from the given event. It
+/// must be called before the signals of a new event are processed with
+/// ProcessSignal.
+///
+void TRestRawSignalAddNoiseProcess::SetEventKey(const TRestEvent* event) {
+    fRandom.SetKey(fSeed, event->GetRunOrigin());
+    fEventId = event->GetID();
+    fSubEventId = event->GetSubID();
+}
+
+///////////////////////////////////////////////
+/// \brief It adds the noise to the given signal, modifying it in place. The noise
+/// is the same than the one added when the process is not in place.
+///
+void TRestRawSignalAddNoiseProcess::ProcessSignal(TRestRawSignal* signal) {
+    GenerateNoise(signal);
+    for (int i = 0; i < signal->GetNumberOfPoints(); i++) {
+        signal->SetPoint(i, signal->GetData(i) + fNoise[i]);
+    }
+    signal->ResetCalculatedValues();
+}
+
+///////////////////////////////////////////////
+/// \brief It fills fNoise with the noise values of the given signal.
+///
+/// With the `TRandom3` generator the values are the ones used by
+/// TRestRawSignal::GetWhiteNoiseSignal.
+///
+void TRestRawSignalAddNoiseProcess::GenerateNoise(const TRestRawSignal* signal) {
+    const Int_t nPoints = signal->GetNumberOfPoints();
+    fNoise.resize(nPoints);
+
+    if (fGenerator == "TRandom3") {
+        TRandom3 random(signal->GetSeed());
+        for (int i = 0; i < nPoints; i++) fNoise[i] = random.Gaus(0, fNoiseLevel);
+        return;
+    }
+
+    fRandom.FillGaussian(fNoise.data(), nPoints, fEventId, signal->GetSignalID(), fSubEventId, fNoiseLevel);
+}
@@ -49,6 +49,10 @@
 /// * **pointsOverThreshold**: The minimum number of points over threshold to
 /// identify a signal as such
 ///
+/// * **flatObservables**: If true, the per-signal observables are written as
+/// vectors instead of maps. See the observables for individual signal info
+/// below. Default: false.
+///
 /// Additionaly, there is a metadata parameter,*signalsRange* that allows to
 /// define the signal ids over which this process will have effect. This
 /// parameter may allow to define different TRestRawSignalAnalysisProcess
@@ -205,6 +209,29 @@
 /// A certain number of samples must pass the threshold to be taken into
 /// account.
 ///
+/// When **flatObservables** is true, the maps baseline_map, baselinesigma_map,
+/// max_amplitude_map, thr_integral_map, risetime_map, peak_time_map and
+/// pointsoverthres_map are replaced by the vectors baseline, baselinesigma,
+/// max_amplitude, thr_integral, risetime, peak_time and pointsoverthres. The
+/// vector **signal_id** holds the ID of the signal at each position. Vector
+/// branches avoid the map allocations at each event and are faster to read.
+///
+/// \code
+/// <addProcess type="TRestRawSignalAnalysisProcess" name="rawAna" value="ON"
+///     observable="all" flatObservables="true" />
+/// \endcode
+///
+///
+/// Only the observables written to the analysis tree, or used by a cut, are
+/// computed. The intermediate results shared by several observables, as the
+/// points over threshold or the maximum peak bin of each signal, are computed
+/// once per event. Trimming the observables at the RML, instead of using
+/// observable="all", reduces the processing time.
+///
+/// The cuts on NumberOfSignals, BaseLineMean, BaseLineSigmaMean and
+/// TimeBinsLength only need the baseline of the signals. They are applied
+/// before any other observable is computed, so the events they reject skip
+/// the rest of the analysis.
 ///
 /// You may add filters to any observable inside the analysis tree. To add a cut,
 /// write "cut" sections in your rml file:
@@ -275,12 +302,15 @@ void TRestRawSignalAnalysisProcess::Initialize() {
 }
 
 ///////////////////////////////////////////////
-/// \brief Process initialization.
+/// \brief Process initialization. The observables are registered here, each with
+/// the function that computes and sets its value.
 ///
 void TRestRawSignalAnalysisProcess::InitProcess() {
     if (fSignalsRange.X() != -1 && fSignalsRange.Y() != -1) {
         fRangeEnabled = true;
     }
+
+    RegisterObservables();
 }
 
 void TRestRawSignalAnalysisProcess::InitFromConfigFile() {
@@ -292,221 +322,548 @@ void TRestRawSignalAnalysisProcess::InitFromConfigFile() {
 }
 
 ///////////////////////////////////////////////
-/// \brief The main processing event function
+/// \brief It registers the observables of the process, in the order they are written,
+/// together with the function that computes and sets each of them.
+///
+void TRestRawSignalAnalysisProcess::RegisterObservables() {
+    fObservableCalculators.clear();
+    fActiveCalculators.clear();
+    fObservablesResolved = false;
+
+    auto add = [this](const string& name, const std::function<void()>& calculator) {
+        fObservableCalculators.emplace_back(name, calculator);
+    };
+
+    // Per-signal observables
+    if (fFlatObservables) {
+        add("signal_id", [this]() {
+            fSignalIds.clear();
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (IsSignalInRange(s)) fSignalIds.push_back(fEvent.GetSignal(s)->GetID());
+            }
+            SetObservableValue("signal_id", fSignalIds);
+        });
+        add("pointsoverthres", [this]() {
+            ComputePointsOverThreshold();
+            fPointsOverThresholdN.clear();
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (!IsSignalInRange(s)) continue;
+                fPointsOverThresholdN.push_back(fEvent.GetSignal(s)->GetPointsOverThreshold().size());
+            }
+            SetObservableValue("pointsoverthres", fPointsOverThresholdN);
+        });
+        add("risetime", [this]() {
+            ComputePointsOverThreshold();
+            fRiseTimes.clear();
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (IsSignalInRange(s)) fRiseTimes.push_back(fEvent.GetSignal(s)->GetRiseTime());
+            }
+            SetObservableValue("risetime", fRiseTimes);
+        });
+        add("peak_time", [this]() {
+            ComputeMaxPeakBins();
+            fPeakTimes.clear();
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (IsSignalInRange(s)) fPeakTimes.push_back(fMaxPeakBins[s]);
+            }
+            SetObservableValue("peak_time", fPeakTimes);
+        });
+        add("baseline", [this]() {
+            fBaseLines.clear();
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (IsSignalInRange(s)) fBaseLines.push_back(fEvent.GetSignal(s)->GetBaseLine());
+            }
+            SetObservableValue("baseline", fBaseLines);
+        });
+        add("baselinesigma", [this]() {
+            fBaseLineSigmas.clear();
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (IsSignalInRange(s)) fBaseLineSigmas.push_back(fEvent.GetSignal(s)->GetBaseLineSigma());
+            }
+            SetObservableValue("baselinesigma", fBaseLineSigmas);
+        });
+        add("max_amplitude", [this]() {
+            ComputeMaxPeakBins();
+            fMaxAmplitudes.clear();
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (!IsSignalInRange(s)) continue;
+                fMaxAmplitudes.push_back(fEvent.GetSignal(s)->GetData(fMaxPeakBins[s]));
+            }
+            SetObservableValue("max_amplitude", fMaxAmplitudes);
+        });
+        add("thr_integral", [this]() {
+            ComputePointsOverThreshold();
+            fThresholdIntegrals.clear();
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (!IsSignalInRange(s)) continue;
+                fThresholdIntegrals.push_back(fEvent.GetSignal(s)->GetThresholdIntegral());
+            }
+            SetObservableValue("thr_integral", fThresholdIntegrals);
+        });
+    } else {
+        // we save some complex typed analysis result
+        add("pointsoverthres_map", [this]() {
+            ComputePointsOverThreshold();
+            map<int, int> npointsot;
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (!IsSignalInRange(s)) continue;
+                TRestRawSignal* sgnl = fEvent.GetSignal(s);
+                npointsot[sgnl->GetID()] = sgnl->GetPointsOverThreshold().size();
+            }
+            SetObservableValue("pointsoverthres_map", npointsot);
+        });
+        add("risetime_map", [this]() {
+            ComputePointsOverThreshold();
+            map<int, int> risetime;
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (!IsSignalInRange(s)) continue;
+                TRestRawSignal* sgnl = fEvent.GetSignal(s);
+                risetime[sgnl->GetID()] = sgnl->GetRiseTime();
+            }
+            SetObservableValue("risetime_map", risetime);
+        });
+        add("peak_time_map", [this]() {
+            ComputeMaxPeakBins();
+            map<int, int> peak_time;
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (IsSignalInRange(s)) peak_time[fEvent.GetSignal(s)->GetID()] = fMaxPeakBins[s];
+            }
+            SetObservableValue("peak_time_map", peak_time);
+        });
+        add("baseline_map", [this]() {
+            map<int, Double_t> baseline;
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (!IsSignalInRange(s)) continue;
+                TRestRawSignal* sgnl = fEvent.GetSignal(s);
+                baseline[sgnl->GetID()] = sgnl->GetBaseLine();
+            }
+            SetObservableValue("baseline_map", baseline);
+        });
+        add("baselinesigma_map", [this]() {
+            map<int, Double_t> baselinesigma;
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (!IsSignalInRange(s)) continue;
+                TRestRawSignal* sgnl = fEvent.GetSignal(s);
+                baselinesigma[sgnl->GetID()] = sgnl->GetBaseLineSigma();
+            }
+            SetObservableValue("baselinesigma_map", baselinesigma);
+        });
+        add("max_amplitude_map", [this]() {
+            ComputeMaxPeakBins();
+            map<int, Double_t> ampsgn_maxmethod;
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (!IsSignalInRange(s)) continue;
+                TRestRawSignal* sgnl = fEvent.GetSignal(s);
+                ampsgn_maxmethod[sgnl->GetID()] = sgnl->GetData(fMaxPeakBins[s]);
+            }
+            SetObservableValue("max_amplitude_map", ampsgn_maxmethod);
+        });
+        add("thr_integral_map", [this]() {
+            ComputePointsOverThreshold();
+            map<int, Double_t> ampsgn_intmethod;
+            for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+                if (!IsSignalInRange(s)) continue;
+                TRestRawSignal* sgnl = fEvent.GetSignal(s);
+                ampsgn_intmethod[sgnl->GetID()] = sgnl->GetThresholdIntegral();
+            }
+            SetObservableValue("thr_integral_map", ampsgn_intmethod);
+        });
+    }
+    add("SaturatedChannelID", [this]() {
+        vector<int> saturatedchnId;
+        for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+            if (!IsSignalInRange(s)) continue;
+            TRestRawSignal* sgnl = fEvent.GetSignal(s);
+            if (sgnl->IsADCSaturation()) saturatedchnId.push_back(sgnl->GetID());
+        }
+        SetObservableValue("SaturatedChannelID", saturatedchnId);
+    });
+
+    // Number of signals and base line
+    add("BaseLineMean", [this]() {
+        Double_t baseLineMean = GetEventValue(kBaseLineMean);
+        SetObservableValue("BaseLineMean", baseLineMean);
+    });
+    add("BaseLineSigmaMean", [this]() {
+        Double_t baseLineSigma = GetEventValue(kBaseLineSigmaMean);
+        SetObservableValue("BaseLineSigmaMean", baseLineSigma);
+    });
+    add("TimeBinsLength", [this]() {
+        Double_t timeDelay = GetEventValue(kTimeBinsLength);
+        SetObservableValue("TimeBinsLength", timeDelay);
+    });
+    add("NumberOfSignals", [this]() {
+        Int_t nSignals = fEvent.GetNumberOfSignals();
+        SetObservableValue("NumberOfSignals", nSignals);
+    });
+    add("NumberOfGoodSignals", [this]() {
+        ComputePointsOverThreshold();
+        SetObservableValue("NumberOfGoodSignals", fNGoodSignals);
+    });
+
+    // Integrals and energy estimations
+    add("FullIntegral", [this]() {
+        Double_t fullIntegral = GetEventValue(kFullIntegral);
+        SetObservableValue("FullIntegral", fullIntegral);
+    });
+    add("ThresholdIntegral", [this]() {
+        Double_t thrIntegral = GetEventValue(kThresholdIntegral);
+        SetObservableValue("ThresholdIntegral", thrIntegral);
+    });
+    add("RiseSlopeAvg", [this]() {
+        Double_t riseSlope = GetEventValue(kRiseSlope);
+        SetObservableValue("RiseSlopeAvg", riseSlope);
+    });
+    add("SlopeIntegral", [this]() {
+        Double_t slopeIntegral = GetEventValue(kSlopeIntegral);
+        SetObservableValue("SlopeIntegral", slopeIntegral);
+    });
+    add("RateOfChangeAvg", [this]() {
+        Double_t slopeIntegral = GetEventValue(kSlopeIntegral);
+        Double_t rateOfChange = GetEventValue(kRiseSlope) / slopeIntegral;
+        if (slopeIntegral == 0) rateOfChange = 0;
+        SetObservableValue("RateOfChangeAvg", rateOfChange);
+    });
+    add("RiseTimeAvg", [this]() {
+        ComputePointsOverThreshold();
+        Double_t riseTime = fEvent.GetRiseTime();
+        SetObservableValue("RiseTimeAvg", riseTime);
+    });
+    add("TripleMaxIntegral", [this]() {
+        ComputePointsOverThreshold();
+        Double_t tripleMaxIntegral = fEvent.GetTripleMaxIntegral();
+        SetObservableValue("TripleMaxIntegral", tripleMaxIntegral);
+    });
+    add("IntegralBalance", [this]() {
+        Double_t fullIntegral = GetEventValue(kFullIntegral);
+        Double_t thrIntegral = GetEventValue(kThresholdIntegral);
+        Double_t integralRatio = (fullIntegral - thrIntegral) / (fullIntegral + thrIntegral);
+        SetObservableValue("IntegralBalance", integralRatio);
+    });
+
+    // Peak amplitude and peak time observables
+    add("AmplitudeIntegralRatio", [this]() {
+        ComputePeakValues();
+        Double_t ampIntRatio = GetEventValue(kThresholdIntegral) / fMaxValueIntegral;
+        if (fMaxValueIntegral == 0) ampIntRatio = 0;
+        SetObservableValue("AmplitudeIntegralRatio", ampIntRatio);
+    });
+    add("MinPeakAmplitude", [this]() {
+        ComputePeakValues();
+        SetObservableValue("MinPeakAmplitude", fMinValue);
+    });
+    add("MaxPeakAmplitude", [this]() {
+        ComputePeakValues();
+        SetObservableValue("MaxPeakAmplitude", fMaxValue);
+    });
+    add("PeakAmplitudeIntegral", [this]() {
+        ComputePeakValues();
+        SetObservableValue("PeakAmplitudeIntegral", fMaxValueIntegral);
+    });
+    add("MinEventValue", [this]() {
+        ComputePeakValues();
+        SetObservableValue("MinEventValue", fMinDownValue);
+    });
+    add("AmplitudeRatio", [this]() {
+        ComputePeakValues();
+        Double_t amplitudeRatio = fMaxValueIntegral / fMaxValue;
+        if (fMaxValue == 0) amplitudeRatio = 0;
+        SetObservableValue("AmplitudeRatio", amplitudeRatio);
+    });
+    add("MaxPeakTime", [this]() {
+        ComputePeakValues();
+        SetObservableValue("MaxPeakTime", fMaxPeakTime);
+    });
+    add("MinPeakTime", [this]() {
+        ComputePeakValues();
+        SetObservableValue("MinPeakTime", fMinPeakTime);
+    });
+    add("MaxPeakTimeDelay", [this]() {
+        ComputePeakValues();
+        Double_t peakTimeDelay = fMaxPeakTime - fMinPeakTime;
+        SetObservableValue("MaxPeakTimeDelay", peakTimeDelay);
+    });
+    add("AveragePeakTime", [this]() {
+        ComputePeakValues();
+        SetObservableValue("AveragePeakTime", fPeakTimeAverage);
+    });
+}
+
+///////////////////////////////////////////////
+/// \brief It returns true if the observable is written to the analysis tree or
+/// it is used by a cut.
 ///
-TRestEvent* TRestRawSignalAnalysisProcess::ProcessEvent(TRestEvent* inputEvent) {
-    fInputEvent = dynamic_cast<TRestRawSignalEvent*>(inputEvent);
+Bool_t TRestRawSignalAnalysisProcess::IsObservableRequested(const string& name) const {
+    if (fDynamicObs) return true;
 
-    const auto run = GetRunInfo();
-    if (run != nullptr) {
-        fInputEvent->InitializeReferences(run);
-    }
+    const string fullName = (string)GetName() + "_" + name;
+    if (fObservablesDefined.count(name) > 0 || fObservablesDefined.count(fullName) > 0) return true;
 
-    if (fReadoutMetadata == nullptr) {
-        fReadoutMetadata = fInputEvent->GetReadoutMetadata();
+    for (const auto& cut : fCuts) {
+        if (cut.first == name || cut.first == fullName) return true;
     }
+    return false;
+}
 
-    if (fReadoutMetadata == nullptr && !fChannelTypes.empty()) {
-        cerr << "TRestRawSignalAnalysisProcess::ProcessEvent: readout metadata is null, cannot filter "
-                "the process by signal type"
-             << endl;
-        exit(1);
+///////////////////////////////////////////////
+/// \brief It keeps, from the registered observables, only the ones that are requested.
+/// It is done at the first event, once the analysis tree observables are defined.
+///
+void TRestRawSignalAnalysisProcess::ResolveObservables() {
+    fActiveCalculators.clear();
+    for (const auto& [name, calculator] : fObservableCalculators) {
+        if (IsObservableRequested(name)) {
+            fActiveCalculators.push_back(calculator);
+        } else {
+            RESTDebug << "TRestRawSignalAnalysisProcess: observable " << name << " is not requested"
+                      << RESTendl;
+        }
     }
+    fObservablesResolved = true;
+}
 
-    auto event = fInputEvent->GetSignalEventForTypes(fChannelTypes, fReadoutMetadata);
-
-    // we save some complex typed analysis result
-    map<int, Double_t> baseline;
-    map<int, Double_t> baselinesigma;
-    map<int, Double_t> ampsgn_maxmethod;
-    map<int, Double_t> ampsgn_intmethod;
-    map<int, int> risetime;
-    map<int, int> peak_time;
-    map<int, int> npointsot;
-    vector<int> saturatedchnId;
-
-    baseline.clear();
-    baselinesigma.clear();
-    ampsgn_maxmethod.clear();
-    ampsgn_intmethod.clear();
-    risetime.clear();
-    npointsot.clear();
-
-    Int_t nGoodSignals = 0;
-
-    /// We define (or re-define) the baseline range and calculation range of our
-    /// raw-signals.
-    // This will affect the calculation of observables, but not the stored
-    // TRestRawSignal data.
-    event.SetBaseLineRange(fBaseLineRange, fBaseLineOption);
-    event.SetRange(fIntegralRange);
-
-    for (int s = 0; s < event.GetNumberOfSignals(); s++) {
-        TRestRawSignal* sgnl = event.GetSignal(s);
+///////////////////////////////////////////////
+/// \brief It returns true if the signal at index `s` is inside the signalsRange
+///
+Bool_t TRestRawSignalAnalysisProcess::IsSignalInRange(Int_t s) {
+    if (!fRangeEnabled) return true;
+    const Int_t id = fEvent.GetSignal(s)->GetID();
+    return id >= fSignalsRange.X() && id <= fSignalsRange.Y();
+}
+
+///////////////////////////////////////////////
+/// \brief It initializes the points over threshold of all the signals, once per event,
+/// and counts the good signals.
+///
+void TRestRawSignalAnalysisProcess::ComputePointsOverThreshold() {
+    if (fPointsOverThresholdDone) return;
+
+    fNGoodSignals = 0;
+    for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+        TRestRawSignal* sgnl = fEvent.GetSignal(s);
 
         /// Important call we need to initialize the points over threshold in a TRestRawSignal
         sgnl->InitializePointsOverThreshold(TVector2(fPointThreshold, fSignalThreshold),
                                             fPointsOverThreshold);
 
-        if (fRangeEnabled && (sgnl->GetID() < fSignalsRange.X() || sgnl->GetID() > fSignalsRange.Y())) {
-            continue;
-        }
-
         // We do not want that signals that are not identified as such contribute to
         // define our observables
         // nkx: we still need to store all the signals in baseline/rise time maps in
         // case for noise analysis
-        // if (sgnl->GetPointsOverThreshold().size() < 2) continue;
-        if (sgnl->GetPointsOverThreshold().size() >= 2) nGoodSignals++;
-
-        // Now TRestRawSignal returns directly baseline subtracted values
-        baseline[sgnl->GetID()] = sgnl->GetBaseLine();
-        baselinesigma[sgnl->GetID()] = sgnl->GetBaseLineSigma();
-        ampsgn_intmethod[sgnl->GetID()] = sgnl->GetThresholdIntegral();
-        ampsgn_maxmethod[sgnl->GetID()] = sgnl->GetMaxPeakValue();
-        risetime[sgnl->GetID()] = sgnl->GetRiseTime();
-        peak_time[sgnl->GetID()] = sgnl->GetMaxPeakBin();
-        npointsot[sgnl->GetID()] = sgnl->GetPointsOverThreshold().size();
-        if (sgnl->IsADCSaturation()) saturatedchnId.push_back(sgnl->GetID());
+        if (IsSignalInRange(s) && sgnl->GetPointsOverThreshold().size() >= 2) fNGoodSignals++;
     }
+    fPointsOverThresholdDone = true;
+}
 
-    SetObservableValue("pointsoverthres_map", npointsot);
-    SetObservableValue("risetime_map", risetime);
-    SetObservableValue("peak_time_map", peak_time);
-    SetObservableValue("baseline_map", baseline);
-    SetObservableValue("baselinesigma_map", baselinesigma);
-    SetObservableValue("max_amplitude_map", ampsgn_maxmethod);
-    SetObservableValue("thr_integral_map", ampsgn_intmethod);
-    SetObservableValue("SaturatedChannelID", saturatedchnId);
-
-    Double_t baseLineMean = event.GetBaseLineAverage();
-    SetObservableValue("BaseLineMean", baseLineMean);
-
-    Double_t baseLineSigma = event.GetBaseLineSigmaAverage();
-    SetObservableValue("BaseLineSigmaMean", baseLineSigma);
-
-    Double_t timeDelay = event.GetMaxTime() - event.GetMinTime();
-    SetObservableValue("TimeBinsLength", timeDelay);
-
-    Int_t nSignals = event.GetNumberOfSignals();
-    SetObservableValue("NumberOfSignals", nSignals);
-    SetObservableValue("NumberOfGoodSignals", nGoodSignals);
-
-    // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-    // SubstractBaselines
-    // After this the signal gets zero-ed, for the following analysis
-    // Keep in mind, to add raw signal analysis, we must write code at before
-    // This is where most of the problems occur
-    // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
-    // Javier: I believe we should not substract baseline in the analysis process
-    // then ...
-    // ... of course we need to consider baseline substraction for each
-    // observable. TRestRawSignal methods
-    // should do that internally. I have updated that to be like that, but we need
-    // to be with open eyes for
-    // some period.
-    // Baseline substraction will always happen when we transfer a TRestRawSignal
-    // to TRestDetectorSignal
-    //
-    // We do not substract baselines then now, as it was done before
-    //
-    // fInputEvent->SubstractBaselines(fBaseLineRange.X(), fBaseLineRange.Y());
-    //
-    // Methods in TRestRawSignal have been updated to consider baseline.
-    // TRestRawSignal now implements that internally. We need to define the
-    // baseline range, and the range
-    // where calculations take place. All we need is to call at some point to the
-    // following methods.
-    //
-    // TRestRawSignalEvent::SetBaseLineRange and TRestRawSignalEvent::SetRange.
-    //
-    // Then, if any method accepts a different range it will be given in the
-    // method name,
-    // for example: GetIntegralInRange( Int_t startBin, Int_t endBin );
-    //
-
-    Double_t fullIntegral = event.GetIntegral();
-    SetObservableValue("FullIntegral", fullIntegral);
-
-    Double_t thrIntegral = event.GetThresholdIntegral();
-    SetObservableValue("ThresholdIntegral", thrIntegral);
-
-    Double_t riseSlope = event.GetRiseSlope();
-    SetObservableValue("RiseSlopeAvg", riseSlope);
-
-    Double_t slopeIntegral = event.GetSlopeIntegral();
-    SetObservableValue("SlopeIntegral", slopeIntegral);
-
-    Double_t rateOfChange = riseSlope / slopeIntegral;
-    if (slopeIntegral == 0) rateOfChange = 0;
-    SetObservableValue("RateOfChangeAvg", rateOfChange);
-
-    Double_t riseTime = event.GetRiseTime();
-    SetObservableValue("RiseTimeAvg", riseTime);
-
-    Double_t tripleMaxIntegral = event.GetTripleMaxIntegral();
-    SetObservableValue("TripleMaxIntegral", tripleMaxIntegral);
-
-    Double_t integralRatio = (fullIntegral - thrIntegral) / (fullIntegral + thrIntegral);
-    SetObservableValue("IntegralBalance", integralRatio);
-
-    Double_t maxValue = 0;
-    Double_t minValue = 1.e6;
-    Double_t maxValueIntegral = 0;
-    Double_t minDownValue = 1.e6;
-
-    Double_t minPeakTime = 1000;  // TODO substitute this for something better
-    Double_t maxPeakTime = 0;
-    Double_t peakTimeAverage = 0;
-
-    for (int s = 0; s < event.GetNumberOfSignals(); s++) {
-        TRestRawSignal* sgnl = event.GetSignal(s);
-
-        if (fRangeEnabled && (sgnl->GetID() < fSignalsRange.X() || sgnl->GetID() > fSignalsRange.Y()))
-            continue;
+///////////////////////////////////////////////
+/// \brief It finds the maximum peak bin of all the signals, once per event
+///
+void TRestRawSignalAnalysisProcess::ComputeMaxPeakBins() {
+    if (fMaxPeakBinsDone) return;
+
+    fMaxPeakBins.resize(fEvent.GetNumberOfSignals());
+    for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+        fMaxPeakBins[s] = fEvent.GetSignal(s)->GetMaxPeakBin();
+    }
+    fMaxPeakBinsDone = true;
+}
+
+///////////////////////////////////////////////
+/// \brief It computes, once per event, the peak amplitude and peak time values of the
+/// signals that are over threshold.
+///
+void TRestRawSignalAnalysisProcess::ComputePeakValues() {
+    if (fPeakValuesDone) return;
+
+    ComputePointsOverThreshold();
+    ComputeMaxPeakBins();
+
+    fMaxValue = 0;
+    fMinValue = 1.e6;
+    fMaxValueIntegral = 0;
+    fMinDownValue = 1.e6;
+
+    fMinPeakTime = 1000;  // TODO substitute this for something better
+    fMaxPeakTime = 0;
+    fPeakTimeAverage = 0;
+
+    for (int s = 0; s < fEvent.GetNumberOfSignals(); s++) {
+        if (!IsSignalInRange(s)) continue;
+        TRestRawSignal* sgnl = fEvent.GetSignal(s);
 
         if (sgnl->GetPointsOverThreshold().size() > 1) {
-            Double_t value = event.GetSignal(s)->GetMaxValue();
-            maxValueIntegral += value;
+            Double_t value = sgnl->GetData(fMaxPeakBins[s]);
+            fMaxValueIntegral += value;
 
-            if (value > maxValue) maxValue = value;
-            if (value < minValue) minValue = value;
+            if (value > fMaxValue) fMaxValue = value;
+            if (value < fMinValue) fMinValue = value;
 
-            Double_t peakBin = sgnl->GetMaxPeakBin();
-            peakTimeAverage += peakBin;
+            Double_t peakBin = fMaxPeakBins[s];
+            fPeakTimeAverage += peakBin;
 
-            if (minPeakTime > peakBin) minPeakTime = peakBin;
-            if (maxPeakTime < peakBin) maxPeakTime = peakBin;
+            if (fMinPeakTime > peakBin) fMinPeakTime = peakBin;
+            if (fMaxPeakTime < peakBin) fMaxPeakTime = peakBin;
         }
-        Double_t mindownvalue = event.GetSignal(s)->GetMinValue();
-        if (mindownvalue < minDownValue) {
-            minDownValue = mindownvalue;
+        Double_t mindownvalue = sgnl->GetMinValue();
+        if (mindownvalue < fMinDownValue) {
+            fMinDownValue = mindownvalue;
         }
     }
 
-    if (nGoodSignals > 0) peakTimeAverage /= nGoodSignals;
+    if (fNGoodSignals > 0) fPeakTimeAverage /= fNGoodSignals;
+    fPeakValuesDone = true;
+}
 
-    Double_t ampIntRatio = thrIntegral / maxValueIntegral;
-    if (maxValueIntegral == 0) ampIntRatio = 0;
+///////////////////////////////////////////////
+/// \brief It returns an event value shared by several observables, computing it
+/// only the first time it is requested in the event.
+///
+Double_t TRestRawSignalAnalysisProcess::GetEventValue(EventValue value) {
+    if (fEventValueDone[value]) return fEventValues[value];
+
+    if (value >= kThresholdIntegral) ComputePointsOverThreshold();
+
+    switch (value) {
+        case kBaseLineMean:
+            fEventValues[value] = fEvent.GetBaseLineAverage();
+            break;
+        case kBaseLineSigmaMean:
+            fEventValues[value] = fEvent.GetBaseLineSigmaAverage();
+            break;
+        case kTimeBinsLength:
+            fEventValues[value] = fEvent.GetMaxTime() - fEvent.GetMinTime();
+            break;
+        case kFullIntegral:
+            fEventValues[value] = fEvent.GetIntegral();
+            break;
+        case kThresholdIntegral:
+            fEventValues[value] = fEvent.GetThresholdIntegral();
+            break;
+        case kRiseSlope:
+            fEventValues[value] = fEvent.GetRiseSlope();
+            break;
+        case kSlopeIntegral:
+            fEventValues[value] = fEvent.GetSlopeIntegral();
+            break;
+        default:
+            break;
+    }
+    fEventValueDone[value] = true;
+    return fEventValues[value];
+}
 
-    SetObservableValue("AmplitudeIntegralRatio", ampIntRatio);
-    SetObservableValue("MinPeakAmplitude", minValue);
-    SetObservableValue("MaxPeakAmplitude", maxValue);
-    SetObservableValue("PeakAmplitudeIntegral", maxValueIntegral);
+///////////////////////////////////////////////
+/// \brief It applies the cuts defined on the observables that only need the baseline:
+/// NumberOfSignals, BaseLineMean, BaseLineSigmaMean and TimeBinsLength. It returns true
+/// if the event is rejected, before the points over threshold, integrals and peaks of the
+/// signals are computed. The rest of the cuts are applied by TRestEventProcess::ApplyCut.
+///
+Bool_t TRestRawSignalAnalysisProcess::ApplyEarlyCut() {
+    for (const auto& [cutName, range] : fCuts) {
+        string name = cutName;
+        const string prefix = (string)GetName() + "_";
+        if (name.rfind(prefix, 0) == 0) name = name.substr(prefix.size());
+
+        Double_t value;
+        if (name == "NumberOfSignals") {
+            value = fEvent.GetNumberOfSignals();
+        } else if (name == "BaseLineMean") {
+            value = GetEventValue(kBaseLineMean);
+        } else if (name == "BaseLineSigmaMean") {
+            value = GetEventValue(kBaseLineSigmaMean);
+        } else if (name == "TimeBinsLength") {
+            value = GetEventValue(kTimeBinsLength);
+        } else {
+            continue;
+        }
 
-    SetObservableValue("MinEventValue", minDownValue);
+        if (value < range.X() || value > range.Y()) {
+            RESTDebug << "TRestRawSignalAnalysisProcess: event rejected by the cut on " << name << RESTendl;
+            return true;
+        }
+    }
+    return false;
+}
+
+///////////////////////////////////////////////
+/// \brief The main processing event function. Only the observables that are written
+/// to the analysis tree, or used by a cut, are computed.
+///
+TRestEvent* TRestRawSignalAnalysisProcess::ProcessEvent(TRestEvent* inputEvent) {
+    fInputEvent = dynamic_cast<TRestRawSignalEvent*>(inputEvent);
 
-    Double_t amplitudeRatio = maxValueIntegral / maxValue;
-    if (maxValue == 0) amplitudeRatio = 0;
+    const auto run = GetRunInfo();
+    if (run != nullptr) {
+        fInputEvent->InitializeReferences(run);
+    }
 
-    SetObservableValue("AmplitudeRatio", amplitudeRatio);
-    SetObservableValue("MaxPeakTime", maxPeakTime);
-    SetObservableValue("MinPeakTime", minPeakTime);
+    if (fReadoutMetadata == nullptr) {
+        fReadoutMetadata = fInputEvent->GetReadoutMetadata();
+    }
 
-    Double_t peakTimeDelay = maxPeakTime - minPeakTime;
+    if (fReadoutMetadata == nullptr && !fChannelTypes.empty()) {
+        cerr << "TRestRawSignalAnalysisProcess::ProcessEvent: readout metadata is null, cannot filter "
+                "the process by signal type"
+             << endl;
+        exit(1);
+    }
 
-    SetObservableValue("MaxPeakTimeDelay", peakTimeDelay);
-    SetObservableValue("AveragePeakTime", peakTimeAverage);
+    if (fObservableCalculators.empty()) InitProcess();
+    if (!fObservablesResolved) ResolveObservables();
+
+    if (!fActiveCalculators.empty()) {
+        fEvent = fInputEvent->GetSignalEventForTypes(fChannelTypes, fReadoutMetadata);
+
+        fPointsOverThresholdDone = false;
+        fMaxPeakBinsDone = false;
+        fPeakValuesDone = false;
+        for (auto& done : fEventValueDone) done = false;
+
+        /// We define (or re-define) the baseline range and calculation range of our
+        /// raw-signals.
+        // This will affect the calculation of observables, but not the stored
+        // TRestRawSignal data.
+        fEvent.SetBaseLineRange(fBaseLineRange, fBaseLineOption);
+        fEvent.SetRange(fIntegralRange);
+
+        // Cuts on the cheap observables reject the event before the expensive ones are computed
+        if (ApplyEarlyCut()) return nullptr;
+
+        // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+        // SubstractBaselines
+        // After this the signal gets zero-ed, for the following analysis
+        // Keep in mind, to add raw signal analysis, we must write code at before
+        // This is where most of the problems occur
+        // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+        // Javier: I believe we should not substract baseline in the analysis process
+        // then ...
+        // ... of course we need to consider baseline substraction for each
+        // observable. TRestRawSignal methods
+        // should do that internally. I have updated that to be like that, but we need
+        // to be with open eyes for
+        // some period.
+        // Baseline substraction will always happen when we transfer a TRestRawSignal
+        // to TRestDetectorSignal
+        //
+        // We do not substract baselines then now, as it was done before
+        //
+        // fInputEvent->SubstractBaselines(fBaseLineRange.X(), fBaseLineRange.Y());
+        //
+        // Methods in TRestRawSignal have been updated to consider baseline.
+        // TRestRawSignal now implements that internally. We need to define the
+        // baseline range, and the range
+        // where calculations take place. All we need is to call at some point to the
+        // following methods.
+        //
+        // TRestRawSignalEvent::SetBaseLineRange and TRestRawSignalEvent::SetRange.
+        //
+        // Then, if any method accepts a different range it will be given in the
+        // method name,
+        // for example: GetIntegralInRange( Int_t startBin, Int_t endBin );
+        //
+
+        for (const auto& calculator : fActiveCalculators) calculator();
+    }
 
     if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Debug) {
         for (const auto& i : fObservablesDefined) {
@@ -29,7 +29,12 @@
 /// acts like a step function to select only the positive range of the AGET
 /// function.
 ///
-/// From TRestRawSignal -> TH1 -> Measure goodness of fit
+/// The AGET function convoluted with the gaussian is tabulated once by
+/// TRestRawPulseTemplateBank, and the signals are fitted by least squares
+/// using the interpolated table and its derivatives. The amplitude is fixed
+/// to the maximum of the signal, and the fit range goes from 25 bins before
+/// to 45 bins after the maximum. The maximum number of iterations of each
+/// fit is given by the **maxIterations** parameter, 100 by default.
 ///
 /// Analytic expression to fit:
 ///
@@ -102,6 +107,9 @@
 /// 2020-October First implementation of raw signal convolution fitting process.
 ///              Created from TRestRawSignalAnalysisProcess.
 ///
+/// 2026-October: The TF1Convolution fit is replaced by a fit to a template
+///               bank built at InitProcess.
+///
 /// \class      TRestRawSignalConvolutionFittingProcess
 /// \author     David Diez
 ///
@@ -110,6 +118,10 @@
 
 #include "TRestRawSignalConvolutionFittingProcess.h"
 
+#include <TMath.h>
+
+#include "TRestRawPulseFitter.h"
+
 using namespace std;
 
 ClassImp(TRestRawSignalConvolutionFittingProcess);
@@ -175,10 +187,117 @@ void TRestRawSignalConvolutionFittingProcess::LoadConfig(const string& configFil
 }
 
 ///////////////////////////////////////////////
-/// \brief Process initialization.
+/// \brief Process initialization. The template bank is built here.
 ///
 void TRestRawSignalConvolutionFittingProcess::InitProcess() {
-    // fSignalFittingObservables = TRestEventProcess::ReadObservables();
+    if (!fBank.IsBuilt()) fBank.Build();
+}
+
+///////////////////////////////////////////////
+/// \brief It fills the model for the parameters (shaping time, start
+/// position, gaussian width) in the bins of fData, starting at bin from, and
+/// returns the sum of the squared residuals.
+///
+/// If fJacobian has the size of the fit range times 3, the derivatives are
+/// also computed.
+///
+Double_t TRestRawSignalConvolutionFittingProcess::ComputeModel(const Double_t* par, Double_t amplitude,
+                                                               Int_t from, vector<Double_t>& model) {
+    const Int_t nBins = fData.size();
+    const Double_t tau = par[0];
+    const Double_t sigma = par[2];
+    const Double_t s = sigma / tau;
+
+    // The convolution with the unnormalized gaussian of TF1Convolution
+    const Double_t scale = amplitude * TMath::Sqrt(2 * TMath::Pi()) * sigma;
+    const Bool_t jacobian = &model == &fModel && (Int_t)fJacobian.size() == 3 * nBins;
+
+    Double_t chiSquare = 0;
+    for (int i = 0; i < nBins; i++) {
+        const Double_t u = (from + i - par[1]) / tau;
+        Double_t dGdu, dGds;
+        const Double_t g = fBank.Evaluate(u, s, &dGdu, &dGds);
+
+        model[i] = scale * g;
+        const Double_t residual = fData[i] - model[i];
+        chiSquare += residual * residual;
+
+        if (jacobian) {
+            Double_t* row = &fJacobian[3 * i];
+            row[0] = -scale * (dGdu * u + dGds * s) / tau;
+            row[1] = -scale * dGdu / tau;
+            row[2] = scale * (g / sigma + dGds / tau);
+        }
+    }
+    return chiSquare;
+}
+
+///////////////////////////////////////////////
+/// \brief It fits the pulse in fData with fixed amplitude, starting from the
+/// parameters given, which are updated. It returns the sum of the squared
+/// residuals, and fModel contains the fitted model.
+///
+/// The fit is a Levenberg-Marquardt minimization using the derivatives of
+/// the template bank.
+///
+Double_t TRestRawSignalConvolutionFittingProcess::FitPulse(Double_t amplitude, Int_t from, Double_t* par) {
+    const Int_t nBins = fData.size();
+    fModel.resize(nBins);
+    fTrial.resize(nBins);
+    fJacobian.resize(3 * nBins);
+
+    Double_t chiSquare = ComputeModel(par, amplitude, from, fModel);
+
+    Double_t lambda = 1.e-3;
+    Double_t alpha[3][3], beta[3], matrix[3][3], rhs[3], step[3], trial[3];
+    for (int iteration = 0; iteration < fMaxIterations; iteration++) {
+        for (int p = 0; p < 3; p++) {
+            beta[p] = 0;
+            for (int q = 0; q < 3; q++) alpha[p][q] = 0;
+        }
+        for (int i = 0; i < nBins; i++) {
+            const Double_t* row = &fJacobian[3 * i];
+            const Double_t residual = fData[i] - fModel[i];
+            for (int p = 0; p < 3; p++) {
+                beta[p] += row[p] * residual;
+                for (int q = 0; q < 3; q++) alpha[p][q] += row[p] * row[q];
+            }
+        }
+
+        Bool_t improved = false;
+        Bool_t converged = false;
+        while (!improved && lambda < 1.e10) {
+            for (int p = 0; p < 3; p++) {
+                for (int q = 0; q < 3; q++) matrix[p][q] = alpha[p][q];
+                matrix[p][p] += lambda * (alpha[p][p] > 0 ? alpha[p][p] : 1);
+                rhs[p] = beta[p];
+            }
+
+            if (TRestRawPulseFitter::SolveLinearSystem(&matrix[0][0], rhs, step, 3)) {
+                for (int p = 0; p < 3; p++) trial[p] = par[p] + step[p];
+
+                // The gaussian width must stay inside the template bank
+                if (trial[0] > 0 && trial[2] > 0 && trial[2] <= fBank.GetMaxS() * trial[0]) {
+                    const Double_t trialChiSquare = ComputeModel(trial, amplitude, from, fTrial);
+                    if (trialChiSquare <= chiSquare) {
+                        converged = chiSquare - trialChiSquare <= 1.e-6 * chiSquare;
+                        chiSquare = trialChiSquare;
+                        for (int p = 0; p < 3; p++) par[p] = trial[p];
+                        lambda = max(lambda / 10, 1.e-10);
+                        improved = true;
+                        continue;
+                    }
+                }
+            }
+            lambda *= 10;
+        }
+
+        // The model and jacobian at the new parameters
+        if (improved) chiSquare = ComputeModel(par, amplitude, from, fModel);
+        if (!improved || converged) break;
+    }
+
+    return chiSquare;
 }
 
 ///////////////////////////////////////////////
@@ -191,6 +310,8 @@ TRestEvent* TRestRawSignalConvolutionFittingProcess::ProcessEvent(TRestEvent* in
     RESTDebug << "TRestRawSignalConvolutionFittingProcess::ProcessEvent. Event ID : "
               << fRawSignalEvent->GetID() << RESTendl;
 
+    if (!fBank.IsBuilt()) fBank.Build();
+
     Double_t SigmaMean = 0;
     vector<Double_t> Sigma(fRawSignalEvent->GetNumberOfSignals());
     Double_t RatioSigmaMaxPeakMean = 0;
@@ -203,11 +324,6 @@ TRestEvent* TRestRawSignalConvolutionFittingProcess::ProcessEvent(TRestEvent* in
     map<int, Double_t> peakpositionFit;
     map<int, Double_t> variancegaussFit;
 
-    amplitudeFit.clear();
-    shapingtimeFit.clear();
-    peakpositionFit.clear();
-    variancegaussFit.clear();
-
     int MinBinRange = 25;
     int MaxBinRange = 45;
 
@@ -216,62 +332,32 @@ TRestEvent* TRestRawSignalConvolutionFittingProcess::ProcessEvent(TRestEvent* in
         singleSignal->CalculateBaseLine(20, 150);
         int MaxPeakBin = singleSignal->GetMaxPeakBin();
 
-        // ShaperSin function (AGET theoretical curve) times logistic function
-        TF1* f = new TF1("Aget",
-                         "[0]*TMath::Exp(-3. * (x-[2])/[1]) * (x-[2])/[1] "
-                         "* (x-[2])/[1] * (x-[2])/[1] * "
-                         " sin((x-[2])/[1])/(1+TMath::Exp(-10000*(x-[2])))",
-                         0, 511);
-        f->SetParameters(0., 300., 42., 20.);  // Initial values adjusted from Desmos
-        f->SetParNames("Amplitude", "ShapingTime", "PeakPosition");
-
-        // Gaussian pulse
-        TF1* g = new TF1("pulse", "exp(-0.5*((x)/[0])*((x)/[0]))", 0, 511);
-        g->SetParameters(0, 7.);
-
-        // Convolution of AGET and gaussian functions
-        TF1Convolution* conv = new TF1Convolution("Aget", "pulse", 0, 511, true);
-        conv->SetRange(0, 511);
-        conv->SetNofPointsFFT(10000);
-
-        TF1* fit_conv = new TF1("fit", *conv, 0, 511, conv->GetNpar());
-        fit_conv->SetParNames("Amplitude", "ShapingTime", "PeakPosition", "VarianceGauss");
+        // The fit range, inside the signal
+        const Int_t from = max(0, MaxPeakBin - MinBinRange);
+        const Int_t to = min(singleSignal->GetNumberOfPoints(), MaxPeakBin + MaxBinRange);
+        if (to - from < 3) continue;
 
-        // Create histogram from signal
-        Int_t nBins = singleSignal->GetNumberOfPoints();
-        TH1D* h = new TH1D("histo", "Signal to histo", nBins, 0, nBins);
+        fData.resize(to - from);
+        for (int i = from; i < to; i++) fData[i - from] = singleSignal->GetData(i);
 
-        for (int i = 0; i < nBins; i++) {
-            h->Fill(i, singleSignal->GetRawData(i) - singleSignal->GetBaseLine());
-            h->SetBinError(i, singleSignal->GetBaseLineSigma());
-        }
-
-        // Fit histogram with convolution
-        fit_conv->SetParameters(singleSignal->GetData(MaxPeakBin), 25., MaxPeakBin - 25., 8.);
-        fit_conv->FixParameter(0, singleSignal->GetData(MaxPeakBin));
-
-        h->Fit(fit_conv, "LRNQ", "", MaxPeakBin - MinBinRange, MaxPeakBin + MaxBinRange);
-        // Options: L->Likelihood minimization, R->fit in range, N->No draw,
-        // Q->Quiet
+        // The amplitude is fixed to the signal maximum. Shaping time, start position and gaussian width.
+        const Double_t amplitude = singleSignal->GetData(MaxPeakBin);
+        Double_t par[3] = {25., MaxPeakBin - 25., 8.};
+        const Double_t residuals = FitPulse(amplitude, from, par);
 
-        Double_t sigma = 0;
-        for (int j = MaxPeakBin - MinBinRange; j < MaxPeakBin + MaxBinRange; j++) {
-            sigma += (singleSignal->GetData(j) - fit_conv->Eval(j)) *
-                     (singleSignal->GetData(j) - fit_conv->Eval(j));
-        }
-        Sigma[s] = TMath::Sqrt(sigma / (MinBinRange + MaxBinRange));
-        RatioSigmaMaxPeak[s] = Sigma[s] / singleSignal->GetData(MaxPeakBin);
+        Sigma[s] = TMath::Sqrt(residuals / (to - from));
+        RatioSigmaMaxPeak[s] = Sigma[s] / amplitude;
         RatioSigmaMaxPeakMean += RatioSigmaMaxPeak[s];
         SigmaMean += Sigma[s];
-        ChiSquare[s] = fit_conv->GetChisquare();
-        ChiSquareMean += ChiSquare[s];
 
-        amplitudeFit[singleSignal->GetID()] = fit_conv->GetParameter(0);
-        shapingtimeFit[singleSignal->GetID()] = fit_conv->GetParameter(1);
-        peakpositionFit[singleSignal->GetID()] = fit_conv->GetParameter(2);
-        variancegaussFit[singleSignal->GetID()] = fit_conv->GetParameter(3);
+        const Double_t baseLineSigma = singleSignal->GetBaseLineSigma();
+        ChiSquare[s] = baseLineSigma > 0 ? residuals / (baseLineSigma * baseLineSigma) : residuals;
+        ChiSquareMean += ChiSquare[s];
 
-        h->Delete();
+        amplitudeFit[singleSignal->GetID()] = amplitude;
+        shapingtimeFit[singleSignal->GetID()] = par[0];
+        peakpositionFit[singleSignal->GetID()] = par[1];
+        variancegaussFit[singleSignal->GetID()] = par[2];
     }
 
     //////////// Fitted parameters Map Observables /////////////
@@ -357,6 +443,8 @@ void TRestRawSignalConvolutionFittingProcess::EndProcess() {
 /// \brief Function to read input parameters.
 ///
 void TRestRawSignalConvolutionFittingProcess::InitFromConfigFile() {
+    fMaxIterations = StringToInteger(GetParameter("maxIterations", fMaxIterations));
+
     /* Parameters to initialize from RML
   fBaseLineRange = StringTo2DVector(GetParameter("baseLineRange", "(5,55)"));
   fIntegralRange = StringTo2DVector(GetParameter("integralRange", "(10,500)"));
@@ -0,0 +1,330 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+/// The TRestRawSignalDeconvolutionProcess removes the detector response from
+/// the signals of a TRestRawSignalEvent, so that the output signals describe
+/// the time profile of the charge arriving to each channel. It is a cheap
+/// alternative to fitting the signals, i.e. TRestRawSignalFittingProcess,
+/// when only the time and amplitude of the pulses are needed.
+///
+/// The response R is normalized to unit integral, and each signal is
+/// transformed by the Wiener filter
+///
+/// \f$ G(f) = \frac{R^*(f)}{|R(f)|^2 + \lambda \max|R|^2} \f$
+///
+/// where \f$\lambda\f$ is the regularization. The filter is computed only
+/// once for each signal length, so that the cost per signal is two FFTs and
+/// one complex multiplication per frequency node. The integral of the output
+/// signal is the integral of the input signal divided by \f$1+\lambda\f$. A
+/// small regularization gives narrower pulses but amplifies the noise.
+///
+/// The following parameters are available:
+///
+/// * **responseType**: The response to be removed.
+///     - responseFile : The response is read from responseFile.
+///     - gaus, exponential, shaper, shaperSin : The analytical responses of
+///       TRestRawSignalShapingProcess, using shapingTime and shapingOrder.
+///       shaperSin is the default.
+/// * **shapingTime**: The shaping time of the analytical responses, in
+/// samples. By default 10.
+/// * **shapingOrder**: The order of the shaper response. By default 3.
+/// * **responseFile**: An ASCII file with one response sample per line. The
+/// lines starting by # are ignored. It may be produced averaging the output
+/// of TRestRawFindResponseSignalProcess.
+/// * **responseStart**: The sample where the response starts inside the
+/// response file, i.e. the time of the charge. By default 0.
+/// * **regularization**: The value \f$\lambda\f$ of the Wiener filter. By
+/// default 0.01.
+/// * **deconvolutionGain**: A factor to amplify or attenuate the output
+/// signal. By default 1.
+///
+/// \code
+/// <addProcess type="TRestRawSignalDeconvolutionProcess" name="deconvolution" value="ON">
+///     <parameter name="responseType" value="responseFile" />
+///     <parameter name="responseFile" value="response.txt" />
+///     <parameter name="responseStart" value="140" />
+///     <parameter name="regularization" value="0.005" />
+/// </addProcess>
+/// \endcode
+///
+/// The baseline of the input signal, if defined, is subtracted before the
+/// deconvolution and it is added back to the output signal.
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: First implementation of TRestRawSignalDeconvolutionProcess.
+///
+/// \class      TRestRawSignalDeconvolutionProcess
+///
+/// <hr>
+///
+#include "TRestRawSignalDeconvolutionProcess.h"
+
+#include <fstream>
+#include <limits>
+
+#include "TRestRawSignalShapingProcess.h"
+
+using namespace std;
+
+ClassImp(TRestRawSignalDeconvolutionProcess);
+
+///////////////////////////////////////////////
+/// \brief Default constructor
+///
+TRestRawSignalDeconvolutionProcess::TRestRawSignalDeconvolutionProcess() { Initialize(); }
+
+///////////////////////////////////////////////
+/// \brief Constructor loading data from a config file
+///
+/// If no configuration path is defined using TRestMetadata::SetConfigFilePath
+/// the path to the config file must be specified using full path, absolute or
+/// relative.
+///
+/// The default behaviour is that the config file must be specified with
+/// full path, absolute or relative.
+///
+/// \param configFilename A const char* giving the path to an RML file.
+///
+TRestRawSignalDeconvolutionProcess::TRestRawSignalDeconvolutionProcess(const char* configFilename) {
+    Initialize();
+
+    if (LoadConfigFromFile(configFilename) == -1) {
+        LoadDefaultConfig();
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief Default destructor
+///
+TRestRawSignalDeconvolutionProcess::~TRestRawSignalDeconvolutionProcess() { delete fOutputEvent; }
+
+///////////////////////////////////////////////
+/// \brief Function to load the default config in absence of RML input
+///
+void TRestRawSignalDeconvolutionProcess::LoadDefaultConfig() {
+    SetName("deconvolution-Default");
+    SetTitle("Default config");
+}
+
+///////////////////////////////////////////////
+/// \brief Function to initialize input/output event members and define the
+/// section name
+///
+void TRestRawSignalDeconvolutionProcess::Initialize() {
+    SetSectionName(this->ClassName());
+    SetLibraryVersion(LIBRARY_VERSION);
+
+    fInputEvent = nullptr;
+    fOutputEvent = new TRestRawSignalEvent();
+}
+
+///////////////////////////////////////////////
+/// \brief Function to load the configuration from an external configuration
+/// file.
+///
+/// If no configuration path is defined in TRestMetadata::SetConfigFilePath
+/// the path to the config file must be specified using full path, absolute or
+/// relative.
+///
+/// \param configFilename A const char* giving the path to an RML file.
+/// \param name The name of the specific metadata. It will be used to find the
+/// corresponding TRestRawSignalDeconvolutionProcess section inside the RML.
+///
+void TRestRawSignalDeconvolutionProcess::LoadConfig(const string& configFilename, const string& name) {
+    if (LoadConfigFromFile(configFilename, name) == -1) {
+        LoadDefaultConfig();
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief Function reading input parameters from the RML
+/// TRestRawSignalDeconvolutionProcess section
+///
+void TRestRawSignalDeconvolutionProcess::InitFromConfigFile() {
+    fResponseType = GetParameter("responseType", fResponseType);
+    fShapingTime = StringToDouble(GetParameter("shapingTime", fShapingTime));
+    fShapingOrder = StringToInteger(GetParameter("shapingOrder", fShapingOrder));
+    fResponseFile = GetParameter("responseFile", fResponseFile);
+    fResponseStart = StringToInteger(GetParameter("responseStart", fResponseStart));
+    fRegularization = StringToDouble(GetParameter("regularization", fRegularization));
+    fDeconvolutionGain = StringToDouble(GetParameter("deconvolutionGain", fDeconvolutionGain));
+}
+
+///////////////////////////////////////////////
+/// \brief Process initialization. The response is built here, and the
+/// filters computed in previous runs are removed.
+///
+void TRestRawSignalDeconvolutionProcess::InitProcess() {
+    BuildResponse();
+    fFilter.clear();
+
+    if (fRegularization <= 0) {
+        RESTWarning << "The regularization must be positive. Using 0.01." << RESTendl;
+        fRegularization = 0.01;
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief It builds the response, normalized to unit integral. The response
+/// is left empty if it cannot be built.
+///
+void TRestRawSignalDeconvolutionProcess::BuildResponse() {
+    fResponse.clear();
+    fResponseOffset = 0;
+
+    if (fResponseType == "responseFile") {
+        ifstream file(fResponseFile);
+        if (!file) {
+            RESTWarning << "Response file : " << fResponseFile << " not found" << RESTendl;
+            return;
+        }
+
+        Int_t sample = 0;
+        string line;
+        while (getline(file, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            if (sample++ < fResponseStart) continue;
+            fResponse.push_back(StringToDouble(line));
+        }
+    } else {
+        // The analytical responses are the ones used to shape the signals
+        TRestRawSignalShapingProcess shaping;
+        shaping.SetShapingType(fResponseType);
+        shaping.SetShapingTime(fShapingTime);
+        shaping.SetShapingOrder(fShapingOrder);
+        shaping.SetShapingGain(1);
+        shaping.SetShapingEngine("direct");
+        shaping.InitProcess();
+
+        fResponse = shaping.GetResponse();
+        fResponseOffset = shaping.GetResponseOffset();
+    }
+
+    Double_t sum = 0;
+    for (const auto& value : fResponse) sum += value;
+    if (sum == 0) {
+        RESTWarning << "Response type : " << fResponseType << " could not be built!!" << RESTendl;
+        fResponse.clear();
+        return;
+    }
+    for (auto& value : fResponse) value /= sum;
+}
+
+///////////////////////////////////////////////
+/// \brief It returns the Wiener filter for the given FFT size, computing it
+/// the first time.
+///
+/// The response is placed circularly, so that the response offset is at
+/// time 0. Responses longer than the FFT size are truncated.
+///
+const vector<complex<Double_t>>& TRestRawSignalDeconvolutionProcess::GetFilter(Int_t nfft) {
+    auto it = fFilter.find(nfft);
+    if (it != fFilter.end()) return it->second;
+
+    vector<Double_t> response(nfft, 0);
+    for (int i = 0; i < (Int_t)fResponse.size(); i++) {
+        const Int_t bin = i - fResponseOffset;
+        if (bin >= nfft || bin < -nfft) continue;
+        response[bin >= 0 ? bin : bin + nfft] += fResponse[i];
+    }
+
+    TRestRawFFT fft;
+    fft.ForwardFFT(response, nfft);
+    const complex<Double_t>* spectrum = fft.GetFrequency();
+
+    Double_t maxPower = 0;
+    for (int k = 0; k <= nfft / 2; k++) maxPower = max(maxPower, norm(spectrum[k]));
+
+    vector<complex<Double_t>>& filter = fFilter[nfft];
+    filter.resize(nfft / 2 + 1);
+    for (int k = 0; k <= nfft / 2; k++)
+        filter[k] = fDeconvolutionGain * conj(spectrum[k]) / (norm(spectrum[k]) + fRegularization * maxPower);
+
+    return filter;
+}
+
+///////////////////////////////////////////////
+/// \brief The main processing event function
+///
+TRestEvent* TRestRawSignalDeconvolutionProcess::ProcessEvent(TRestEvent* inputEvent) {
+    fInputEvent = (TRestRawSignalEvent*)inputEvent;
+
+    if (fResponse.empty()) {
+        RESTWarning << "Response type : " << fResponseType << " is not defined!!" << RESTendl;
+        return nullptr;
+    }
+
+    const Double_t low = numeric_limits<Short_t>::min();
+    const Double_t high = numeric_limits<Short_t>::max();
+
+    for (int n = 0; n < fInputEvent->GetNumberOfSignals(); n++) {
+        TRestRawSignal* signal = fInputEvent->GetSignal(n);
+        const Int_t nBins = signal->GetNumberOfPoints();
+
+        // Signals with an existing ID are not added
+        const Int_t nOutput = fOutputEvent->GetNumberOfSignals();
+        fOutputEvent->AddSignal(*signal);
+        if (fOutputEvent->GetNumberOfSignals() == nOutput || nBins < 2) continue;
+
+        const complex<Double_t>* filter = GetFilter(nBins).data();
+
+        fFFT.ForwardSignalFFT(signal);
+        complex<Double_t>* frequency = fFFT.GetFrequency();
+        for (int k = 0; k <= nBins / 2; k++) frequency[k] *= filter[k];
+        fFFT.BackwardFFT();
+
+        const Double_t baseLine = signal->GetBaseLine();
+        Short_t* data = fOutputEvent->GetSignal(nOutput)->GetSignalData();
+        for (int i = 0; i < nBins; i++) {
+            const Double_t value = round(fFFT.GetTimeAmplitude(i) + baseLine);
+            data[i] = (Short_t)min(max(value, low), high);
+        }
+    }
+
+    return fOutputEvent;
+}
+
+///////////////////////////////////////////////
+/// \brief It prints out the process parameters stored in the metadata structure
+///
+void TRestRawSignalDeconvolutionProcess::PrintMetadata() {
+    BeginPrintProcess();
+
+    RESTMetadata << "Response type : " << fResponseType << RESTendl;
+    if (fResponseType == "responseFile") {
+        RESTMetadata << "Response file : " << fResponseFile << RESTendl;
+        RESTMetadata << "Response start : " << fResponseStart << RESTendl;
+    } else {
+        RESTMetadata << "Shaping time : " << fShapingTime << RESTendl;
+        if (fResponseType == "shaper") RESTMetadata << "Shaping order : " << fShapingOrder << RESTendl;
+    }
+    RESTMetadata << "Regularization : " << fRegularization << RESTendl;
+    RESTMetadata << "Deconvolution gain : " << fDeconvolutionGain << RESTendl;
+
+    EndPrintProcess();
+}
@@ -0,0 +1,321 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+/// The TRestRawSignalFFTFilterProcess filters all the signals of a
+/// TRestRawSignalEvent in the frequency domain. Each signal is transformed
+/// using TRestRawFFT, its spectrum is multiplied by the filter transfer
+/// function, and it is transformed back.
+///
+/// All the frequencies are given in units of the sampling frequency, so that
+/// they range from 0 to 0.5 (the Nyquist frequency). For example, with a
+/// sampling time of 40ns, a 1MHz pickup line is found at 0.04.
+///
+/// The following parameters are available:
+///
+/// * **filterType**: The filter applied to the signals.
+///     - lowPass : All frequencies above cutFrequency are removed.
+///     - butterworth : A butterworth low pass filter of the given order,
+///       1/sqrt(1+(f/cutFrequency)^(2 order)). This is the default.
+///     - none : Only the notch filters are applied.
+/// * **cutFrequency**: The cut frequency of the low pass filters. By
+/// default 0.1.
+/// * **order**: The order of the butterworth filter. By default 2.
+/// * **filterThreads**: The number of threads used to filter the signals of
+/// one event. By default 1.
+///
+/// Notch filters removing a band of frequencies around known pickup lines
+/// are added with the `notch` key, using the central frequency and the full
+/// width of the band.
+///
+/// \code
+/// <addProcess type="TRestRawSignalFFTFilterProcess" name="fftFilter" value="ON">
+///     <parameter name="filterType" value="butterworth" />
+///     <parameter name="cutFrequency" value="0.08" />
+///     <parameter name="order" value="4" />
+///     <notch frequency="0.04" width="0.004" />
+/// </addProcess>
+/// \endcode
+///
+/// The transfer function is computed only once for each signal length, and
+/// the FFT plans are reused by TRestRawFFT, so that the cost per signal is
+/// two transforms and one multiplication per frequency node.
+///
+/// The time signal is obtained from TRestRawSignal::GetData, so that the
+/// baseline, if defined, is subtracted before filtering and it is added
+/// back to the output signal.
+///
+/// The filter threads are a TRestRawWorkerPool created at InitProcess. If the
+/// process is used without InitProcess, the pool is created at the first
+/// event.
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: First implementation of TRestRawSignalFFTFilterProcess.
+///
+/// \class      TRestRawSignalFFTFilterProcess
+///
+/// <hr>
+///
+#include "TRestRawSignalFFTFilterProcess.h"
+
+#include <limits>
+
+using namespace std;
+
+ClassImp(TRestRawSignalFFTFilterProcess);
+
+///////////////////////////////////////////////
+/// \brief Default constructor
+///
+TRestRawSignalFFTFilterProcess::TRestRawSignalFFTFilterProcess() { Initialize(); }
+
+///////////////////////////////////////////////
+/// \brief Constructor loading data from a config file
+///
+/// If no configuration path is defined using TRestMetadata::SetConfigFilePath
+/// the path to the config file must be specified using full path, absolute or
+/// relative.
+///
+/// The default behaviour is that the config file must be specified with
+/// full path, absolute or relative.
+///
+/// \param configFilename A const char* giving the path to an RML file.
+///
+TRestRawSignalFFTFilterProcess::TRestRawSignalFFTFilterProcess(const char* configFilename) {
+    Initialize();
+
+    if (LoadConfigFromFile(configFilename) == -1) {
+        LoadDefaultConfig();
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief Default destructor
+///
+TRestRawSignalFFTFilterProcess::~TRestRawSignalFFTFilterProcess() {
+    delete fOutputEvent;
+    delete fWorkers;
+}
+
+///////////////////////////////////////////////
+/// \brief Function to load the default config in absence of RML input
+///
+void TRestRawSignalFFTFilterProcess::LoadDefaultConfig() {
+    SetName("fftFilter-Default");
+    SetTitle("Default config");
+}
+
+///////////////////////////////////////////////
+/// \brief Function to initialize input/output event members and define the
+/// section name
+///
+void TRestRawSignalFFTFilterProcess::Initialize() {
+    SetSectionName(this->ClassName());
+    SetLibraryVersion(LIBRARY_VERSION);
+
+    fInputEvent = nullptr;
+    fOutputEvent = new TRestRawSignalEvent();
+}
+
+///////////////////////////////////////////////
+/// \brief Function to load the configuration from an external configuration
+/// file.
+///
+/// If no configuration path is defined in TRestMetadata::SetConfigFilePath
+/// the path to the config file must be specified using full path, absolute or
+/// relative.
+///
+/// \param configFilename A const char* giving the path to an RML file.
+/// \param name The name of the specific metadata. It will be used to find the
+/// corresponding TRestRawSignalFFTFilterProcess section inside the RML.
+///
+void TRestRawSignalFFTFilterProcess::LoadConfig(const string& configFilename, const string& name) {
+    if (LoadConfigFromFile(configFilename, name) == -1) {
+        LoadDefaultConfig();
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief Function reading input parameters from the RML
+/// TRestRawSignalFFTFilterProcess section
+///
+void TRestRawSignalFFTFilterProcess::InitFromConfigFile() {
+    fFilterType = GetParameter("filterType", fFilterType);
+    fCutFrequency = StringToDouble(GetParameter("cutFrequency", fCutFrequency));
+    fOrder = StringToInteger(GetParameter("order", fOrder));
+    fFilterThreads = StringToInteger(GetParameter("filterThreads", fFilterThreads));
+
+    size_t pos = 0;
+    string notchDefinition;
+    while (!(notchDefinition = GetKEYDefinition("notch", pos)).empty()) {
+        Double_t frequency = StringToDouble(GetFieldValue("frequency", notchDefinition));
+        Double_t width = StringToDouble(GetFieldValue("width", notchDefinition));
+        if (frequency <= 0 || width <= 0) {
+            RESTWarning << "Notch filter needs positive frequency and width. Skipping it." << RESTendl;
+            continue;
+        }
+        fNotches.emplace_back(frequency, width);
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief Process initialization. The filter threads are started here.
+///
+void TRestRawSignalFFTFilterProcess::InitProcess() {
+    if (fFilterType != "lowPass" && fFilterType != "butterworth" && fFilterType != "none") {
+        RESTWarning << "Filter type : " << fFilterType << " is not defined. Using none." << RESTendl;
+        fFilterType = "none";
+    }
+
+    fTransfer.clear();
+
+    StartWorkers();
+}
+
+///////////////////////////////////////////////
+/// \brief It (re)creates the filter threads and the FFT objects of each thread
+///
+void TRestRawSignalFFTFilterProcess::StartWorkers() {
+    delete fWorkers;
+    fWorkers = new TRestRawWorkerPool(max(fFilterThreads, 1));
+    fFFT.resize(fWorkers->GetNumberOfThreads());
+}
+
+///////////////////////////////////////////////
+/// \brief It returns the transfer function for the given FFT size, computing
+/// it the first time.
+///
+const vector<Double_t>& TRestRawSignalFFTFilterProcess::GetTransfer(Int_t nfft) {
+    auto it = fTransfer.find(nfft);
+    if (it != fTransfer.end()) return it->second;
+
+    vector<Double_t>& transfer = fTransfer[nfft];
+    transfer.resize(nfft / 2 + 1);
+    for (int k = 0; k <= nfft / 2; k++) {
+        const Double_t frequency = (Double_t)k / nfft;
+
+        Double_t gain = 1;
+        if (fFilterType == "lowPass") {
+            if (frequency > fCutFrequency) gain = 0;
+        } else if (fFilterType == "butterworth") {
+            gain = 1. / sqrt(1 + pow(frequency / fCutFrequency, 2 * fOrder));
+        }
+
+        for (const auto& notch : fNotches)
+            if (abs(frequency - notch.X()) <= notch.Y() / 2) gain = 0;
+
+        transfer[k] = gain;
+    }
+    return transfer;
+}
+
+///////////////////////////////////////////////
+/// \brief It filters the input signal and writes the result in the data of
+/// the output signal, which must have the same number of points.
+///
+/// The baseline of the input signal is subtracted before filtering and it is
+/// added back to the result.
+///
+void TRestRawSignalFFTFilterProcess::FilterSignal(TRestRawSignal* input, TRestRawSignal* output,
+                                                  TRestRawFFT& fft) {
+    const Int_t nBins = input->GetNumberOfPoints();
+    if (nBins < 2) return;
+
+    fft.ForwardSignalFFT(input);
+
+    const Double_t* transfer = fTransfer.at(nBins).data();
+    complex<Double_t>* frequency = fft.GetFrequency();
+    for (int k = 0; k <= nBins / 2; k++) frequency[k] *= transfer[k];
+
+    fft.BackwardFFT();
+
+    const Double_t baseLine = input->GetBaseLine();
+    const Double_t low = numeric_limits<Short_t>::min();
+    const Double_t high = numeric_limits<Short_t>::max();
+    Short_t* data = output->GetSignalData();
+    for (int i = 0; i < nBins; i++) {
+        const Double_t value = round(fft.GetTimeAmplitude(i) + baseLine);
+        data[i] = (Short_t)min(max(value, low), high);
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief The main processing event function
+///
+TRestEvent* TRestRawSignalFFTFilterProcess::ProcessEvent(TRestEvent* inputEvent) {
+    fInputEvent = (TRestRawSignalEvent*)inputEvent;
+
+    const Int_t nSignals = fInputEvent->GetNumberOfSignals();
+    for (int n = 0; n < nSignals; n++) {
+        TRestRawSignal* signal = fInputEvent->GetSignal(n);
+        fOutputEvent->AddSignal(*signal);
+
+        // The transfer functions are prepared before the threads start
+        if (signal->GetNumberOfPoints() >= 2) GetTransfer(signal->GetNumberOfPoints());
+    }
+
+    // Signals with an existing ID are not added by TRestRawSignalEvent::AddSignal
+    if (fOutputEvent->GetNumberOfSignals() != nSignals) {
+        RESTWarning << "TRestRawSignalFFTFilterProcess. Duplicated signal IDs in event "
+                    << fInputEvent->GetID() << ". The event is not filtered." << RESTendl;
+        return fOutputEvent;
+    }
+
+    // The threads are stopped at EndProcess, and they are not started if InitProcess was not called
+    if (fWorkers == nullptr) StartWorkers();
+
+    fWorkers->ForEach(nSignals, [&](Int_t n, Int_t thread) {
+        FilterSignal(fInputEvent->GetSignal(n), fOutputEvent->GetSignal(n), fFFT[thread]);
+    });
+
+    return fOutputEvent;
+}
+
+///////////////////////////////////////////////
+/// \brief Function to include required actions after all events have been
+/// processed. The filter threads are stopped here.
+///
+void TRestRawSignalFFTFilterProcess::EndProcess() {
+    delete fWorkers;
+    fWorkers = nullptr;
+}
+
+///////////////////////////////////////////////
+/// \brief It prints out the process parameters stored in the metadata structure
+///
+void TRestRawSignalFFTFilterProcess::PrintMetadata() {
+    BeginPrintProcess();
+
+    RESTMetadata << "Filter type : " << fFilterType << RESTendl;
+    if (fFilterType != "none") RESTMetadata << "Cut frequency : " << fCutFrequency << RESTendl;
+    if (fFilterType == "butterworth") RESTMetadata << "Order : " << fOrder << RESTendl;
+    for (const auto& notch : fNotches)
+        RESTMetadata << "Notch : frequency " << notch.X() << " width " << notch.Y() << RESTendl;
+    RESTMetadata << "Filter threads : " << fFilterThreads << RESTendl;
+
+    EndPrintProcess();
+}
@@ -27,7 +27,9 @@
 /// to select only the positive range of the AGET function.
 /// Working with raw signal (without subtracting baseline).
 ///
-/// From TRestRawSignal -> TH1 -> Measure goodness of fit
+/// The fit is performed by TRestRawPulseFitter, a Levenberg-Marquardt fitter
+/// using analytical derivatives that works directly on the signal data, where
+/// the logistic function is replaced by a step.
 ///
 /// Analytic expression to fit:
 ///
@@ -45,6 +47,15 @@
 ///
 /// ![Example of fitted pulse](Fit600.png)
 ///
+/// ### Parameters
+///
+/// * **fitThreads**: The number of threads used to fit the signals of one
+/// event. By default 1. The threads are created at InitProcess and kept
+/// until EndProcess.
+///
+/// * **maxIterations**: The maximum number of iterations of each fit. By
+/// default 100. It must be positive.
+///
 /// ### Observables
 ///
 /// * **FitBaseline_map**: For each pulse, save first fit's parameter.
@@ -91,6 +102,9 @@
 /// 2020-August First implementation of raw signal fitting process.
 ///                Created from TRestRawSignalAnalysisProcess.
 ///
+/// 2026-October: The TF1 fit is replaced by TRestRawPulseFitter, and signals
+///               may be fitted in parallel.
+///
 /// \class      TRestRawSignalFittingProcess
 /// \author     David Diez
 ///
@@ -98,6 +112,8 @@
 ///
 #include "TRestRawSignalFittingProcess.h"
 
+#include <TMath.h>
+
 using namespace std;
 
 ClassImp(TRestRawSignalFittingProcess);
@@ -128,7 +144,7 @@ TRestRawSignalFittingProcess::TRestRawSignalFittingProcess(const char* configFil
 ///////////////////////////////////////////////
 /// \brief Default destructor
 ///
-TRestRawSignalFittingProcess::~TRestRawSignalFittingProcess() {}
+TRestRawSignalFittingProcess::~TRestRawSignalFittingProcess() { delete fWorkers; }
 
 ///////////////////////////////////////////////
 /// \brief Function to load the default config in absence of RML input
@@ -163,10 +179,62 @@ void TRestRawSignalFittingProcess::LoadConfig(const string& configFilename, cons
 }
 
 ///////////////////////////////////////////////
-/// \brief Process initialization.
+/// \brief Process initialization. It checks the parameters and starts the fit threads.
 ///
 void TRestRawSignalFittingProcess::InitProcess() {
-    // fSignalFittingObservables = TRestEventProcess::ReadObservables();
+    if (fFitThreads < 1) {
+        RESTWarning << "Fit threads : " << fFitThreads << " is not valid. Using 1." << RESTendl;
+        fFitThreads = 1;
+    }
+
+    if (fMaxIterations <= 0) {
+        RESTWarning << "Max iterations : " << fMaxIterations << " is not valid. Using 100." << RESTendl;
+        fMaxIterations = 100;
+    }
+
+    StartWorkers();
+}
+
+///////////////////////////////////////////////
+/// \brief It (re)creates the fit threads, and one fitter for each thread
+///
+void TRestRawSignalFittingProcess::StartWorkers() {
+    delete fWorkers;
+    fWorkers = new TRestRawWorkerPool(max(fFitThreads, 1));
+
+    fFitters.assign(fWorkers->GetNumberOfThreads(), TRestRawPulseFitter());
+    for (auto& fitter : fFitters) fitter.SetMaxIterations(fMaxIterations);
+}
+
+///////////////////////////////////////////////
+/// \brief It fits the signal with index s, and stores the fit results in
+/// the position s of the result vectors.
+///
+/// It may be called from several threads, so that it does not print anything.
+///
+void TRestRawSignalFittingProcess::FitSignal(Int_t s, TRestRawPulseFitter& fitter) {
+    TRestRawSignal* singleSignal = fRawSignalEvent->GetSignal(s);
+    const Int_t nBins = singleSignal->GetNumberOfPoints();
+
+    fFitConverged[s] = fitter.Fit(singleSignal);
+
+    for (int p = 0; p < TRestRawPulseFitter::kNParameters; p++) fFitParameters[s][p] = fitter.GetParameter(p);
+    fFitChiSquare[s] = fitter.GetChiSquare();
+
+    // The residuals around the maximum of the signal
+    if (nBins < TRestRawPulseFitter::kNParameters) {
+        fFitSigma[s] = 0;
+        return;
+    }
+    const Int_t maxPeakBin = singleSignal->GetMaxPeakBin();
+    const Int_t from = max(0, maxPeakBin - 145);
+    const Int_t to = min(nBins, maxPeakBin + 165);
+    Double_t sigma = 0;
+    for (int j = from; j < to; j++) {
+        const Double_t residual = singleSignal->GetRawData(j) - fitter.GetModel(j);
+        sigma += residual * residual;
+    }
+    fFitSigma[s] = to > from ? TMath::Sqrt(sigma / (to - from)) : 0;
 }
 
 ///////////////////////////////////////////////
@@ -179,78 +247,53 @@ TRestEvent* TRestRawSignalFittingProcess::ProcessEvent(TRestEvent* inputEvent) {
     RESTDebug << "TRestRawSignalFittingProcess::ProcessEvent. Event ID : " << fRawSignalEvent->GetID()
               << RESTendl;
 
+    // The threads are stopped at EndProcess, and they are not started if InitProcess was not called
+    if (fWorkers == nullptr) StartWorkers();
+
+    const Int_t nSignals = fRawSignalEvent->GetNumberOfSignals();
+    fFitParameters.resize(nSignals);
+    fFitChiSquare.resize(nSignals);
+    fFitSigma.resize(nSignals);
+    fFitConverged.resize(nSignals);
+
+    fWorkers->ForEach(nSignals, [&](Int_t s, Int_t thread) { FitSignal(s, fFitters[thread]); });
+
+    for (int s = 0; s < nSignals; s++) {
+        if (!fFitConverged[s])
+            RESTDebug << "Fit of signal " << fRawSignalEvent->GetSignal(s)->GetID() << " did not converge"
+                      << RESTendl;
+    }
+
     Double_t SigmaMean = 0;
-    vector<Double_t> Sigma(fRawSignalEvent->GetNumberOfSignals());
+    vector<Double_t>& Sigma = fFitSigma;
     Double_t RatioSigmaMaxPeakMean = 0;
-    vector<Double_t> RatioSigmaMaxPeak(fRawSignalEvent->GetNumberOfSignals());
+    vector<Double_t> RatioSigmaMaxPeak(nSignals);
     Double_t ChiSquareMean = 0;
-    vector<Double_t> ChiSquare(fRawSignalEvent->GetNumberOfSignals());
+    vector<Double_t>& ChiSquare = fFitChiSquare;
 
     map<int, Double_t> baselineFit;
     map<int, Double_t> amplitudeFit;
     map<int, Double_t> shapingTimeFit;
     map<int, Double_t> peakPositionFit;
 
-    baselineFit.clear();
-    amplitudeFit.clear();
-    shapingTimeFit.clear();
-    peakPositionFit.clear();
-
-    for (int s = 0; s < fRawSignalEvent->GetNumberOfSignals(); s++) {
+    for (int s = 0; s < nSignals; s++) {
         TRestRawSignal* singleSignal = fRawSignalEvent->GetSignal(s);
+        const auto& parameters = fFitParameters[s];
 
-        int MaxPeakBin = singleSignal->GetMaxPeakBin();
-
-        // ShaperSin function (AGET theoretic curve) times logistic function
-        TF1* f = new TF1("fit",
-                         "[0]+[1]*TMath::Exp(-3. * (x-[3])/[2]) * "
-                         "(x-[3])/[2] * (x-[3])/[2] * (x-[3])/[2] * "
-                         "sin((x-[3])/[2])/(1+TMath::Exp(-10000*(x-[3])))",
-                         0, 511);
-        f->SetParameters(0, 2000, 70, 80);
-        // f->SetParameters(0, 0);  // Initial values adjusted from Desmos
-        // f->SetParLimits(0, 150, 350);
-        // f->SetParameters(1, 2000);
-        // f->SetParLimits(1, 30, 90000);
-        // f->SetParameters(2, 70);
-        // f->SetParLimits(2, 10, 80);
-        // f->SetParameters(3, 80);
-        // f->SetParLimits(3, 150, 250);
-        f->SetParNames("Baseline", "Amplitude", "ShapingTime", "PeakPosition");
-
-        // Create histogram from signal
-        Int_t nBins = singleSignal->GetNumberOfPoints();
-        TH1D* h = new TH1D("histo", "Signal to histo", nBins, 0, nBins);
-
-        for (int i = 0; i < nBins; i++) {
-            h->Fill(i, singleSignal->GetRawData(i));
-        }
-
-        // Fit histogram with ShaperSin
-        h->Fit(f, "NWW", "", 0, 511);  // Options: R->fit in range, N->No draw, Q->Quiet
-
-        Double_t sigma = 0;
-        for (int j = MaxPeakBin - 145; j < MaxPeakBin + 165; j++) {
-            sigma += (singleSignal->GetRawData(j) - f->Eval(j)) * (singleSignal->GetRawData(j) - f->Eval(j));
-        }
-        Sigma[s] = TMath::Sqrt(sigma / (145 + 165));
-        RatioSigmaMaxPeak[s] = Sigma[s] / singleSignal->GetRawData(MaxPeakBin);
+        RatioSigmaMaxPeak[s] = Sigma[s] / singleSignal->GetRawData(singleSignal->GetMaxPeakBin());
         RatioSigmaMaxPeakMean += RatioSigmaMaxPeak[s];
         SigmaMean += Sigma[s];
-        ChiSquare[s] = f->GetChisquare();
         ChiSquareMean += ChiSquare[s];
 
-        baselineFit[singleSignal->GetID()] = f->GetParameter(0);
-        amplitudeFit[singleSignal->GetID()] = f->GetParameter(1);
-        shapingTimeFit[singleSignal->GetID()] = f->GetParameter(2);
-        peakPositionFit[singleSignal->GetID()] = f->GetParameter(3);
+        baselineFit[singleSignal->GetID()] = parameters[TRestRawPulseFitter::kBaseline];
+        amplitudeFit[singleSignal->GetID()] = parameters[TRestRawPulseFitter::kAmplitude];
+        shapingTimeFit[singleSignal->GetID()] = parameters[TRestRawPulseFitter::kShapingTime];
+        peakPositionFit[singleSignal->GetID()] = parameters[TRestRawPulseFitter::kStartPosition];
 
-        fShaping = f->GetParameter(2);
-        fStartPosition = f->GetParameter(3);
-        fBaseline = f->GetParameter(0);
-        fAmplitude = f->GetParameter(1);
-
-        h->Delete();
+        fShaping = parameters[TRestRawPulseFitter::kShapingTime];
+        fStartPosition = parameters[TRestRawPulseFitter::kStartPosition];
+        fBaseline = parameters[TRestRawPulseFitter::kBaseline];
+        fAmplitude = parameters[TRestRawPulseFitter::kAmplitude];
     }
 
     //////////// Fitted parameters Map Observables /////////////
@@ -324,10 +367,6 @@ TRestEvent* TRestRawSignalFittingProcess::ProcessEvent(TRestEvent* inputEvent) {
 /// processed. This method will write the channels histogram.
 ///
 void TRestRawSignalFittingProcess::EndProcess() {
-    // Function to be executed once at the end of the process
-    // (after all events have been processed)
-
-    // Start by calling the EndProcess function of the abstract class.
-    // Comment this if you don't want it.
-    // TRestEventProcess::EndProcess();
+    delete fWorkers;
+    fWorkers = nullptr;
 }
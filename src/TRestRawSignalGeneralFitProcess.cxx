@@ -33,6 +33,27 @@
 /// -- Complete function example: [0=0(-100,100)]+[1=2000]*TMath::Exp(-3. * (x-[3=80])/[2=70])
 ///                               * ((x-[3=80])/[2=70])^3  * sin((x-[3=80])/[2=70])
 ///
+/// The function is built and compiled once at InitProcess. The signals are
+/// fitted by least squares, using Minuit2, inside the **functionRange**, or
+/// over the full signal if no range is given. Each fit starts from the
+/// initial parameters of the function. The signals of one event may be
+/// fitted in parallel by setting **fitThreads**, each thread using its own
+/// copy of the function. The threads are created at InitProcess and kept
+/// until EndProcess.
+///
+/// ### Observables
+///
+/// * **Param_i_map**: The value of parameter i for each signal ID.
+/// * **ParamErr_i_map**: The error of parameter i for each signal ID.
+/// * **FitSignalId**: The ID of each fitted signal.
+/// * **Param_i**: The value of parameter i for each signal, in the order of
+/// FitSignalId. It holds the same values than Param_i_map.
+/// * **ParamErr_i**: The error of parameter i for each signal, in the order
+/// of FitSignalId.
+/// * **FitSigmaMean**, **FitSigmaStdDev**, **FitChiSquareMean** and
+/// **FitRatioSigmaMaxPeakMean**: As in TRestRawSignalFittingProcess, with the
+/// residuals computed inside the function range.
+///
 /// <hr>
 ///
 /// \warning **⚠ REST is under continuous development.** This documentation
@@ -53,6 +74,10 @@
 /// 2021-June First implementation of General Fit Process.
 ///                Created from TRestRawSignalAnalysisProcess.
 ///
+/// 2026-October: The function is compiled once, the fit uses functionRange,
+///               signals are fitted in parallel and the parameters are also
+///               stored as arrays.
+///
 /// \class      TRestRawSignalGeneralFitProcess
 /// \author     David Diez
 ///
@@ -60,6 +85,11 @@
 ///
 #include "TRestRawSignalGeneralFitProcess.h"
 
+#include <Fit/BinData.h>
+#include <Fit/Fitter.h>
+#include <Math/WrappedMultiTF1.h>
+#include <TROOT.h>
+
 using namespace std;
 
 ClassImp(TRestRawSignalGeneralFitProcess);
@@ -90,7 +120,10 @@ TRestRawSignalGeneralFitProcess::TRestRawSignalGeneralFitProcess(const char* con
 ///////////////////////////////////////////////
 /// \brief Default destructor
 ///
-TRestRawSignalGeneralFitProcess::~TRestRawSignalGeneralFitProcess() {}
+TRestRawSignalGeneralFitProcess::~TRestRawSignalGeneralFitProcess() {
+    DeleteFunctions();
+    delete fWorkers;
+}
 
 ///////////////////////////////////////////////
 /// \brief Function to load the default config in absence of RML input
@@ -125,10 +158,110 @@ void TRestRawSignalGeneralFitProcess::LoadConfig(const string& configFilename, c
 }
 
 ///////////////////////////////////////////////
-/// \brief Process initialization.
+/// \brief Process initialization. The function is built and compiled here,
+/// and copied for each fit thread.
+///
+/// The ROOT thread safety is always enabled, since the functions may be used
+/// from the fit threads, or from the threads of the process runner.
 ///
 void TRestRawSignalGeneralFitProcess::InitProcess() {
-    // fSignalFittingObservables = TRestEventProcess::ReadObservables();
+    ROOT::EnableThreadSafety();
+
+    DeleteFunctions();
+
+    fFitFunc = CreateTF1FromString(fFunction, fFunctionRange.X(), fFunctionRange.Y());
+    if (fFitFunc == nullptr) {
+        RESTError << "TRestRawSignalGeneralFitProcess. The function could not be built : " << fFunction
+                  << RESTendl;
+        return;
+    }
+
+    fInitialParameters.assign(fFitFunc->GetParameters(), fFitFunc->GetParameters() + fFitFunc->GetNpar());
+
+    delete fWorkers;
+    fWorkers = new TRestRawWorkerPool(max(fFitThreads, 1));
+    for (int n = 0; n < fWorkers->GetNumberOfThreads(); n++)
+        fThreadFunctions.push_back((TF1*)fFitFunc->Clone());
+}
+
+///////////////////////////////////////////////
+/// \brief It deletes the function and its copies
+///
+void TRestRawSignalGeneralFitProcess::DeleteFunctions() {
+    for (auto function : fThreadFunctions) delete function;
+    fThreadFunctions.clear();
+
+    delete fFitFunc;
+    fFitFunc = nullptr;
+}
+
+///////////////////////////////////////////////
+/// \brief It fits the signal with index s using the given function, and
+/// stores the results in the position s of the result vectors.
+///
+/// Each fit starts from the initial parameters, limits and fixed parameters
+/// of fFitFunc. The signal samples are placed at the bin centers, i + 0.5,
+/// as when the signal was filled into a histogram.
+///
+void TRestRawSignalGeneralFitProcess::FitSignal(Int_t s, TF1* function) {
+    const TRestRawSignal* singleSignal = fRawSignalEvent->GetSignal(s);
+    const Int_t nBins = singleSignal->GetNumberOfPoints();
+    const Int_t nPar = fFitFunc->GetNpar();
+
+    // The samples inside the function range, or all of them if no range is given
+    Int_t from = 0, to = nBins;
+    if (fFunctionRange.Y() > fFunctionRange.X()) {
+        from = max(0, (Int_t)ceil(fFunctionRange.X() - 0.5));
+        to = min(nBins, (Int_t)floor(fFunctionRange.Y() - 0.5) + 1);
+    }
+
+    Double_t* parameters = &fParameters[s * nPar];
+    Double_t* errors = &fParameterErrors[s * nPar];
+    for (int i = 0; i < nPar; i++) {
+        parameters[i] = fInitialParameters[i];
+        errors[i] = 0;
+    }
+    fChiSquare[s] = 0;
+    fSigma[s] = 0;
+    if (to - from <= nPar) return;
+
+    ROOT::Fit::BinData data(to - from, 1);
+    for (int i = from; i < to; i++) data.Add(i + 0.5, singleSignal->GetRawData(i));
+
+    function->SetParameters(parameters);
+    ROOT::Math::WrappedMultiTF1 model(*function, 1);
+    ROOT::Fit::Fitter fitter;
+    // Minuit2 does not use global state, and signals may be fitted in parallel
+    fitter.Config().SetMinimizer("Minuit2");
+    fitter.SetFunction(model, false);
+    for (int i = 0; i < nPar; i++) {
+        auto& settings = fitter.Config().ParSettings(i);
+        Double_t low, up;
+        fFitFunc->GetParLimits(i, low, up);
+        if (low * up != 0 && low >= up) {
+            settings.Fix();
+        } else if (low < up) {
+            settings.SetLimits(low, up);
+        }
+        if (parameters[i] != 0) settings.SetStepSize(0.1 * abs(parameters[i]));
+    }
+
+    if (fitter.Fit(data)) {
+        const ROOT::Fit::FitResult& result = fitter.Result();
+        for (int i = 0; i < nPar; i++) {
+            parameters[i] = result.Parameter(i);
+            errors[i] = result.ParError(i);
+        }
+        fChiSquare[s] = result.Chi2();
+    }
+    function->SetParameters(parameters);
+
+    Double_t sigma = 0;
+    for (int j = from; j < to; j++) {
+        const Double_t residual = singleSignal->GetRawData(j) - function->Eval(j);
+        sigma += residual * residual;
+    }
+    fSigma[s] = TMath::Sqrt(sigma / (to - from));
 }
 
 ///////////////////////////////////////////////
@@ -141,108 +274,69 @@ TRestEvent* TRestRawSignalGeneralFitProcess::ProcessEvent(TRestEvent* inputEvent
     RESTDebug << "TRestRawSignalGeneralFitProcess::ProcessEvent. Event ID : " << fRawSignalEvent->GetID()
               << RESTendl;
 
-    Double_t SigmaMean = 0;
-    vector<Double_t> Sigma(fRawSignalEvent->GetNumberOfSignals());
-    Double_t RatioSigmaMaxPeakMean = 0;
-    vector<Double_t> RatioSigmaMaxPeak(fRawSignalEvent->GetNumberOfSignals());
-    Double_t ChiSquareMean = 0;
-    vector<Double_t> ChiSquare(fRawSignalEvent->GetNumberOfSignals());
+    // The function and the threads are deleted at EndProcess, and they are not created if InitProcess
+    // was not called
+    if (fFitFunc == nullptr) InitProcess();
+    if (fFitFunc == nullptr) return nullptr;
 
-    /*map<int, Double_t> baselineFit;
-    map<int, Double_t> amplitudeFit;
-    map<int, Double_t> shapingtimeFit;
-    map<int, Double_t> peakpositionFit;
+    const Int_t nSignals = fRawSignalEvent->GetNumberOfSignals();
+    const Int_t nPar = fFitFunc->GetNpar();
+    fParameters.resize(nSignals * nPar);
+    fParameterErrors.resize(nSignals * nPar);
+    fChiSquare.resize(nSignals);
+    fSigma.resize(nSignals);
 
-    baselineFit.clear();
-    amplitudeFit.clear();
-    shapingtimeFit.clear();
-    peakpositionFit.clear();*/
+    fWorkers->ForEach(nSignals, [&](Int_t s, Int_t thread) { FitSignal(s, fThreadFunctions[thread]); });
 
-    if (fFitFunc) {
-        delete fFitFunc;
-        fFitFunc = nullptr;
+    // The function keeps the result of the last signal
+    if (nSignals > 0) {
+        fFitFunc->SetParameters(&fParameters[(nSignals - 1) * nPar]);
+        fFitFunc->SetParErrors(&fParameterErrors[(nSignals - 1) * nPar]);
     }
-    fFitFunc = CreateTF1FromString(fFunction, fFunctionRange.X(), fFunctionRange.Y());
-
-    std::vector<map<int, Double_t>> param(fFitFunc->GetNpar());
-    std::vector<map<int, Double_t>> paramErr(fFitFunc->GetNpar());
 
-    for (int s = 0; s < fRawSignalEvent->GetNumberOfSignals(); s++) {
-        TRestRawSignal* singleSignal = fRawSignalEvent->GetSignal(s);
+    Double_t SigmaMean = 0;
+    vector<Double_t>& Sigma = fSigma;
+    Double_t RatioSigmaMaxPeakMean = 0;
+    vector<Double_t> RatioSigmaMaxPeak(nSignals);
+    Double_t ChiSquareMean = 0;
+    vector<Double_t>& ChiSquare = fChiSquare;
 
-        int MaxPeakBin = singleSignal->GetMaxPeakBin();
-
-        /*// ShaperSin function (AGET theoretic curve) times logistic function
-        TF1* f = new TF1("fit",
-                         "[0]+[1]*TMath::Exp(-3. * (x-[3])/[2]) * "
-                         "(x-[3])/[2] * (x-[3])/[2] * (x-[3])/[2] * "
-                         "sin((x-[3])/[2])/(1+TMath::Exp(-10000*(x-[3])))",
-                         0, 511);
-        f->SetParameters(0, 2000, 70, 80);
-        //f->SetParameters(0, 0);  // Initial values adjusted from Desmos
-        //f->SetParLimits(0, 150, 350);
-        //f->SetParameters(1, 2000);
-        //f->SetParLimits(1, 30, 90000);
-        //f->SetParameters(2, 70);
-        //f->SetParLimits(2, 10, 80);
-        //f->SetParameters(3, 80);
-        //f->SetParLimits(3, 150, 250);
-        //f->FixParameter(2, 75);
-        f->SetParNames("Baseline", "Amplitude", "ShapingTime", "PeakPosition");*/
-
-        // Create histogram from signal
-        Int_t nBins = singleSignal->GetNumberOfPoints();
-        TH1D* h = new TH1D("histo", "Signal to histo", nBins, 0, nBins);
-
-        for (int i = 0; i < nBins; i++) {
-            h->Fill(i, singleSignal->GetRawData(i));
-        }
+    vector<Int_t> signalIds(nSignals);
+    vector<vector<Double_t>> param(nPar, vector<Double_t>(nSignals));
+    vector<vector<Double_t>> paramErr(nPar, vector<Double_t>(nSignals));
+    vector<map<int, Double_t>> paramMap(nPar);
+    vector<map<int, Double_t>> paramErrMap(nPar);
 
-        // Fit histogram with ShaperSin
-        h->Fit(fFitFunc, "NWW", "", 0, 511);  // Options: R->fit in range, N->No draw, Q->Quiet
+    for (int s = 0; s < nSignals; s++) {
+        TRestRawSignal* singleSignal = fRawSignalEvent->GetSignal(s);
+        signalIds[s] = singleSignal->GetID();
 
-        Double_t sigma = 0;
-        for (int j = fFunctionRange.X(); j < fFunctionRange.Y(); j++) {
-            sigma += (singleSignal->GetRawData(j) - fFitFunc->Eval(j)) *
-                     (singleSignal->GetRawData(j) - fFitFunc->Eval(j));
-        }
-        Sigma[s] = TMath::Sqrt(sigma / (fFunctionRange.Y() - fFunctionRange.X()));
-        RatioSigmaMaxPeak[s] = Sigma[s] / singleSignal->GetRawData(MaxPeakBin);
+        RatioSigmaMaxPeak[s] = Sigma[s] / singleSignal->GetRawData(singleSignal->GetMaxPeakBin());
         RatioSigmaMaxPeakMean += RatioSigmaMaxPeak[s];
         SigmaMean += Sigma[s];
-        ChiSquare[s] = fFitFunc->GetChisquare();
         ChiSquareMean += ChiSquare[s];
 
-        for (int i = 0; i < fFitFunc->GetNpar(); i++) {
-            param[i][singleSignal->GetID()] = fFitFunc->GetParameter(i);
-            paramErr[i][singleSignal->GetID()] = fFitFunc->GetParError(i);
-            RESTDebug << "Parameter " << i << ": " << param[i][singleSignal->GetID()] << RESTendl;
-            RESTDebug << "Error parameter " << i << ": " << paramErr[i][singleSignal->GetID()] << RESTendl;
+        for (int i = 0; i < nPar; i++) {
+            param[i][s] = fParameters[s * nPar + i];
+            paramErr[i][s] = fParameterErrors[s * nPar + i];
+            paramMap[i][signalIds[s]] = param[i][s];
+            paramErrMap[i][signalIds[s]] = paramErr[i][s];
+            RESTDebug << "Parameter " << i << ": " << param[i][s] << RESTendl;
+            RESTDebug << "Error parameter " << i << ": " << paramErr[i][s] << RESTendl;
         }
-
-        /*baselineFit[singleSignal->GetID()] = f->GetParameter(0);
-        amplitudeFit[singleSignal->GetID()] = f->GetParameter(1);
-        shapingtimeFit[singleSignal->GetID()] = f->GetParameter(2);
-        peakpositionFit[singleSignal->GetID()] = f->GetParameter(3);
-
-        fShaping = f->GetParameter(2);
-        fStartPosition = f->GetParameter(3);
-        fBaseline = f->GetParameter(0);
-        fAmplitude = f->GetParameter(1);*/
-
-        h->Delete();
     }
 
     //////////// Fitted parameters Map Observables /////////////
-    /*SetObservableValue("FitBaseline_map", baselineFit);
-    SetObservableValue("FitAmplitude_map", amplitudeFit);
-    SetObservableValue("FitShapingTime_map", shapingtimeFit);
-    SetObservableValue("FitPeakPosition_map", peakpositionFit);*/
+    for (int i = 0; i < nPar; i++) {
+        SetObservableValue("Param_" + to_string(i) + "_map", paramMap[i]);
+        SetObservableValue("ParamErr_" + to_string(i) + "_map", paramErrMap[i]);
+    }
 
-    //////////// Fitted parameters Map Observables /////////////
-    for (int i = 0; i < fFitFunc->GetNpar(); i++) {
-        SetObservableValue("Param_" + to_string(i) + "_map", param[i]);
-        SetObservableValue("ParamErr_" + to_string(i) + "_map", paramErr[i]);
+    //////////// Fitted parameters Observables /////////////
+    SetObservableValue("FitSignalId", signalIds);
+    for (int i = 0; i < nPar; i++) {
+        SetObservableValue("Param_" + to_string(i), param[i]);
+        SetObservableValue("ParamErr_" + to_string(i), paramErr[i]);
     }
 
     //////////// Sigma Mean Observable /////////////
@@ -316,8 +410,7 @@ void TRestRawSignalGeneralFitProcess::EndProcess() {
     // Start by calling the EndProcess function of the abstract class.
     // Comment this if you don't want it.
     // TRestEventProcess::EndProcess();
-    if (fFitFunc) {
-        delete fFitFunc;
-        fFitFunc = nullptr;
-    }
+    DeleteFunctions();
+    delete fWorkers;
+    fWorkers = nullptr;
 }
@@ -61,6 +61,8 @@ void TRestRawSignalRangeReductionProcess::InitFromConfigFile() {
 
     const TVector2 DigitizationRange = Get2DVectorParameterWithUnits("inputRange", fDigitizationInputRange);
     SetDigitizationInputRange(DigitizationRange);
+
+    fInPlace = StringToBool(GetParameter("inPlace", fInPlace));
 }
 
 void TRestRawSignalRangeReductionProcess::InitProcess() {
@@ -74,6 +76,13 @@ TRestEvent* TRestRawSignalRangeReductionProcess::ProcessEvent(TRestEvent* inputE
         return nullptr;
     }
 
+    if (fInPlace) {
+        for (int n = 0; n < fInputRawSignalEvent->GetNumberOfSignals(); n++) {
+            ProcessSignal(fInputRawSignalEvent->GetSignal(n));
+        }
+        return fInputRawSignalEvent;
+    }
+
     for (int n = 0; n < fInputRawSignalEvent->GetNumberOfSignals(); n++) {
         const TRestRawSignal* inputSignal = fInputRawSignalEvent->GetSignal(n);
         TRestRawSignal signal;
@@ -91,6 +100,13 @@ TRestEvent* TRestRawSignalRangeReductionProcess::ProcessEvent(TRestEvent* inputE
     return fOutputRawSignalEvent;
 }
 
+void TRestRawSignalRangeReductionProcess::ProcessSignal(TRestRawSignal* signal) {
+    for (int i = 0; i < signal->GetNumberOfPoints(); i++) {
+        signal->SetPoint(i, ConvertFromStartingRangeToTargetRange(signal->GetData(i)));
+    }
+    signal->ResetCalculatedValues();
+}
+
 void TRestRawSignalRangeReductionProcess::SetResolutionInNumberOfBits(UShort_t nBits) {
     if (nBits < 0 || nBits > 16) {
         RESTWarning << "Number of bits must be between 1 and 16. Setting it to " << fResolutionInBits
@@ -36,19 +36,23 @@
 ///
 /// ### Fitting Function
 /// The fitting function is fixed (hardcoded) to the AGET response function
-/// (without the sine term) multiplied by a logistic function:
+/// (without the sine term), normalized to its maximum:
 ///
 /// \code
-/// [0] + [1] * TMath::Exp(-3. * (x-[3])/[2]) *
-/// (x-[3])/[2] * (x-[3])/[2] * (x-[3])/[2] /
-/// (1 + TMath::Exp(-10000 * (x-[3])))
+/// [0] + [1] * ((x-[3])/[2] * exp(1 - (x-[3])/[2]))^3    for x > [3], and [0] otherwise
 ///
 /// [0] = "Baseline"
-/// [1] = "Amplitude * e^{3}"
-/// [2] = "HalfWidth"
+/// [1] = "Amplitude" over the baseline
+/// [2] = "HalfWidth", from the pulse start to the peak
 /// [3] = "PulseStart"
 /// \endcode
 ///
+/// The normalized pulse is tabulated once at InitProcess. Only the unsaturated rising and
+/// falling edges inside the fit range enter the fit. A coarse scan over the width and the
+/// peak position, which must lie inside the saturated range, solves the baseline and the
+/// amplitude by linear least squares for each candidate, and the best candidate is refined
+/// by a few Levenberg-Marquardt iterations. The baseline stays fixed if it has been
+/// calculated from **baseLineRange**.
 ///
 /// \image html RecoverSignalProcess_signalFit.png "Signal Fit" width=500px
 ///
@@ -143,6 +147,13 @@
 
 #include "TRestRawSignalRecoverSaturationProcess.h"
 
+#include <TGraph.h>
+#include <TMath.h>
+
+#include <limits>
+
+#include "TRestRawPulseFitter.h"
+
 ClassImp(TRestRawSignalRecoverSaturationProcess);
 
 ///////////////////////////////////////////////
@@ -187,6 +198,182 @@ void TRestRawSignalRecoverSaturationProcess::InitProcess() {
     if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Extreme) {
         fC = new TCanvas("c", "c", 800, 600);
     }
+
+    BuildTemplate();
+}
+
+namespace {
+/// The template is tabulated in u = (x - start) / width from 0 to kTemplateRange
+constexpr Double_t kTemplateRange = 20.;
+constexpr Double_t kTemplateStep = 1.e-3;
+/// Number of widths and peak positions scanned before the least squares refinement
+constexpr Int_t kWidthScan = 9;
+constexpr Int_t kPeakScan = 9;
+constexpr Int_t kMaxIterations = 30;
+}  // namespace
+
+///////////////////////////////////////////////
+/// \brief It tabulates the AGET pulse without the sine term, normalized to 1 at its maximum
+/// (u = 1), together with its derivative.
+///
+void TRestRawSignalRecoverSaturationProcess::BuildTemplate() {
+    const Int_t n = (Int_t)(kTemplateRange / kTemplateStep) + 2;
+    fTemplate.resize(n);
+    fTemplateDerivative.resize(n);
+    for (Int_t i = 0; i < n; i++) {
+        Double_t u = i * kTemplateStep;
+        Double_t g = u * TMath::Exp(1. - u);
+        fTemplate[i] = g * g * g;
+        fTemplateDerivative[i] = 3. * g * g * TMath::Exp(1. - u) * (1. - u);
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief It returns the tabulated template at u, linearly interpolated. The template is 0
+/// before the pulse start (u <= 0) and after the tabulated range.
+///
+Double_t TRestRawSignalRecoverSaturationProcess::EvaluateTemplate(Double_t u, Double_t* derivative) const {
+    if (u <= 0 || u >= kTemplateRange) {
+        if (derivative) *derivative = 0;
+        return 0;
+    }
+    Double_t x = u / kTemplateStep;
+    Int_t i = (Int_t)x;
+    Double_t f = x - i;
+    if (derivative) {
+        *derivative = fTemplateDerivative[i] + f * (fTemplateDerivative[i + 1] - fTemplateDerivative[i]);
+    }
+    return fTemplate[i] + f * (fTemplate[i + 1] - fTemplate[i]);
+}
+
+///////////////////////////////////////////////
+/// \brief It returns the sum of squared residuals of the pulse `par` at the fit points
+///
+Double_t TRestRawSignalRecoverSaturationProcess::ComputeChiSquare(const Double_t* par) const {
+    Double_t chi2 = 0;
+    for (size_t k = 0; k < fFitBins.size(); k++) {
+        Double_t r = fFitValues[k] - par[0] - par[1] * EvaluateTemplate((fFitBins[k] - par[3]) / par[2]);
+        chi2 += r * r;
+    }
+    return chi2;
+}
+
+///////////////////////////////////////////////
+/// \brief It fits the pulse to the points stored at fFitBins and fFitValues.
+///
+/// A coarse scan over the width and the peak position, placed inside the saturated range,
+/// solves the baseline and amplitude by linear least squares for each candidate. The best
+/// candidate is then refined with Levenberg-Marquardt steps, keeping the parameters inside
+/// the physical limits. `par` holds the initial estimation and receives the result.
+///
+void TRestRawSignalRecoverSaturationProcess::FitPulse(Double_t* par, Bool_t fixBaseline,
+                                                      Int_t firstSaturated, Int_t lastSaturated,
+                                                      Double_t maxValue, Int_t nPoints) {
+    const Double_t maxAmplitude = 100. * maxValue;  // 100 times the saturation value
+    const Double_t widthEstimate = std::max(par[2], 1.);
+
+    Double_t best[4] = {par[0], par[1], par[2], par[3]};
+    Double_t bestChi2 = ComputeChiSquare(best);
+
+    const Int_t peakSteps = std::min(kPeakScan, lastSaturated - firstSaturated + 1);
+    for (Int_t w = 0; w < kWidthScan; w++) {
+        Double_t width = widthEstimate * TMath::Power(2., (w - kWidthScan / 2) / 4.);
+        if (width > nPoints) continue;
+        for (Int_t p = 0; p < peakSteps; p++) {
+            Double_t peak = firstSaturated;
+            if (peakSteps > 1) peak += (Double_t)p * (lastSaturated - firstSaturated) / (peakSteps - 1);
+            Double_t start = peak - width;
+            if (start < 0) continue;
+
+            // Linear least squares for baseline and amplitude
+            Double_t sh = 0, shh = 0, sy = 0, syh = 0;
+            for (size_t k = 0; k < fFitBins.size(); k++) {
+                Double_t h = EvaluateTemplate((fFitBins[k] - start) / width);
+                sh += h;
+                shh += h * h;
+                sy += fFitValues[k];
+                syh += fFitValues[k] * h;
+            }
+            Double_t baseline = par[0];
+            Double_t amplitude;
+            if (fixBaseline) {
+                if (shh <= 0) continue;
+                amplitude = (syh - baseline * sh) / shh;
+            } else {
+                Double_t n = fFitBins.size();
+                Double_t det = n * shh - sh * sh;
+                if (det <= 0) continue;
+                baseline = (sy * shh - sh * syh) / det;
+                amplitude = (n * syh - sh * sy) / det;
+            }
+            if (amplitude <= 0 || amplitude > maxAmplitude) continue;
+
+            Double_t candidate[4] = {baseline, amplitude, width, start};
+            Double_t chi2 = ComputeChiSquare(candidate);
+            if (chi2 < bestChi2) {
+                bestChi2 = chi2;
+                std::copy(candidate, candidate + 4, best);
+            }
+        }
+    }
+
+    // Levenberg-Marquardt refinement. A fixed baseline keeps a null step
+    Double_t lambda = 1.e-3;
+    for (Int_t iteration = 0; iteration < kMaxIterations; iteration++) {
+        Double_t alpha[16] = {0};
+        Double_t beta[4] = {0};
+        for (size_t k = 0; k < fFitBins.size(); k++) {
+            Double_t u = (fFitBins[k] - best[3]) / best[2];
+            Double_t dh;
+            Double_t h = EvaluateTemplate(u, &dh);
+            Double_t jac[4] = {1., h, -best[1] * dh * u / best[2], -best[1] * dh / best[2]};
+            Double_t r = fFitValues[k] - best[0] - best[1] * h;
+            for (Int_t i = 0; i < 4; i++) {
+                beta[i] += jac[i] * r;
+                for (Int_t j = 0; j <= i; j++) alpha[4 * i + j] += jac[i] * jac[j];
+            }
+        }
+        for (Int_t i = 0; i < 4; i++)
+            for (Int_t j = 0; j < i; j++) alpha[4 * j + i] = alpha[4 * i + j];
+        if (fixBaseline) {
+            for (Int_t i = 0; i < 4; i++) alpha[i] = alpha[4 * i] = 0;
+            alpha[0] = 1;
+            beta[0] = 0;
+        }
+
+        Bool_t improved = false;
+        while (lambda < 1.e6) {
+            Double_t a[16];
+            Double_t b[4];
+            Double_t step[4];
+            std::copy(alpha, alpha + 16, a);
+            std::copy(beta, beta + 4, b);
+            for (Int_t i = 0; i < 4; i++) a[5 * i] *= 1. + lambda;
+            if (!TRestRawPulseFitter::SolveLinearSystem(a, b, step, 4)) {
+                lambda *= 10.;
+                continue;
+            }
+
+            Double_t trial[4];
+            for (Int_t i = 0; i < 4; i++) trial[i] = best[i] + step[i];
+            Bool_t inside = trial[0] >= 0 && trial[0] <= maxValue && trial[1] > 0 &&
+                            trial[1] <= maxAmplitude && trial[2] > 0 && trial[2] <= nPoints &&
+                            trial[3] >= 0 && trial[3] <= nPoints;
+            Double_t chi2 = inside ? ComputeChiSquare(trial) : bestChi2;
+            if (inside && chi2 < bestChi2) {
+                Double_t decrease = bestChi2 - chi2;
+                std::copy(trial, trial + 4, best);
+                bestChi2 = chi2;
+                lambda = std::max(lambda / 10., 1.e-7);
+                improved = decrease > 1.e-6 * (bestChi2 + 1.);
+                break;
+            }
+            lambda *= 10.;
+        }
+        if (!improved) break;
+    }
+
+    std::copy(best, best + 4, par);
 }
 
 ///////////////////////////////////////////////
@@ -196,9 +383,6 @@ TRestEvent* TRestRawSignalRecoverSaturationProcess::ProcessEvent(TRestEvent* evI
     fAnaEvent = (TRestRawSignalEvent*)evInput;
     auto eventID = fAnaEvent->GetID();
 
-    // If cut condition matches the event will be not registered.
-    if (ApplyCut()) return nullptr;
-
     // Write here the main logic of process: TRestRawSignalRecoverSaturationProcess
     // Read data from input event, write data to output event, and save observables to tree
 
@@ -229,7 +413,7 @@ TRestEvent* TRestRawSignalRecoverSaturationProcess::ProcessEvent(TRestEvent* evI
         nSignalsSaturated++;
         Int_t maxPeakBin = signal->GetMaxPeakBin();
         Short_t maxValue = (*signal)[maxPeakBin];
-        std::vector<size_t> saturatedBins;
+        const Int_t nPoints = signal->GetNumberOfPoints();
 
         if (maxValue < fMinSaturationValue) {
             RESTDebug << "    Saturation value " << maxValue << " is less than the minimum value "
@@ -237,65 +421,53 @@ TRestEvent* TRestRawSignalRecoverSaturationProcess::ProcessEvent(TRestEvent* evI
             continue;
         }
 
-        // Find all saturated bins
-        for (size_t i = (size_t)maxPeakBin; i < (size_t)signal->GetNumberOfPoints(); i++) {
-            if ((*signal)[i] == maxValue)
-                saturatedBins.push_back(i);
-            else
-                break;  // Stop when the signal stops being saturated
-        }
+        // The saturated bins are the contiguous range [firstSaturated, lastSaturated] starting at the peak
+        Int_t firstSaturated = maxPeakBin;
+        Int_t lastSaturated = maxPeakBin;
+        while (lastSaturated + 1 < nPoints && (*signal)[lastSaturated + 1] == maxValue) lastSaturated++;
 
-        // If processAllSignals is true, set saturatedBins for all signals
-        if (fProcessAllSignals && saturatedBins.size() < fMinSaturatedBins) {
-            saturatedBins.clear();
-            // set saturated bins around maxPeakBin
-            for (size_t i = maxPeakBin - fNBinsIfNotSaturated / 2;
-                 i < maxPeakBin + fNBinsIfNotSaturated / 2 && i < (size_t)signal->GetNumberOfPoints(); i++) {
-                saturatedBins.push_back(i);
-            }
+        // If processAllSignals is true, set the saturated range around maxPeakBin for all signals
+        if (fProcessAllSignals && (Size_t)(lastSaturated - firstSaturated + 1) < fMinSaturatedBins) {
+            firstSaturated = std::max(0, maxPeakBin - (Int_t)fNBinsIfNotSaturated / 2);
+            lastSaturated = std::min(nPoints, maxPeakBin + (Int_t)fNBinsIfNotSaturated / 2) - 1;
             // maxPeakBin should be the first saturated bin
-            maxPeakBin = saturatedBins.empty() ? maxPeakBin : saturatedBins.front();
+            maxPeakBin = firstSaturated;
             maxValue = (*signal)[maxPeakBin];
         }
 
-        if (!saturatedBins.empty()) {
-            RESTDebug << "    Saturated bins:" << saturatedBins.front() << " to " << saturatedBins.back()
-                      << " at " << maxValue << RESTendl;
+        RESTDebug << "    Saturated bins:" << firstSaturated << " to " << lastSaturated << " at " << maxValue
+                  << RESTendl;
+
+        Int_t startFitRange = 0;
+        Int_t endFitRange = nPoints;
+        if (fFitRange.X() != -1 && fFitRange.Y() != -1) {
+            startFitRange = std::max(0, (Int_t)fFitRange.X());
+            endFitRange = std::min(nPoints, (Int_t)fFitRange.Y());
         }
 
-        // Create TGraph with the not saturated bins for the fit
-        TGraph* g = new TGraph();
-        for (size_t i = 0; i < (size_t)signal->GetNumberOfPoints(); i++) {
-            if (std::find(saturatedBins.begin(), saturatedBins.end(), i) != saturatedBins.end()) continue;
-            g->AddPoint(i, (*signal)[i]);
+        // Only the unsaturated rising and falling edges inside the fit range enter the fit
+        fFitBins.clear();
+        fFitValues.clear();
+        for (Int_t i = startFitRange; i < endFitRange; i++) {
+            if (i >= firstSaturated && i <= lastSaturated) continue;
+            fFitBins.push_back(i);
+            fFitValues.push_back((*signal)[i]);
         }
-        /* g = signal->GetGraph(); // this would return (*signal)[i]-baseLine (if baseline has been
-        // initialized). Then one should remove the saturated bins from the TGraph:
-        // Remove the saturated bins from the TGraph representing the signal
-        for (size_t i = 0; i < saturatedBins.size(); i++) {
-            g->RemovePoint(maxPeakBin);  // when one point is removed the other points are shifted
-        } //*/
-
-        // ShaperSin function (AGET theoretic curve) times logistic function. Better without the sin
-        Double_t startFitRange = 0;
-        Double_t endFitRange = signal->GetNumberOfPoints();
-        if (fFitRange.X() != -1 && fFitRange.Y() != -1) {
-            startFitRange = fFitRange.X();
-            endFitRange = fFitRange.Y();
+
+        // The 4 parameters cannot be fitted with less points
+        if (fFitBins.size() < 4) {
+            RESTDebug << "    Only " << fFitBins.size() << " points to fit. Signal " << s << " in event "
+                      << eventID << " not recovered" << RESTendl;
+            continue;
         }
-        TF1* f = new TF1("fit",
-                         "[0]+[1]*TMath::Exp(-3. * (x-[3])/[2]) * "
-                         "(x-[3])/[2] * (x-[3])/[2] * (x-[3])/[2] / "
-                         "(1+TMath::Exp(-10000*(x-[3])))",
-                         startFitRange, endFitRange);
 
         // First estimation of the parameters
-        auto peakposEstimate =
-            maxPeakBin + saturatedBins.size() / 2;  // maxPeakBin is the first saturated bin
+        Double_t peakposEstimate =
+            maxPeakBin + (lastSaturated - firstSaturated + 1) / 2;  // maxPeakBin is the first saturated bin
         Double_t amplEstimate = maxValue;
         Double_t widthEstimate = (endFitRange - startFitRange) * 0.33;  // 0.33 is somehow arbitrary
-        Int_t binAtHalfMaximum = (Int_t)startFitRange;
-        for (size_t i = (size_t)startFitRange; i < (size_t)endFitRange; i++) {
+        Int_t binAtHalfMaximum = startFitRange;
+        for (Int_t i = startFitRange; i < endFitRange; i++) {
             if ((*signal)[i] > amplEstimate / 2) {
                 binAtHalfMaximum = i;
                 break;
@@ -320,7 +492,9 @@ TRestEvent* TRestRawSignalRecoverSaturationProcess::ProcessEvent(TRestEvent* evI
                 signal->GetNumberOfPoints());  // we dont care about overshoot here
         }
         auto pOverThreshold = signal->GetPointsOverThreshold();
-        if (!pOverThreshold.empty()) {
+        // The first point over threshold must be before the saturated bins. Otherwise the slope below
+        // divides by zero, or by a negative distance, and the width estimate is not positive.
+        if (!pOverThreshold.empty() && pOverThreshold[0] < maxPeakBin) {
             RESTDebug << "    Points over threshold: " << pOverThreshold.size() << ". From point "
                       << pOverThreshold.front() << " to " << pOverThreshold.back() << RESTendl;
             // extrapolate the line connecting the first point of the pulse peak:
@@ -337,68 +511,50 @@ TRestEvent* TRestRawSignalRecoverSaturationProcess::ProcessEvent(TRestEvent* evI
             widthEstimate = peakposEstimate - pOverThreshold[0];
         }
 
-        RESTDebug << "    Estimations: ampl=" << amplEstimate << " (" << amplEstimate / 0.0498
-                  << ")  width=" << widthEstimate << " baseline=" << baselineEstimate
-                  << " peakpos=" << peakposEstimate << " (" << peakposEstimate - widthEstimate << ")"
-                  << RESTendl;
-        // Configure the fit parameters
-        f->SetParNames("Baseline", "Amplitude*e^{3}", "HalfWidth", "PulseStart");
-        // f->SetParameters(baselineEstimate, amplEstimate / 0.0498, widthEstimate, peakposEstimate -
-        // widthEstimate);
-        //  Baseline
-        f->SetParameter(0, baselineEstimate);
-        f->SetParLimits(0, 0, maxValue);  // baseline should be positive and less than the saturation value
-        if (signal->isBaseLineInitialized()) {  // fix the baseline to make it faster and more reliable
-            f->FixParameter(0, baselineEstimate);
-        }  //*/
-        // Amplitude
-        f->SetParameter(1, amplEstimate / 0.0498);  // 0.0498=e^{-3}
-        f->SetParLimits(1, 0,
-                        maxValue / 0.0498 * 100);  // max allowed amplitude is 100 times the saturation value
-        // Width or shaping time
-        f->SetParameter(2, widthEstimate);
-        f->SetParLimits(2, 0,
-                        signal->GetNumberOfPoints());  // width should be positive and less than the window
-        // Peak position
-        f->SetParameter(3, peakposEstimate - widthEstimate);
-        f->SetParLimits(
-            3, 0, signal->GetNumberOfPoints());  // peak position should be positive and less than the window
-
-        std::string fitOptions = "R";
-        if (GetVerboseLevel() < TRestStringOutput::REST_Verbose_Level::REST_Debug) {
-            fitOptions += "NQ";
-        }
-        g->Fit(f, fitOptions.c_str());
+        // The template is evaluated at (x - start) / width, so the width must be positive
+        widthEstimate = std::max(widthEstimate, 1.);
 
-        if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Extreme) {
-            g->Draw("AL");
-        }
-        // Add the recovered signal to the original signal
-        TRestRawSignal toAddSignal(0);
-        bool anyBinRecovered = false;
-        for (size_t i = 0; i < (size_t)signal->GetNumberOfPoints(); i++) {
-            if (std::find(saturatedBins.begin(), saturatedBins.end(), i) != saturatedBins.end()) {
-                Double_t value = f->Eval(i) - maxValue;
-                if (value > 0 || fProcessAllSignals) {
-                    toAddSignal.AddPoint(value);
-                    anyBinRecovered = true;
-                    addedIntegral += value;
-                    if (value > signalAddedAmplitude) signalAddedAmplitude = value;
-                    RESTExtreme << "    Adding value " << value << RESTendl;
-                    continue;
-                }
-            }
-            toAddSignal.AddPoint((Short_t)0);
-        }
+        RESTDebug << "    Estimations: ampl=" << amplEstimate << "  width=" << widthEstimate
+                  << " baseline=" << baselineEstimate << " peakpos=" << peakposEstimate << " ("
+                  << peakposEstimate - widthEstimate << ")" << RESTendl;
+
+        // Fit parameters: baseline, amplitude over the baseline, width (pulse start to peak) and pulse start
+        Double_t par[4] = {baselineEstimate, amplEstimate - baselineEstimate, widthEstimate,
+                           peakposEstimate - widthEstimate};
+        FitPulse(par, signal->isBaseLineInitialized(), firstSaturated, lastSaturated, maxValue, nPoints);
+
+        RESTDebug << "    Fit: baseline=" << par[0] << " ampl=" << par[1] << " width=" << par[2]
+                  << " start=" << par[3] << " chi2=" << ComputeChiSquare(par) << RESTendl;
 
         if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Extreme) {
-            f->Draw("same");
+            TGraph g;
+            TGraph fitted;
+            for (Int_t i = 0; i < nPoints; i++) {
+                g.AddPoint(i, (*signal)[i]);
+                fitted.AddPoint(i, par[0] + par[1] * EvaluateTemplate((i - par[3]) / par[2]));
+            }
+            g.DrawClone("AL");
+            fitted.SetLineColor(kRed);
+            fitted.DrawClone("L same");
             fC->Update();
             std::cin.get();
         }
 
-        delete g;
-        delete f;
+        // Replace the saturated bins by the fitted pulse
+        bool anyBinRecovered = false;
+        for (Int_t i = firstSaturated; i <= lastSaturated; i++) {
+            Double_t value = par[0] + par[1] * EvaluateTemplate((i - par[3]) / par[2]) - maxValue;
+            if (value > 0 || fProcessAllSignals) {
+                Double_t recovered = std::round(signal->GetSignalData()[i] + value);
+                recovered = std::min(std::max(recovered, (Double_t)std::numeric_limits<Short_t>::min()),
+                                     (Double_t)std::numeric_limits<Short_t>::max());
+                signal->GetSignalData()[i] = (Short_t)recovered;
+                anyBinRecovered = true;
+                addedIntegral += value;
+                if (value > signalAddedAmplitude) signalAddedAmplitude = value;
+                RESTExtreme << "    Adding value " << value << RESTendl;
+            }
+        }
 
         if (!anyBinRecovered) {
             RESTDebug << "    Signal " << s << " in event " << eventID << " not recovered" << RESTendl;
@@ -406,7 +562,6 @@ TRestEvent* TRestRawSignalRecoverSaturationProcess::ProcessEvent(TRestEvent* evI
         }
         nSignalsRecovered++;
         addedAmplitude += signalAddedAmplitude;
-        signal->SignalAddition(toAddSignal);
         RESTDebug << "    Signal " << s << " in event " << eventID << " recovered" << RESTendl;
     }
 
@@ -415,6 +570,10 @@ TRestEvent* TRestRawSignalRecoverSaturationProcess::ProcessEvent(TRestEvent* evI
     SetObservableValue("SignalsSaturated", nSignalsSaturated);
     SetObservableValue("SignalsRecovered", nSignalsRecovered);
 
+    // If cut condition matches the event will be not registered. The cut is applied once the
+    // observables of this event have been set.
+    if (ApplyCut()) return nullptr;
+
     return fAnaEvent;
 }
 
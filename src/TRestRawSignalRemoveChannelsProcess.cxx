@@ -41,6 +41,10 @@
 /// </TRestRawSignalRemoveChannelsProcess>
 /// \endcode
 ///
+/// If the parameter `inPlace` is set to true, the signals are removed from the
+/// input event, which is then returned as the output event, instead of copying
+/// the remaining signals to a new event.
+///
 /// <hr>
 ///
 /// \warning ** REST is under continuous development.** This documentation
@@ -61,6 +65,8 @@
 /// 2017-November: First implementation of TRestRawSignalRemoveChannelsProcess.
 ///             Javier Galan
 ///
+/// 2026-October: In place mode.
+///
 /// \class      TRestRawSignalRemoveChannelsProcess
 /// \author     Javier Galan
 ///
@@ -164,14 +170,12 @@ TRestEvent* TRestRawSignalRemoveChannelsProcess::ProcessEvent(TRestEvent* inputE
         exit(1);
     }
 
-    for (int n = 0; n < fInputEvent->GetNumberOfSignals(); n++) {
-        TRestRawSignal* signal = fInputEvent->GetSignal(n);
-
+    auto isRemoved = [&](const TRestRawSignal& signal) {
         bool removeSignal = false;
 
         // Check if the channel ID matches any specified for removal
         for (int fChannelId : fChannelIds) {
-            if (signal->GetID() == fChannelId) {
+            if (signal.GetID() == fChannelId) {
                 removeSignal = true;
                 break;
             }
@@ -179,7 +183,7 @@ TRestEvent* TRestRawSignalRemoveChannelsProcess::ProcessEvent(TRestEvent* inputE
 
         // Check if the channel type matches any specified for removal
         if (!removeSignal && !fChannelTypes.empty()) {
-            const auto signalId = signal->GetSignalID();
+            const auto signalId = signal.GetSignalID();
             string channelType = fReadoutMetadata->GetTypeForChannelDaqId(signalId);
             if (find(fChannelTypes.begin(), fChannelTypes.end(), channelType) != fChannelTypes.end()) {
                 removeSignal = true;
@@ -194,17 +198,27 @@ TRestEvent* TRestRawSignalRemoveChannelsProcess::ProcessEvent(TRestEvent* inputE
             }
         }
 
-        if (!removeSignal) {
-            fOutputEvent->AddSignal(*signal);
-        }
-
         // Logging messages
         if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Extreme) {
-            cout << "Channel ID : " << signal->GetID() << endl;
+            cout << "Channel ID : " << signal.GetID() << endl;
         }
 
         if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Debug && removeSignal) {
-            cout << "Removing channel id : " << signal->GetID() << endl;
+            cout << "Removing channel id : " << signal.GetID() << endl;
+        }
+
+        return removeSignal;
+    };
+
+    if (fInPlace) {
+        // Only the signals after a removed one are shifted, inside the input event
+        fInputEvent->RemoveSignalsIf(isRemoved);
+    } else {
+        for (int n = 0; n < fInputEvent->GetNumberOfSignals(); n++) {
+            TRestRawSignal* signal = fInputEvent->GetSignal(n);
+            if (!isRemoved(*signal)) {
+                fOutputEvent->AddSignal(*signal);
+            }
         }
     }
 
@@ -212,6 +226,8 @@ TRestEvent* TRestRawSignalRemoveChannelsProcess::ProcessEvent(TRestEvent* inputE
         GetChar();
     }
 
+    if (fInPlace) return fInputEvent;
+
     return fOutputEvent;
 }
 
@@ -252,6 +268,8 @@ void TRestRawSignalRemoveChannelsProcess::InitFromConfigFile() {
         }
         fChannelTypes.push_back(type);
     }
+
+    fInPlace = StringToBool(GetParameter("inPlace", fInPlace));
 }
 
 void TRestRawSignalRemoveChannelsProcess::PrintMetadata() {
@@ -273,5 +291,7 @@ void TRestRawSignalRemoveChannelsProcess::PrintMetadata() {
         RESTMetadata << "Removing channel of type '" << type << "' and id " << signalId << RESTendl;
     }
 
+    RESTMetadata << "In place: " << (fInPlace ? "true" : "false") << RESTendl;
+
     EndPrintProcess();
 }
@@ -33,6 +33,7 @@
 ///
 /// * **shapingType**: It defines the type of convolution to be performed.
 ///     - gaus : It produces a gausian convolution.
+///     - exponential : It produces an exponential decay response.
 ///     - shaper : It produces a shaping following traditional shaper
 ///               waveforms.
 ///     - shaperSin : It produces a shaping following traditional shaper
@@ -42,9 +43,24 @@
 /// * **shapingTime** : The standard deviation of the gaussian convolution,
 ///                     or the shaping time on shaper models. Defined in
 ///                     samples unit.
-/// * **gain** : A factor to amplify or attenuate the signal.
+/// * **shapingGain** : A factor to amplify or attenuate the signal.
+/// * **shapingEngine** : The method used to perform the convolution.
+///     - direct : The response is added sample by sample. The cost grows
+///               with the number of bins in the response.
+///     - fft : The convolution is obtained from the product of the input
+///             and response spectra.
+///     - auto : The direct convolution is used for responses up to 128 bins,
+///              and fft for longer ones. This is the default.
+///     - iir : Only for exponential and shaper types. The response is applied
+///             as a recursive filter, and the cost does not depend on the
+///             shaping time.
+/// * **shapingOrder** : The order n of the shaper response,
+/// (t/shapingTime)^n exp(-n t/shapingTime), i.e. a CR-RCn shaper peaking at
+/// shapingTime. By default 3.
 /// * **responseFile** : A response file to be used in case the shapingType
 /// is defined to use a response file.
+/// * **inPlace** : If true, the shaped signals replace the data of the input
+/// event, which is returned as the output event. By default false.
 ///
 /// <hr>
 ///
@@ -74,6 +90,10 @@
 /// 2018-March: Transfered to TRestRawSignal
 ///             Javier Galan
 ///
+/// 2026-October: Response built at InitProcess, direct, FFT and IIR engines.
+///
+/// 2026-October: In place mode.
+///
 /// \class      TRestRawSignalShapingProcess
 /// \author     Xinglong
 /// \author     Javier Galan
@@ -87,6 +107,9 @@ using namespace std;
 #include <TFile.h>
 #include <TMath.h>
 
+/// Responses with more bins than this value are convoluted using FFT when shapingEngine is auto
+const Int_t kMaxDirectResponseSize = 128;
+
 ClassImp(TRestRawSignalShapingProcess);
 
 ///////////////////////////////////////////////
@@ -114,7 +137,9 @@ TRestRawSignalShapingProcess::TRestRawSignalShapingProcess(const char* configFil
 ///////////////////////////////////////////////
 /// \brief Default destructor
 ///
-TRestRawSignalShapingProcess::~TRestRawSignalShapingProcess() { delete fOutputSignalEvent; }
+TRestRawSignalShapingProcess::~TRestRawSignalShapingProcess() {
+    delete fOutputSignalEvent;
+}
 
 ///////////////////////////////////////////////
 /// \brief Function to initialize input/output event members and define the
@@ -145,141 +170,319 @@ void TRestRawSignalShapingProcess::LoadConfig(const string& configFilename, cons
 }
 
 ///////////////////////////////////////////////
-/// \brief Process initialization. Observable names are interpreted and auxiliar
-/// observable members, related to VolumeEdep, MeanPos, TracksCounter, TrackEDep
-/// observables defined in TRestGeant4AnalysisProcess are filled at this stage.
+/// \brief Process initialization. The response does not change from event to
+/// event, so that it is built here together with the choice of convolution
+/// engine.
 ///
 void TRestRawSignalShapingProcess::InitProcess() {
-    /*
-     * NOT IMPLEMENTED. TODO To use a generic response from a
-     * predefined TRestDetectorSignal
-     *
-     * For the moment we do only a gaussian shaping"
-     * /
-
-    responseSignal = new TRestRawSignal();
-
-    if( fShapingType == "responseFile" )
-    {
-        TString fullPathName = (TString) getenv("REST_PATH") + "/data/signal/" +
-    fResponseFilename; TFile *f = new TFile(fullPathName); responseSignal =
-    (TRestRawSignal *) f->Get("signal Response"); f->Close();
-    }
+    BuildResponse();
 
-    if( GetVerboseLevel() >= REST_Debug )
-    {
-        CreateCanvas();
-        fCanvas->Draw();
+    fUseIIR = false;
+    if (fShapingEngine == "iir" && fShapingType != "exponential" && fShapingType != "shaper") {
+        RESTWarning << "The iir engine is only available for exponential and shaper types. Using auto."
+                    << RESTendl;
+        fShapingEngine = "auto";
     }
 
-    if( fShapingType == "gaus" )
-    {
-        responseSignal->InitGaussian( 100, 100, 30, 200 );
-
-        if( GetVerboseLevel() >= REST_Debug )
-        {
-            responseSignal->GetGraph()->Draw();
-            fCanvas->Update();
-            GetChar();
-        }
+    if (fShapingEngine == "iir") {
+        fUseIIR = true;
+        fUseFFT = false;
+    } else if (fShapingEngine == "fft") {
+        fUseFFT = true;
+    } else if (fShapingEngine == "direct") {
+        fUseFFT = false;
+    } else {
+        if (fShapingEngine != "auto")
+            RESTWarning << "Shaping engine : " << fShapingEngine << " is not defined. Using auto."
+                        << RESTendl;
+        fUseFFT = (Int_t)fResponse.size() > kMaxDirectResponseSize;
     }
-    */
+
+    fNfft = 0;
 }
 
 ///////////////////////////////////////////////
-/// \brief The main processing event function
+/// \brief It builds the response for the given shaping type and time. The
+/// response integral is normalized to fShapingGain.
 ///
-TRestEvent* TRestRawSignalShapingProcess::ProcessEvent(TRestEvent* inputEvent) {
-    fInputSignalEvent = (TRestRawSignalEvent*)inputEvent;
-
-    if (fInputSignalEvent->GetNumberOfSignals() <= 0) {
-        return nullptr;
-    }
+/// The response is left empty if the shaping type is not defined.
+///
+/// TODO To use a generic response from a predefined TRestDetectorSignal,
+/// shapingType = responseFile.
+///
+void TRestRawSignalShapingProcess::BuildResponse() {
+    fResponse.clear();
+    fResponseOffset = 0;
 
-    std::vector<double> response;
     Int_t Nr = 0;
-
-    /// This is done for every event however we could do it inside InitProcess!
-    /// It is the response function. Does not change from event ot event
     if (fShapingType == "gaus") {
         Int_t cBin = (Int_t)(fShapingTime * 3.5);
         Nr = 2 * cBin;
         Double_t sigma = fShapingTime;
 
-        response.resize(Nr);
+        fResponse.resize(Nr);
+        fResponseOffset = cBin;
 
         for (int i = 0; i < Nr; i++) {
-            response[i] = TMath::Exp(-0.5 * (i - cBin) * (i - cBin) / sigma / sigma);
-            response[i] = response[i] / TMath::Sqrt(2 * M_PI) / sigma;
+            fResponse[i] = TMath::Exp(-0.5 * (i - cBin) * (i - cBin) / sigma / sigma);
+            fResponse[i] = fResponse[i] / TMath::Sqrt(2 * M_PI) / sigma;
         }
     } else if (fShapingType == "exponential") {
         Nr = (Int_t)(5 * fShapingTime);
 
-        response.resize(Nr);
+        fResponse.resize(Nr);
 
         for (int i = 0; i < Nr; i++) {
             Double_t coeff = ((Double_t)i) / fShapingTime;
-            response[i] = TMath::Exp(-coeff);
+            fResponse[i] = TMath::Exp(-coeff);
         }
     } else if (fShapingType == "shaper") {
         Nr = (Int_t)(5 * fShapingTime);
 
-        response.resize(Nr);
+        fResponse.resize(Nr);
 
         for (int i = 0; i < Nr; i++) {
             Double_t coeff = ((Double_t)i) / fShapingTime;
-            response[i] = TMath::Exp(-3. * coeff) * coeff * coeff * coeff;
+            Double_t power = 1;
+            for (int k = 0; k < fShapingOrder; k++) power *= coeff;
+            fResponse[i] = TMath::Exp(-fShapingOrder * coeff) * power;
         }
     } else if (fShapingType == "shaperSin") {
         Nr = (Int_t)(5 * fShapingTime);
 
-        response.resize(Nr);
+        fResponse.resize(Nr);
 
         for (int i = 0; i < Nr; i++) {
             Double_t coeff = ((Double_t)i) / fShapingTime;
-            response[i] = TMath::Exp(-3. * coeff) * coeff * coeff * coeff * sin(coeff);
+            fResponse[i] = TMath::Exp(-3. * coeff) * coeff * coeff * coeff * sin(coeff);
         }
     } else {
-        if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Warning)
-            cout << "REST WARNING. Shaping type : " << fShapingType << " is not defined!!" << endl;
-        return nullptr;
+        RESTWarning << "Shaping type : " << fShapingType << " is not defined!!" << RESTendl;
+        return;
     }
 
     // Making sure that response integral is 1, and applying the gain
     Double_t sum = 0;
-    for (int n = 0; n < Nr; n++) sum += response[n];
-    for (int n = 0; n < Nr; n++) response[n] = response[n] * fShapingGain / sum;
+    for (int n = 0; n < Nr; n++) sum += fResponse[n];
+    for (int n = 0; n < Nr; n++) fResponse[n] = fResponse[n] * fShapingGain / sum;
+}
 
-    for (int n = 0; n < fInputSignalEvent->GetNumberOfSignals(); n++) {
-        TRestRawSignal shapingSignal = TRestRawSignal();
-        TRestRawSignal inSignal = *fInputSignalEvent->GetSignal(n);
-        Int_t nBins = inSignal.GetNumberOfPoints();
-
-        vector<double> out(nBins);
-        for (int m = 0; m < nBins; m++) out[m] = 0;
-
-        for (int m = 0; m < nBins; m++) {
-            if (inSignal.GetData(m) >= 0) {
-                if (fShapingType == "gaus") {
-                    for (int n = -Nr / 2; m + n < nBins && n < Nr / 2; n++)
-                        if (m + n >= 0) out[m + n] += response[n + Nr / 2] * inSignal.GetData(m);
-                } else
-                    for (int n = 0; m + n < nBins && n < Nr; n++)
-                        out[m + n] += response[n] * inSignal.GetData(m);
-            }
+///////////////////////////////////////////////
+/// \brief The main processing event function
+///
+TRestEvent* TRestRawSignalShapingProcess::ProcessEvent(TRestEvent* inputEvent) {
+    fInputSignalEvent = (TRestRawSignalEvent*)inputEvent;
+
+    if (fInputSignalEvent->GetNumberOfSignals() <= 0) {
+        return nullptr;
+    }
+
+    if (fResponse.empty()) {
+        RESTWarning << "Shaping type : " << fShapingType << " is not defined!!" << RESTendl;
+        return nullptr;
+    }
+
+    if (fInPlace) {
+        for (int n = 0; n < fInputSignalEvent->GetNumberOfSignals(); n++) {
+            ProcessSignal(fInputSignalEvent->GetSignal(n));
         }
+        return fInputSignalEvent;
+    }
+
+    for (int n = 0; n < fInputSignalEvent->GetNumberOfSignals(); n++) {
+        const TRestRawSignal* inSignal = fInputSignalEvent->GetSignal(n);
+        const Int_t nBins = inSignal->GetNumberOfPoints();
 
+        ConvoluteSignal(inSignal);
+
+        fShapedSignal.Initialize();
         for (int i = 0; i < nBins; i++) {
-            shapingSignal.AddPoint((Short_t)round(out[i]));
+            fShapedSignal.AddPoint((Short_t)round(fOutput[i]));
         }
-        shapingSignal.SetSignalID(inSignal.GetSignalID());
+        fShapedSignal.SetSignalID(inSignal->GetSignalID());
 
-        fOutputSignalEvent->AddSignal(shapingSignal);
+        fOutputSignalEvent->AddSignal(fShapedSignal);
     }
 
     return fOutputSignalEvent;
 }
 
+///////////////////////////////////////////////
+/// \brief It shapes the given signal, which is modified in place. The response
+/// must have been built at InitProcess.
+///
+void TRestRawSignalShapingProcess::ProcessSignal(TRestRawSignal* signal) {
+    const Int_t nBins = signal->GetNumberOfPoints();
+
+    ConvoluteSignal(signal);
+
+    Short_t* data = signal->GetSignalData();
+    for (int i = 0; i < nBins; i++) {
+        data[i] = (Short_t)round(fOutput[i]);
+    }
+    signal->ResetCalculatedValues();
+}
+
+///////////////////////////////////////////////
+/// \brief It convolutes the positive samples of the signal with the response
+/// using the selected engine. The result is left at fOutput.
+///
+void TRestRawSignalShapingProcess::ConvoluteSignal(const TRestRawSignal* signal) {
+    const Int_t nBins = signal->GetNumberOfPoints();
+
+    // Only the positive samples are convoluted
+    fInput.resize(nBins);
+    for (int m = 0; m < nBins; m++) {
+        Double_t data = signal->GetData(m);
+        fInput[m] = data >= 0 ? data : 0;
+    }
+
+    fOutput.assign(nBins, 0);
+    if (fUseIIR) {
+        FilterIIR(nBins);
+    } else if (fUseFFT) {
+        ConvoluteFFT(nBins);
+    } else {
+        ConvoluteDirect(nBins);
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief It adds the response of each input sample to the output. The inner
+/// loop runs over contiguous response and output bins, so that it can be
+/// vectorized by the compiler.
+///
+void TRestRawSignalShapingProcess::ConvoluteDirect(Int_t nBins) {
+    const Int_t Nr = fResponse.size();
+    const Double_t* response = fResponse.data();
+    const Double_t* in = fInput.data();
+    Double_t* out = fOutput.data();
+
+    for (int m = 0; m < nBins; m++) {
+        const Double_t value = in[m];
+        if (value == 0) continue;
+
+        // The response bins k that fall inside the signal, out[m - offset + k]
+        const Int_t shift = m - fResponseOffset;
+        const Int_t from = max(0, -shift);
+        const Int_t to = min(Nr, nBins - shift);
+        for (int k = from; k < to; k++) out[shift + k] += response[k] * value;
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief It obtains the convolution as the product of the input and response
+/// spectra. The input is zero padded so that the circular convolution is equal
+/// to the linear one.
+///
+/// The transforms use the FFT plans cached by TRestRawFFT for each thread. The
+/// response spectrum is built once for each FFT size.
+///
+void TRestRawSignalShapingProcess::ConvoluteFFT(Int_t nBins) {
+    const Int_t Nr = fResponse.size();
+
+    Int_t nfft = 1;
+    while (nfft < nBins + Nr - 1) nfft *= 2;
+
+    if (nfft != fNfft) {
+        fNfft = nfft;
+        fResponseFFT.ForwardFFT(fResponse, fNfft);
+    }
+
+    fSignalFFT.ForwardFFT(fInput, fNfft);
+
+    // Only the first fNfft/2+1 nodes are used by the backward transform
+    complex<Double_t>* spectrum = fSignalFFT.GetFrequency();
+    const complex<Double_t>* response = fResponseFFT.GetFrequency();
+    for (int i = 0; i <= fNfft / 2; i++) spectrum[i] *= response[i];
+
+    fSignalFFT.BackwardFFT();
+
+    // The result is shifted by the response offset
+    for (int i = 0; i < nBins && i + fResponseOffset < fNfft; i++)
+        fOutput[i] = fSignalFFT.GetTimeAmplitude(i + fResponseOffset);
+}
+
+///////////////////////////////////////////////
+/// \brief It applies the exponential or shaper response as a recursive (IIR)
+/// filter, with a cost proportional to the number of bins whatever the
+/// shaping time.
+///
+/// The exponential response a^i, with a = exp(-1/shapingTime), truncated at
+/// the same number of bins than the direct response, has the transfer function
+/// (1 - a^Nr z^-Nr) / (1 - a z^-1). The result is identical to the direct
+/// convolution.
+///
+/// The shaper response (i/shapingTime)^n exp(-n i/shapingTime) is proportional
+/// to i^n a^i, with a = exp(-n/shapingTime), whose transfer function is
+/// sum_k A(n,k) a^(k+1) z^-(k+1) / (1 - a z^-1)^(n+1), where A(n,k) are the
+/// Eulerian numbers. It is applied as the numerator followed by n+1 one pole
+/// filters. The response is not truncated, and it is normalized so that its
+/// integral is fShapingGain.
+///
+void TRestRawSignalShapingProcess::FilterIIR(Int_t nBins) {
+    const Double_t* in = fInput.data();
+    Double_t* out = fOutput.data();
+
+    if (fShapingType == "exponential") {
+        const Int_t Nr = fResponse.size();
+        const Double_t a = TMath::Exp(-1. / fShapingTime);
+        const Double_t aNr = TMath::Power(a, Nr);
+        const Double_t gain = fResponse.empty() ? 0 : fResponse[0];
+
+        Double_t y = 0;
+        for (int t = 0; t < nBins; t++) {
+            y = a * y + in[t];
+            if (t >= Nr) y -= aNr * in[t - Nr];
+            out[t] = gain * y;
+        }
+        return;
+    }
+
+    // Shaper, CR-RCn
+    const Int_t n = max(fShapingOrder, 0);
+    const Double_t a = TMath::Exp(-n / fShapingTime);
+
+    // The Eulerian numbers A(n,k), k = 0 ... n-1
+    vector<Double_t> eulerian(1, 1);
+    for (int m = 1; m <= n; m++) {
+        vector<Double_t> next(m, 0);
+        for (int k = 0; k < m; k++) {
+            if (k < (int)eulerian.size()) next[k] += (k + 1) * eulerian[k];
+            if (k > 0) next[k] += (m - k) * eulerian[k - 1];
+        }
+        eulerian = next;
+    }
+
+    // Numerator coefficients, b[j] multiplies z^-j, and the response integral
+    vector<Double_t> b(n + 1, 0);
+    Double_t sum = 0;
+    if (n == 0) {
+        b[0] = 1;
+        sum = 1. / (1 - a);
+    } else {
+        Double_t power = 1;
+        for (int k = 0; k < n; k++) {
+            power *= a;
+            b[k + 1] = eulerian[k] * power;
+            sum += b[k + 1];
+        }
+        sum /= TMath::Power(1 - a, n + 1);
+    }
+
+    for (int t = 0; t < nBins; t++) {
+        Double_t value = 0;
+        for (int j = 0; j <= n && j <= t; j++) value += b[j] * in[t - j];
+        out[t] = value;
+    }
+
+    for (int pole = 0; pole <= n; pole++)
+        for (int t = 1; t < nBins; t++) out[t] += a * out[t - 1];
+
+    const Double_t gain = fShapingGain / sum;
+    for (int t = 0; t < nBins; t++) out[t] *= gain;
+}
+
 ///////////////////////////////////////////////
 /// \brief Function to include required actions after all events have been
 /// processed.
@@ -0,0 +1,338 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+/// The TRestRawSignalTransformChainProcess applies several raw signal
+/// transforms to a TRestRawSignalEvent in a single pass. Each signal goes
+/// through all the processes of the chain before the next signal is
+/// processed, so that it stays in cache, and no intermediate event is built.
+///
+/// The processes of the chain are defined inside the process section, in
+/// the order they are applied, using the same definition than when they are
+/// added to the processing chain. The following processes are supported:
+///
+/// * TRestRawBaseLineCorrectionProcess
+/// * TRestRawSignalRangeReductionProcess
+/// * TRestRawSignalAddNoiseProcess
+/// * TRestRawSignalShapingProcess
+///
+/// \code
+/// <addProcess type="TRestRawSignalTransformChainProcess" name="chain" value="ON">
+///     <TRestRawBaseLineCorrectionProcess name="blCorrection" smoothingWindow="75" />
+///     <TRestRawSignalRangeReductionProcess name="range" resolutionInBits="10" />
+///     <TRestRawSignalAddNoiseProcess name="noise" noiseLevel="10" />
+///     <TRestRawSignalShapingProcess name="shaping" shapingType="shaper" shapingTime="10" />
+/// </addProcess>
+/// \endcode
+///
+/// The output signals are identical to the ones obtained when the same
+/// processes are added one after the other to the processing chain. An
+/// analysis process, such as TRestRawSignalAnalysisProcess, can be added
+/// after the chain as usual.
+///
+/// The following parameters are available:
+///
+/// * **inPlace**: If true, the signals are transformed inside the input
+/// event, which is returned as the output event. Otherwise each signal is
+/// copied once to the output event. By default false.
+/// * **keepIntermediateEvents**: If true, a copy of the signals is kept after
+/// each process of the chain, and it can be retrieved with
+/// GetIntermediateEvent. By default false.
+///
+/// <hr>
+///
+/// \warning **⚠ REST is under continuous development.** This documentation
+/// is offered to you by the REST community. Your HELP is needed to keep this
+/// code up to date. Your feedback will be worth to support this software, please
+/// report any problems/suggestions you may find while using it at [The REST Framework
+/// forum](http://ezpc10.unizar.es). You are welcome to contribute fixing typos,
+/// updating information or adding/proposing new contributions. See also our
+/// <a href="https://github.com/rest-for-physics/framework/blob/master/CONTRIBUTING.md">Contribution
+/// Guide</a>.
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: First implementation of TRestRawSignalTransformChainProcess.
+///
+/// \class      TRestRawSignalTransformChainProcess
+///
+/// <hr>
+///
+#include "TRestRawSignalTransformChainProcess.h"
+
+#include "TRestRawBaseLineCorrectionProcess.h"
+#include "TRestRawSignalAddNoiseProcess.h"
+#include "TRestRawSignalRangeReductionProcess.h"
+#include "TRestRawSignalShapingProcess.h"
+
+using namespace std;
+
+ClassImp(TRestRawSignalTransformChainProcess);
+
+///////////////////////////////////////////////
+/// \brief Default constructor
+///
+TRestRawSignalTransformChainProcess::TRestRawSignalTransformChainProcess() { Initialize(); }
+
+///////////////////////////////////////////////
+/// \brief Constructor loading data from a config file
+///
+/// If no configuration path is defined using TRestMetadata::SetConfigFilePath
+/// the path to the config file must be specified using full path, absolute or
+/// relative.
+///
+/// The default behaviour is that the config file must be specified with
+/// full path, absolute or relative.
+///
+/// \param configFilename A const char* giving the path to an RML file.
+///
+TRestRawSignalTransformChainProcess::TRestRawSignalTransformChainProcess(const char* configFilename) {
+    Initialize();
+
+    if (LoadConfigFromFile(configFilename) == -1) {
+        LoadDefaultConfig();
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief Default destructor
+///
+TRestRawSignalTransformChainProcess::~TRestRawSignalTransformChainProcess() {
+    delete fOutputEvent;
+    for (auto transform : fTransforms) delete transform;
+    for (auto event : fIntermediateEvents) delete event;
+}
+
+///////////////////////////////////////////////
+/// \brief Function to load the default config in absence of RML input
+///
+void TRestRawSignalTransformChainProcess::LoadDefaultConfig() {
+    SetName("transformChain-Default");
+    SetTitle("Default config");
+}
+
+///////////////////////////////////////////////
+/// \brief Function to initialize input/output event members and define the
+/// section name
+///
+void TRestRawSignalTransformChainProcess::Initialize() {
+    SetSectionName(this->ClassName());
+    SetLibraryVersion(LIBRARY_VERSION);
+
+    fInputEvent = nullptr;
+    fOutputEvent = new TRestRawSignalEvent();
+}
+
+///////////////////////////////////////////////
+/// \brief Function to load the configuration from an external configuration
+/// file.
+///
+/// If no configuration path is defined in TRestMetadata::SetConfigFilePath
+/// the path to the config file must be specified using full path, absolute or
+/// relative.
+///
+/// \param configFilename A const char* giving the path to an RML file.
+/// \param name The name of the specific metadata. It will be used to find the
+/// corresponding TRestRawSignalTransformChainProcess section inside the RML.
+///
+void TRestRawSignalTransformChainProcess::LoadConfig(const string& configFilename, const string& name) {
+    if (LoadConfigFromFile(configFilename, name) == -1) {
+        LoadDefaultConfig();
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief Function reading input parameters from the RML
+/// TRestRawSignalTransformChainProcess section. Each process section found
+/// inside is instantiated, configured from its section, and added to the chain.
+///
+void TRestRawSignalTransformChainProcess::InitFromConfigFile() {
+    fInPlace = StringToBool(GetParameter("inPlace", fInPlace));
+    fKeepIntermediateEvents = StringToBool(GetParameter("keepIntermediateEvents", fKeepIntermediateEvents));
+
+    for (TiXmlElement* element = fElement->FirstChildElement(); element != nullptr;
+         element = element->NextSiblingElement()) {
+        const string type = element->Value();
+
+        TRestEventProcess* process = nullptr;
+        if (type == "TRestRawBaseLineCorrectionProcess") {
+            process = new TRestRawBaseLineCorrectionProcess();
+        } else if (type == "TRestRawSignalRangeReductionProcess") {
+            process = new TRestRawSignalRangeReductionProcess();
+        } else if (type == "TRestRawSignalAddNoiseProcess") {
+            process = new TRestRawSignalAddNoiseProcess();
+        } else if (type == "TRestRawSignalShapingProcess") {
+            process = new TRestRawSignalShapingProcess();
+        } else {
+            if (type != "parameter")
+                RESTWarning << "Process " << type << " cannot be added to the transform chain. Skipping it."
+                            << RESTendl;
+            continue;
+        }
+
+        process->LoadConfigFromElement(element, fElementGlobal);
+        AddTransform(process);
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief It adds a process at the end of the chain. The chain takes the
+/// ownership of the process.
+///
+/// Only the processes providing a ProcessSignal method that modifies one
+/// signal in place can be added. Otherwise the process is deleted and false
+/// is returned.
+///
+Bool_t TRestRawSignalTransformChainProcess::AddTransform(TRestEventProcess* process) {
+    function<void(TRestRawSignal*)> kernel;
+    Bool_t rejectEmptyEvents = true;
+
+    if (auto baseLine = dynamic_cast<TRestRawBaseLineCorrectionProcess*>(process)) {
+        kernel = [baseLine](TRestRawSignal* signal) { baseLine->ProcessSignal(signal); };
+        fBaseLineCorrections.push_back(baseLine);
+        rejectEmptyEvents = false;
+    } else if (auto rangeReduction = dynamic_cast<TRestRawSignalRangeReductionProcess*>(process)) {
+        kernel = [rangeReduction](TRestRawSignal* signal) { rangeReduction->ProcessSignal(signal); };
+    } else if (auto addNoise = dynamic_cast<TRestRawSignalAddNoiseProcess*>(process)) {
+        kernel = [addNoise](TRestRawSignal* signal) { addNoise->ProcessSignal(signal); };
+        fAddNoises.push_back(addNoise);
+    } else if (auto shaping = dynamic_cast<TRestRawSignalShapingProcess*>(process)) {
+        kernel = [shaping](TRestRawSignal* signal) { shaping->ProcessSignal(signal); };
+        fShapings.push_back(shaping);
+    } else {
+        RESTWarning << "Process " << process->ClassName() << " cannot be added to the transform chain."
+                    << RESTendl;
+        delete process;
+        return false;
+    }
+
+    fTransforms.push_back(process);
+    fTransformTypes.push_back(process->ClassName());
+    fKernels.push_back(kernel);
+    fRejectEmptyEvents = fRejectEmptyEvents || rejectEmptyEvents;
+
+    return true;
+}
+
+///////////////////////////////////////////////
+/// \brief Process initialization. The processes of the chain are initialized
+/// in order.
+///
+void TRestRawSignalTransformChainProcess::InitProcess() {
+    for (auto transform : fTransforms) transform->InitProcess();
+
+    for (auto shaping : fShapings) {
+        if (shaping->GetResponse().empty())
+            RESTWarning << "Shaping type : " << shaping->GetShapingType() << " is not defined!!" << RESTendl;
+    }
+
+    for (auto event : fIntermediateEvents) delete event;
+    fIntermediateEvents.clear();
+    if (fKeepIntermediateEvents) {
+        for (size_t n = 0; n < fTransforms.size(); n++)
+            fIntermediateEvents.push_back(new TRestRawSignalEvent());
+    }
+}
+
+///////////////////////////////////////////////
+/// \brief The main processing event function
+///
+TRestEvent* TRestRawSignalTransformChainProcess::ProcessEvent(TRestEvent* inputEvent) {
+    fInputEvent = dynamic_cast<TRestRawSignalEvent*>(inputEvent);
+
+    const auto run = GetRunInfo();
+    if (run != nullptr) {
+        fInputEvent->InitializeReferences(run);
+    }
+
+    if (fReadoutMetadata == nullptr) {
+        fReadoutMetadata = fInputEvent->GetReadoutMetadata();
+        for (auto baseLine : fBaseLineCorrections) baseLine->SetReadoutMetadata(fReadoutMetadata);
+    }
+
+    // Same event selection than the processes of the chain
+    if (fRejectEmptyEvents && fInputEvent->GetNumberOfSignals() <= 0) {
+        return nullptr;
+    }
+
+    for (auto shaping : fShapings) {
+        if (shaping->GetResponse().empty()) return nullptr;
+    }
+
+    for (auto addNoise : fAddNoises) addNoise->SetEventKey(fInputEvent);
+
+    for (auto event : fIntermediateEvents) {
+        event->Initialize();
+        event->SetEventInfo(fInputEvent);
+    }
+
+    for (int n = 0; n < fInputEvent->GetNumberOfSignals(); n++) {
+        TRestRawSignal* signal = fInputEvent->GetSignal(n);
+
+        if (!fInPlace) {
+            const Int_t nSignals = fOutputEvent->GetNumberOfSignals();
+            fOutputEvent->AddSignal(*signal);
+            if (fOutputEvent->GetNumberOfSignals() == nSignals) continue;
+            signal = fOutputEvent->GetSignal(nSignals);
+        }
+
+        for (size_t k = 0; k < fKernels.size(); k++) {
+            fKernels[k](signal);
+            if (fKeepIntermediateEvents) fIntermediateEvents[k]->AddSignal(*signal);
+        }
+    }
+
+    if (fInPlace) return fInputEvent;
+
+    return fOutputEvent;
+}
+
+///////////////////////////////////////////////
+/// \brief Function to include required actions after all events have been
+/// processed.
+///
+void TRestRawSignalTransformChainProcess::EndProcess() {
+    for (auto transform : fTransforms) transform->EndProcess();
+}
+
+///////////////////////////////////////////////
+/// \brief It prints out the process parameters stored in the metadata
+/// structure, followed by the metadata of each process of the chain.
+///
+void TRestRawSignalTransformChainProcess::PrintMetadata() {
+    BeginPrintProcess();
+
+    RESTMetadata << "In place : " << (fInPlace ? "true" : "false") << RESTendl;
+    RESTMetadata << "Keep intermediate events : " << (fKeepIntermediateEvents ? "true" : "false")
+                 << RESTendl;
+    RESTMetadata << "Transforms : ";
+    for (const auto& type : fTransformTypes) RESTMetadata << type << " ";
+    RESTMetadata << RESTendl;
+
+    EndPrintProcess();
+
+    for (auto transform : fTransforms) transform->PrintMetadata();
+}
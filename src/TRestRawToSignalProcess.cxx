@@ -26,6 +26,89 @@
 ///
 /// DOCUMENTATION TO BE WRITTEN (main description, methods, data members)
 ///
+/// ### Compressed input files
+///
+/// Input files ending in `.gz`, `.zst` or `.lz4` are decompressed on the fly
+/// by a helper thread (see OpenRawFile), so that archived raw data can be
+/// processed without decompressing it first to scratch disk. The gzip format
+/// is always available, zstd and lz4 require the corresponding libraries to
+/// be found at compilation time.
+///
+/// A truncated or corrupted compressed file is reported to the decoder as a
+/// read error (ferror) once the valid part of the file has been read.
+///
+/// For compressed files, GetTotalBytes and GetTotalBytesRead report bytes on
+/// disk, i.e. compressed bytes, so that the progress estimation remains valid.
+/// Note that GetTotalBytesRead used to count the bytes seen by the decoder for
+/// any file. Those are now given by GetTotalUncompressedBytesRead, which is
+/// the value to use e.g. to compute the decoding rate. Both are the same for
+/// uncompressed files.
+///
+/// ### Skipping channels at decoding time
+///
+/// Channels that are not needed can be skipped by the decoders, so that their
+/// samples are not decoded nor copied to the output event. The MultiFEMINOS,
+/// MultiCoBoAsAd, USTC and FEUDream decoders support it. Channels are
+/// given by daq id, by range or by type (using TRestRawReadoutMetadata), as a
+/// list of channels to keep and/or a list of channels to skip.
+///
+/// \code
+/// <keepChannels type="tpc" />
+/// <skipChannel id="17" />
+/// <skipChannels range="(67,76)" />
+/// <skipChannels type="veto" />
+/// \endcode
+///
+/// If the parameter `skipRemovedChannels` is set to true, the channels removed
+/// by a TRestRawSignalRemoveChannelsProcess later in the processing chain are
+/// skipped too. This is only correct if the processes in between do not use
+/// those channels.
+///
+/// ### Selecting events at decoding time
+///
+/// For quick-look processing the decoders may skip events without decoding
+/// them. The following parameters are available:
+///
+/// * **firstEvent** and **lastEvent**: the range of event ids to be decoded.
+/// The reading stops once an event id larger than lastEvent is found.
+/// * **prescale**: only one of every `prescale` events found in the input is
+/// decoded.
+/// * **timeWindow**: the range of event timestamps to be decoded.
+///
+/// \code
+/// <parameter name="prescale" value="100" />
+/// <parameter name="lastEvent" value="50000" />
+/// \endcode
+///
+/// The MultiCoBoAsAd decoder jumps over the payload of rejected events using
+/// the frame length fields, so that those bytes are not even read from regular
+/// files. The MultiFEMINOS decoder in TCM mode does the same only for the built
+/// events rejected by the prescale. The id and timestamp of an event are only
+/// known once its first frame is read, so the events outside the
+/// firstEvent/lastEvent or timeWindow selection are still read frame by frame,
+/// and only their samples are jumped over. The MultiFEMINOS decoder in single
+/// mode jumps over the samples of any rejected event, and the USTC decoder does
+/// not build their signals. Other decoders ignore these parameters.
+///
+/// ### Opening the input files
+///
+/// By default the input files are opened on demand through GetInputFile. The
+/// next file is pre-opened and prefetched while the current one is being
+/// decoded, and finished files are closed in GoToNextFile. This keeps a
+/// bounded number of file descriptors for runs with thousands of subrun
+/// files. The total number of bytes is still obtained from the file sizes
+/// when the files are added. The MultiCoBoAsAd electronics reads all its
+/// files in parallel, so that they are all opened before the first event is
+/// decoded, and each one is closed when it is finished.
+///
+/// The previous behaviour, where all the files are opened when they are added,
+/// is recovered setting the parameter `keepFilesOpen` to true. The FEUDream
+/// electronics always opens the files on demand.
+///
+/// \code
+/// <parameter name="keepFilesOpen" value="true" />
+/// \endcode
+///
 /// <hr>
 ///
 /// \warning **⚠ REST is under continuous development.** This
@@ -58,12 +141,415 @@
 ///
 #include "TRestRawToSignalProcess.h"
 
+#include <TRestRawReadoutMetadata.h>
+#include <TRestRawSignalRemoveChannelsProcess.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifdef REST_RAW_ZLIB
+#include <zlib.h>
+#endif
+#ifdef REST_RAW_ZSTD
+#include <zstd.h>
+#endif
+#ifdef REST_RAW_LZ4
+#include <lz4frame.h>
+#endif
+
 using namespace std;
 
 #include "TTimeStamp.h"
 
+namespace {
+
+enum class RawCompression { kNone, kGzip, kZstd, kLz4 };
+
+RawCompression GetRawCompression(const string& file) {
+    auto endsWith = [&file](const string& ext) {
+        return file.size() > ext.size() && file.compare(file.size() - ext.size(), ext.size(), ext) == 0;
+    };
+    if (endsWith(".gz") || endsWith(".gzip")) return RawCompression::kGzip;
+    if (endsWith(".zst") || endsWith(".zstd")) return RawCompression::kZstd;
+    if (endsWith(".lz4")) return RawCompression::kLz4;
+    return RawCompression::kNone;
+}
+
+/// A streaming decoder for one of the supported compression formats. Feed receives the next block of
+/// compressed bytes and calls emit for each block of decompressed bytes it produces. Finish is called
+/// once the input is exhausted, to drain the output still held by the decompressor. Both return false
+/// on a decompression error, on a truncated input, or if emit returned false.
+class RawDecoder {
+   public:
+    typedef std::function<bool(const char*, size_t)> Emitter;
+    virtual ~RawDecoder() {}
+    virtual bool Feed(const char* in, size_t size, const Emitter& emit) = 0;
+    virtual bool Finish(const Emitter& emit) = 0;
+    virtual void Reset() = 0;
+};
+
+#ifdef REST_RAW_ZLIB
+class RawGzipDecoder : public RawDecoder {
+    z_stream fStream;
+    vector<char> fOut;
+    // True if part of a gzip member has been read, but not its end
+    bool fInMember = false;
+
+    int Inflate(const Emitter& emit, bool& emitted, size_t& produced) {
+        fStream.next_out = (Bytef*)fOut.data();
+        fStream.avail_out = fOut.size();
+        const uInt availIn = fStream.avail_in;
+        int ret = inflate(&fStream, Z_NO_FLUSH);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) return ret;
+        produced = fOut.size() - fStream.avail_out;
+        emitted = produced == 0 || emit(fOut.data(), produced);
+        if (fStream.avail_in < availIn) fInMember = true;
+        // Concatenated gzip members are allowed, as produced by pigz or by cat
+        if (ret == Z_STREAM_END) {
+            inflateReset(&fStream);
+            fInMember = false;
+        }
+        return ret;
+    }
+
+   public:
+    RawGzipDecoder() : fOut(1 << 18) {
+        fStream = {};
+        // 15 + 32 enables automatic gzip/zlib header detection
+        inflateInit2(&fStream, 15 + 32);
+    }
+    ~RawGzipDecoder() { inflateEnd(&fStream); }
+    void Reset() override {
+        inflateReset(&fStream);
+        fInMember = false;
+    }
+    bool Feed(const char* in, size_t size, const Emitter& emit) override {
+        fStream.next_in = (Bytef*)in;
+        fStream.avail_in = size;
+        // A full output buffer might leave decompressed data inside zlib, even with no input left
+        while (fStream.avail_in > 0 || fStream.avail_out == 0) {
+            bool emitted;
+            size_t produced;
+            int ret = Inflate(emit, emitted, produced);
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) return false;
+            if (!emitted) return false;
+            if (ret == Z_BUF_ERROR && produced == 0) break;
+        }
+        return true;
+    }
+    bool Finish(const Emitter& emit) override {
+        fStream.next_in = nullptr;
+        fStream.avail_in = 0;
+        while (fInMember) {
+            bool emitted;
+            size_t produced;
+            int ret = Inflate(emit, emitted, produced);
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) return false;
+            if (!emitted) return false;
+            // No progress before Z_STREAM_END means the last member is truncated
+            if (fInMember && produced == 0) return false;
+        }
+        return true;
+    }
+};
+#endif
+
+#ifdef REST_RAW_ZSTD
+class RawZstdDecoder : public RawDecoder {
+    ZSTD_DCtx* fContext;
+    vector<char> fOut;
+    // The last value returned by ZSTD_decompressStream. It is 0 once a frame is fully decoded and flushed
+    size_t fLastRet = 0;
+
+   public:
+    RawZstdDecoder() : fContext(ZSTD_createDCtx()), fOut(ZSTD_DStreamOutSize()) {}
+    ~RawZstdDecoder() { ZSTD_freeDCtx(fContext); }
+    void Reset() override {
+        ZSTD_DCtx_reset(fContext, ZSTD_reset_session_only);
+        fLastRet = 0;
+    }
+    bool Feed(const char* in, size_t size, const Emitter& emit) override {
+        ZSTD_inBuffer input = {in, size, 0};
+        // A full output buffer might leave decompressed data inside zstd, even with no input left
+        bool outputFull = false;
+        while (input.pos < input.size || outputFull) {
+            ZSTD_outBuffer output = {fOut.data(), fOut.size(), 0};
+            size_t ret = ZSTD_decompressStream(fContext, &output, &input);
+            if (ZSTD_isError(ret)) return false;
+            fLastRet = ret;
+            if (output.pos > 0 && !emit(fOut.data(), output.pos)) return false;
+            // A 0 return means the frame is complete, and a new one must not be started without input
+            outputFull = output.pos == output.size && ret != 0;
+        }
+        return true;
+    }
+    bool Finish(const Emitter& emit) override {
+        ZSTD_inBuffer input = {nullptr, 0, 0};
+        while (fLastRet != 0) {
+            ZSTD_outBuffer output = {fOut.data(), fOut.size(), 0};
+            size_t ret = ZSTD_decompressStream(fContext, &output, &input);
+            if (ZSTD_isError(ret)) return false;
+            fLastRet = ret;
+            if (output.pos > 0 && !emit(fOut.data(), output.pos)) return false;
+            // Without more input the frame cannot be completed, i.e. it is truncated
+            if (output.pos < output.size) break;
+        }
+        return fLastRet == 0;
+    }
+};
+#endif
+
+#ifdef REST_RAW_LZ4
+class RawLz4Decoder : public RawDecoder {
+    LZ4F_dctx* fContext = nullptr;
+    vector<char> fOut;
+    // The last value returned by LZ4F_decompress. It is 0 once a frame is fully decoded and flushed
+    size_t fLastRet = 0;
+
+    bool Decompress(const char* in, size_t& inSize, const Emitter& emit, bool& outputFull) {
+        size_t outSize = fOut.size();
+        size_t ret = LZ4F_decompress(fContext, fOut.data(), &outSize, in, &inSize, nullptr);
+        if (LZ4F_isError(ret)) return false;
+        fLastRet = ret;
+        if (outSize > 0 && !emit(fOut.data(), outSize)) return false;
+        // A 0 return means the frame is complete, and a new one must not be started without input
+        outputFull = outSize == fOut.size() && ret != 0;
+        return true;
+    }
+
+   public:
+    RawLz4Decoder() : fOut(1 << 18) { LZ4F_createDecompressionContext(&fContext, LZ4F_VERSION); }
+    ~RawLz4Decoder() { LZ4F_freeDecompressionContext(fContext); }
+    void Reset() override {
+        LZ4F_resetDecompressionContext(fContext);
+        fLastRet = 0;
+    }
+    bool Feed(const char* in, size_t size, const Emitter& emit) override {
+        size_t pos = 0;
+        // A full output buffer might leave decompressed data inside lz4, even with no input left
+        bool outputFull = false;
+        while (pos < size || outputFull) {
+            size_t inSize = size - pos;
+            if (!Decompress(in + pos, inSize, emit, outputFull)) return false;
+            pos += inSize;
+        }
+        return true;
+    }
+    bool Finish(const Emitter& emit) override {
+        while (fLastRet != 0) {
+            size_t inSize = 0;
+            bool outputFull;
+            if (!Decompress(nullptr, inSize, emit, outputFull)) return false;
+            // Without more input the frame cannot be completed, i.e. it is truncated
+            if (!outputFull) break;
+        }
+        return fLastRet == 0;
+    }
+};
+#endif
+
+RawDecoder* CreateRawDecoder(RawCompression type) {
+    switch (type) {
+#ifdef REST_RAW_ZLIB
+        case RawCompression::kGzip:
+            return new RawGzipDecoder();
+#endif
+#ifdef REST_RAW_ZSTD
+        case RawCompression::kZstd:
+            return new RawZstdDecoder();
+#endif
+#ifdef REST_RAW_LZ4
+        case RawCompression::kLz4:
+            return new RawLz4Decoder();
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+/// A read-only stream returning the decompressed content of a file. The decompression runs in a helper
+/// thread that keeps a bounded queue of decompressed blocks ahead of the reader. The stream is exposed
+/// to the decoders as a standard FILE*, so that fread, feof, fclose, ftell and rewind keep working.
+///
+/// The byte counters of the owning process are only updated from the reader side.
+class RawCompressedStream {
+    struct Block {
+        vector<char> data;
+        size_t offset = 0;
+        Long64_t compressedBytes = 0;
+    };
+
+    static constexpr size_t kReadSize = 1 << 20;
+    static constexpr size_t kMaxQueuedBytes = 16 << 20;
+
+    FILE* fSource;
+    std::unique_ptr<RawDecoder> fDecoder;
+
+    Long64_t* fCompressedBytesRead;
+    Long64_t* fDecompressedBytesRead;
+    Long64_t fPosition = 0;
+
+    std::thread fWorker;
+    std::mutex fMutex;
+    std::condition_variable fCondition;
+    std::deque<Block> fBlocks;
+    size_t fQueuedBytes = 0;
+    bool fFinished = false;
+    bool fFailed = false;
+    bool fStop = false;
+
+    void Work() {
+        vector<char> in(kReadSize);
+        Long64_t pendingCompressed = 0;
+
+        auto emit = [&](const char* data, size_t size) {
+            std::unique_lock<std::mutex> lock(fMutex);
+            fCondition.wait(lock, [&] { return fStop || fQueuedBytes < kMaxQueuedBytes; });
+            if (fStop) return false;
+            Block block;
+            block.data.assign(data, data + size);
+            block.compressedBytes = pendingCompressed;
+            pendingCompressed = 0;
+            fQueuedBytes += size;
+            fBlocks.push_back(std::move(block));
+            fCondition.notify_all();
+            return true;
+        };
+
+        bool ok = true;
+        while (ok) {
+            size_t n = fread(in.data(), 1, in.size(), fSource);
+            if (n == 0) break;
+            pendingCompressed += n;
+            ok = fDecoder->Feed(in.data(), n, emit);
+        }
+        if (ok && !ferror(fSource)) ok = fDecoder->Finish(emit);
+
+        std::lock_guard<std::mutex> lock(fMutex);
+        if (!fStop) {
+            fFailed = !ok || ferror(fSource);
+            // The tail of the input that did not produce any output is accounted with the last block
+            if (pendingCompressed > 0) {
+                fBlocks.emplace_back();
+                fBlocks.back().compressedBytes = pendingCompressed;
+            }
+        }
+        fFinished = true;
+        fCondition.notify_all();
+    }
+
+    void Start() {
+        fBlocks.clear();
+        fQueuedBytes = 0;
+        fFinished = false;
+        fFailed = false;
+        fStop = false;
+        fPosition = 0;
+        fWorker = std::thread(&RawCompressedStream::Work, this);
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(fMutex);
+            fStop = true;
+            fCondition.notify_all();
+        }
+        if (fWorker.joinable()) fWorker.join();
+    }
+
+   public:
+    RawCompressedStream(FILE* source, RawDecoder* decoder, Long64_t* compressed, Long64_t* decompressed)
+        : fSource(source),
+          fDecoder(decoder),
+          fCompressedBytesRead(compressed),
+          fDecompressedBytesRead(decompressed) {
+        Start();
+    }
+
+    ~RawCompressedStream() {
+        Stop();
+        fclose(fSource);
+    }
+
+    Long64_t Read(char* buffer, size_t size) {
+        size_t copied = 0;
+        std::unique_lock<std::mutex> lock(fMutex);
+        while (copied < size) {
+            fCondition.wait(lock, [&] { return !fBlocks.empty() || fFinished; });
+            if (fBlocks.empty()) break;
+
+            Block& block = fBlocks.front();
+            size_t n = std::min(size - copied, block.data.size() - block.offset);
+            std::copy_n(block.data.begin() + block.offset, n, buffer + copied);
+            block.offset += n;
+            copied += n;
+
+            if (block.offset == block.data.size()) {
+                *fCompressedBytesRead += block.compressedBytes;
+                fQueuedBytes -= block.data.size();
+                fBlocks.pop_front();
+                fCondition.notify_all();
+            }
+        }
+        if (copied == 0 && fFailed) return -1;
+
+        *fDecompressedBytesRead += copied;
+        fPosition += copied;
+        return copied;
+    }
+
+    /// Only rewinding and querying the current position are supported
+    Long64_t Seek(Long64_t offset, int whence) {
+        if (whence == SEEK_CUR && offset == 0) return fPosition;
+        if (whence == SEEK_SET && offset == 0) {
+            Stop();
+            rewind(fSource);
+            fDecoder->Reset();
+            Start();
+            return 0;
+        }
+        errno = ESPIPE;
+        return -1;
+    }
+};
+
+#if defined(__linux__)
+ssize_t RawStreamRead(void* cookie, char* buffer, size_t size) {
+    return ((RawCompressedStream*)cookie)->Read(buffer, size);
+}
+int RawStreamSeek(void* cookie, off64_t* offset, int whence) {
+    Long64_t position = ((RawCompressedStream*)cookie)->Seek(*offset, whence);
+    if (position < 0) return -1;
+    *offset = position;
+    return 0;
+}
+int RawStreamClose(void* cookie) {
+    delete (RawCompressedStream*)cookie;
+    return 0;
+}
+#elif defined(__APPLE__)
+int RawStreamRead(void* cookie, char* buffer, int size) {
+    return ((RawCompressedStream*)cookie)->Read(buffer, size);
+}
+fpos_t RawStreamSeek(void* cookie, fpos_t offset, int whence) {
+    return ((RawCompressedStream*)cookie)->Seek(offset, whence);
+}
+int RawStreamClose(void* cookie) {
+    delete (RawCompressedStream*)cookie;
+    return 0;
+}
+#endif
+
+}  // namespace
+
 ClassImp(TRestRawToSignalProcess);
 
 TRestRawToSignalProcess::TRestRawToSignalProcess() { Initialize(); }
@@ -99,7 +585,7 @@ void TRestRawToSignalProcess::Initialize() {
 
     fSingleThreadOnly = true;
     fIsExternal = true;
-    fgKeepFileOpen = true;
+    fgKeepFileOpen = false;
 
     totalBytes = 0;
     totalbytesRead = 0;
@@ -107,6 +593,39 @@ void TRestRawToSignalProcess::Initialize() {
 
 void TRestRawToSignalProcess::InitFromConfigFile() {
     fElectronicsType = GetParameter("electronics");
+    fgKeepFileOpen = StringToBool(GetParameter("keepFilesOpen", "false"));
+    fSkipRemovedChannels = StringToBool(GetParameter("skipRemovedChannels", "false"));
+
+    fFirstEvent = StringToInteger(GetParameter("firstEvent", "0"));
+    fLastEvent = StringToInteger(GetParameter("lastEvent", "-1"));
+    fPrescale = StringToInteger(GetParameter("prescale", "1"));
+    if (fPrescale < 1) fPrescale = 1;
+    fTimeWindow = StringTo2DVector(GetParameter("timeWindow", "(-1,-1)"));
+
+    // Channels to be decoded, or to be skipped by the decoder
+    for (const string key : {"keepChannel", "skipChannel"}) {
+        set<Int_t>& ids = key == "keepChannel" ? fChannelIdsToKeep : fChannelIdsToSkip;
+        vector<string>& types = key == "keepChannel" ? fChannelTypesToKeep : fChannelTypesToSkip;
+
+        size_t pos = 0;
+        string definition;
+        while (!(definition = GetKEYDefinition(key, pos)).empty()) {
+            Int_t id = StringToInteger(GetFieldValue("id", definition));
+            if (id >= 0) ids.insert(id);
+        }
+
+        pos = 0;
+        while (!(definition = GetKEYDefinition(key + "s", pos)).empty()) {
+            TVector2 v = StringTo2DVector(GetFieldValue("range", definition));
+            if (v.X() >= 0 && v.Y() >= 0 && v.Y() > v.X()) {
+                for (int n = (Int_t)v.X(); n <= (Int_t)v.Y(); n++) ids.insert(n);
+            }
+
+            string type = GetFieldValue("type", definition);
+            if (!type.empty() && type != "Not defined") types.push_back(type);
+        }
+    }
+
     fShowSamples = StringToInteger(GetParameter("showSamples", "10"));
     fMinPoints = StringToInteger(GetParameter("minPoints", "512"));
 
@@ -136,17 +655,21 @@ void TRestRawToSignalProcess::LoadDefaultConfig() {
 
 Bool_t TRestRawToSignalProcess::OpenInputFiles(const vector<string>& files) {
     nFiles = 0;
+    iCurFile = 0;
     fInputFiles.clear();
     fInputFileNames.clear();
+    fInputFileOpened.clear();
     totalBytes = 0;
     totalbytesRead = 0;
+    fCompressedBytesRead = 0;
+    fDecompressedBytesRead = 0;
 
     for (const auto& file : files) {
         AddInputFile(file);
     }
 
     if (nFiles > 0) {
-        fInputBinFile = fInputFiles[0];
+        fInputBinFile = GetInputFile(0);
     } else {
         RESTError << "No input file is opened, in process: " << this->ClassName() << "!" << RESTendl;
         exit(1);
@@ -164,19 +687,23 @@ Bool_t TRestRawToSignalProcess::AddInputFile(const string& file) {
         }
     }
 
-    FILE* f = fopen(file.c_str(), "rb");
+    // If files are not kept open they will be opened on demand by GetInputFile
+    struct stat statbuf;
+    FILE* f = nullptr;
+    if (fgKeepFileOpen) f = OpenRawFile(file);
 
-    if (f == nullptr) {
-        RESTWarning << "REST WARNING. Input file for " << this->ClassName() << " does not exist!" << RESTendl;
+    if ((fgKeepFileOpen && f == nullptr) || stat(file.c_str(), &statbuf) != 0) {
+        RESTWarning << "REST WARNING. Input file for " << this->ClassName() << " could not be opened!"
+                    << RESTendl;
         RESTWarning << "File : " << file << RESTendl;
+        if (f != nullptr) fclose(f);
         return false;
     }
 
     fInputFiles.push_back(f);
     fInputFileNames.push_back(file);
+    fInputFileOpened.push_back(f != nullptr);
 
-    struct stat statbuf;
-    stat(file.c_str(), &statbuf);
     totalBytes += statbuf.st_size;
 
     nFiles++;
@@ -184,12 +711,226 @@ Bool_t TRestRawToSignalProcess::AddInputFile(const string& file) {
     return true;
 }
 
+///////////////////////////////////////////////
+/// \brief It moves the reading position nBytes forward, without decoding them.
+///
+/// It seeks over regular files. Streams that cannot seek, such as compressed
+/// inputs, are read into a scratch buffer instead. It returns false if the end
+/// of the file is reached before.
+///
+Bool_t TRestRawToSignalProcess::SkipInputBytes(FILE* f, Long64_t nBytes) {
+    if (f == nullptr) return false;
+    if (nBytes <= 0) return true;
+
+    if (fileno(f) >= 0 && fseek(f, nBytes, SEEK_CUR) == 0) {
+        totalbytesRead += nBytes;
+        return true;
+    }
+
+    char buffer[65536];
+    while (nBytes > 0) {
+        size_t n = fread(buffer, 1, min(nBytes, (Long64_t)sizeof(buffer)), f);
+        if (n == 0) return false;
+        nBytes -= n;
+        totalbytesRead += n;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////
+/// \brief It builds the lookup table used by IsChannelSkipped.
+///
+/// Channel types are resolved into daq ids through the TRestRawReadoutMetadata
+/// found in the run. If `skipRemovedChannels` is enabled, the channel ids and
+/// types removed by a TRestRawSignalRemoveChannelsProcess in the same
+/// processing chain are also skipped. It must be called at InitProcess.
+///
+void TRestRawToSignalProcess::InitChannelFilter() {
+    fChannelSkipMask.clear();
+    fSkipUnlistedChannels = false;
+
+    set<Int_t> idsToKeep = fChannelIdsToKeep;
+    set<Int_t> idsToSkip = fChannelIdsToSkip;
+    vector<string> typesToSkip = fChannelTypesToSkip;
+
+    if (fSkipRemovedChannels) {
+        auto removeProcess = dynamic_cast<TRestRawSignalRemoveChannelsProcess*>(
+            GetFriendLive("TRestRawSignalRemoveChannelsProcess"));
+        if (removeProcess == nullptr) {
+            RESTWarning << "TRestRawToSignalProcess. skipRemovedChannels is enabled but no "
+                           "TRestRawSignalRemoveChannelsProcess was found"
+                        << RESTendl;
+        } else {
+            for (const auto& id : removeProcess->GetChannelIds()) idsToSkip.insert(id);
+            for (const auto& type : removeProcess->GetChannelTypes()) typesToSkip.push_back(type);
+        }
+    }
+
+    if (!fChannelTypesToKeep.empty() || !typesToSkip.empty()) {
+        TRestRawReadoutMetadata* readoutMetadata = nullptr;
+        if (fRunInfo != nullptr)
+            readoutMetadata =
+                dynamic_cast<TRestRawReadoutMetadata*>(fRunInfo->GetMetadataClass("TRestRawReadoutMetadata"));
+
+        if (readoutMetadata == nullptr) {
+            RESTError << "TRestRawToSignalProcess::InitChannelFilter: readout metadata is null, cannot "
+                         "filter the channels by type"
+                      << RESTendl;
+            exit(1);
+        }
+
+        for (const auto& type : fChannelTypesToKeep)
+            for (const auto& id : readoutMetadata->GetChannelDaqIDsForType(type)) idsToKeep.insert(id);
+        for (const auto& type : typesToSkip)
+            for (const auto& id : readoutMetadata->GetChannelDaqIDsForType(type)) idsToSkip.insert(id);
+
+        if (!fChannelTypesToKeep.empty() && idsToKeep.empty())
+            RESTWarning << "TRestRawToSignalProcess. No channels found for the types to keep" << RESTendl;
+    }
+
+    if (idsToKeep.empty() && idsToSkip.empty()) return;
+
+    Int_t maxId = 0;
+    if (!idsToKeep.empty()) maxId = max(maxId, *idsToKeep.rbegin());
+    if (!idsToSkip.empty()) maxId = max(maxId, *idsToSkip.rbegin());
+
+    fSkipUnlistedChannels = !idsToKeep.empty();
+    fChannelSkipMask.assign(maxId + 1, fSkipUnlistedChannels);
+    for (const auto& id : idsToKeep) fChannelSkipMask[id] = false;
+    for (const auto& id : idsToSkip) fChannelSkipMask[id] = true;
+
+    RESTDebug << "TRestRawToSignalProcess. Channels to keep : " << idsToKeep.size()
+              << ", channels to skip : " << idsToSkip.size() << RESTendl;
+}
+
+///////////////////////////////////////////////
+/// \brief It returns true if the file extension corresponds to one of the
+/// compressed formats supported by OpenRawFile (.gz, .zst and .lz4).
+///
+Bool_t TRestRawToSignalProcess::IsCompressedFile(const string& file) {
+    return GetRawCompression(file) != RawCompression::kNone;
+}
+
+///////////////////////////////////////////////
+/// \brief It opens a raw input file for reading.
+///
+/// Files with a `.gz`, `.zst` or `.lz4` extension are decompressed on the fly
+/// by a helper thread, so that the decoders read the uncompressed content
+/// through the returned FILE* without any intermediate file on disk. The
+/// decompression runs ahead of the decoder, trading an additional core for
+/// less I/O. Only sequential reading and rewinding are supported on those
+/// streams.
+///
+/// It returns nullptr if the file cannot be opened, or if the library was
+/// compiled without support for its compression format.
+///
+FILE* TRestRawToSignalProcess::OpenRawFile(const string& file) {
+    FILE* f = fopen(file.c_str(), "rb");
+    RawCompression type = GetRawCompression(file);
+    if (f == nullptr || type == RawCompression::kNone) return f;
+
+#if defined(__linux__) || defined(__APPLE__)
+    RawDecoder* decoder = CreateRawDecoder(type);
+    if (decoder == nullptr) {
+        RESTError << "TRestRawToSignalProcess. The library was compiled without support for the compression "
+                     "format of file: "
+                  << file << RESTendl;
+        fclose(f);
+        return nullptr;
+    }
+
+    auto stream = new RawCompressedStream(f, decoder, &fCompressedBytesRead, &fDecompressedBytesRead);
+#if defined(__linux__)
+    cookie_io_functions_t functions = {RawStreamRead, nullptr, RawStreamSeek, RawStreamClose};
+    return fopencookie(stream, "rb", functions);
+#else
+    return funopen(stream, RawStreamRead, nullptr, RawStreamSeek, RawStreamClose);
+#endif
+#else
+    RESTError << "TRestRawToSignalProcess. Compressed input files are not supported in this platform"
+              << RESTendl;
+    fclose(f);
+    return nullptr;
+#endif
+}
+
+///////////////////////////////////////////////
+/// \brief It returns the input file with index n, opening it if it was not
+/// opened before.
+///
+/// When the files are not kept open (`keepFilesOpen` set to false), the
+/// following file is also pre-opened and its reading is anticipated (see
+/// PrefetchInputFile), so that the decoder does not wait for it once the
+/// current file is finished. It returns nullptr if the file was already
+/// closed.
+///
+FILE* TRestRawToSignalProcess::GetInputFile(Int_t n) {
+    if (n < 0 || n >= nFiles) return nullptr;
+
+    if (!fInputFileOpened[n]) {
+        fInputFiles[n] = OpenRawFile(fInputFileNames[n]);
+        fInputFileOpened[n] = true;
+        if (fInputFiles[n] == nullptr)
+            RESTWarning << "Input file could not be opened : " << fInputFileNames[n] << RESTendl;
+    }
+
+    if (!fgKeepFileOpen) PrefetchInputFile(n + 1);
+
+    return fInputFiles[n];
+}
+
+///////////////////////////////////////////////
+/// \brief It opens in advance the input file with index n.
+///
+/// The kernel is advised to start reading the file contents. In the case of
+/// compressed files the decompression thread starts immediately, so that the
+/// first blocks are already available when the decoder reaches the file.
+///
+void TRestRawToSignalProcess::PrefetchInputFile(Int_t n) {
+    if (n < 0 || n >= nFiles || fInputFileOpened[n]) return;
+
+    fInputFiles[n] = OpenRawFile(fInputFileNames[n]);
+    fInputFileOpened[n] = true;
+
+#ifdef POSIX_FADV_WILLNEED
+    if (fInputFiles[n] != nullptr && fileno(fInputFiles[n]) >= 0)
+        posix_fadvise(fileno(fInputFiles[n]), 0, 0, POSIX_FADV_WILLNEED);
+#endif
+}
+
+///////////////////////////////////////////////
+/// \brief It closes the input file with index n, once the decoder finished
+/// reading it.
+///
+void TRestRawToSignalProcess::CloseInputFile(Int_t n) {
+    if (n < 0 || n >= nFiles) return;
+
+    if (fInputFiles[n] != nullptr) {
+        if (fInputBinFile == fInputFiles[n]) fInputBinFile = nullptr;
+        fclose(fInputFiles[n]);
+        fInputFiles[n] = nullptr;
+    }
+    fInputFileOpened[n] = true;
+}
+
 Bool_t TRestRawToSignalProcess::ResetEntry() {
+    // Files opened on demand are closed and the reading starts again from the first one
+    if (!fgKeepFileOpen) {
+        for (int n = 0; n < nFiles; n++) {
+            CloseInputFile(n);
+            fInputFileOpened[n] = false;
+        }
+        iCurFile = 0;
+        fInputBinFile = GetInputFile(0);
+    }
+
     for (auto f : fInputFiles) {
         if (f != nullptr) {
             if (fseek(f, 0, 0) != 0) return false;
         }
     }
+    fCompressedBytesRead = 0;
+    fDecompressedBytesRead = 0;
     InitProcess();
 
     return true;
@@ -204,6 +945,18 @@ void TRestRawToSignalProcess::PrintMetadata() {
     RESTMetadata << "Electronics type : " << fElectronicsType << RESTendl;
     RESTMetadata << "Minimum number of points : " << fMinPoints << RESTendl;
     RESTMetadata << "All raw files open at beginning : " << fgKeepFileOpen << RESTendl;
+    if (!fChannelIdsToKeep.empty() || !fChannelTypesToKeep.empty())
+        RESTMetadata << "Channels to keep : " << fChannelIdsToKeep.size() << " ids, "
+                     << fChannelTypesToKeep.size() << " types" << RESTendl;
+    if (!fChannelIdsToSkip.empty() || !fChannelTypesToSkip.empty())
+        RESTMetadata << "Channels to skip : " << fChannelIdsToSkip.size() << " ids, "
+                     << fChannelTypesToSkip.size() << " types" << RESTendl;
+    if (fSkipRemovedChannels) RESTMetadata << "Skipping channels removed downstream" << RESTendl;
+    if (fFirstEvent > 0 || fLastEvent >= 0)
+        RESTMetadata << "Event id range : (" << fFirstEvent << ", " << fLastEvent << ")" << RESTendl;
+    if (fPrescale > 1) RESTMetadata << "Prescale : " << fPrescale << RESTendl;
+    if (fTimeWindow.X() != -1 || fTimeWindow.Y() != -1)
+        RESTMetadata << "Time window : (" << fTimeWindow.X() << ", " << fTimeWindow.Y() << ")" << RESTendl;
     RESTMetadata << " ==================================== " << RESTendl;
 
     RESTMetadata << " " << RESTendl;
@@ -217,8 +970,8 @@ Bool_t TRestRawToSignalProcess::GoToNextFile() {
         if (fgKeepFileOpen) {
             fInputBinFile = fInputFiles[iCurFile];
         } else {
-            fclose(fInputBinFile);
-            fInputBinFile = fopen(fInputFileNames[iCurFile].c_str(), "rb");
+            CloseInputFile(iCurFile - 1);
+            fInputBinFile = GetInputFile(iCurFile);
         }
         RESTInfo << "GoToNextFile(): Going to the next raw input file number " << iCurFile << " over "
                  << nFiles << RESTendl;
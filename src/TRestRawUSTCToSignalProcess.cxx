@@ -102,6 +102,7 @@ void TRestRawUSTCToSignalProcess::InitProcess() {
     }
 
     fRunOrigin = fRunInfo->GetRunNumber();
+    InitChannelFilter();
     fCurrentFile = 0;
     fCurrentBuffer = 0;
     totalbytesRead = 0;
@@ -140,6 +141,13 @@ TRestEvent* TRestRawUSTCToSignalProcess::ProcessEvent(TRestEvent* inputEvent) {
             RESTDebug << "Blank event " << fCurrentEvent << " !" << RESTendl;
             fCurrentEvent++;
             ClearBuffer();
+        } else if (SkipByPrescale() ||
+                   IsEventOutOfSelection(
+                       fCurrentEvent, (fTimeOffset + fEventBuffer[fCurrentBuffer][0].eventTime) * 1.e-9)) {
+            // The frames of events rejected by the event selection are not built into signals
+            if (IsSelectionFinished(fCurrentEvent)) return nullptr;
+            fCurrentEvent++;
+            ClearBuffer();
         } else {
             break;
         }
@@ -296,6 +304,8 @@ bool TRestRawUSTCToSignalProcess::OpenNextFile(USTCDataFrame& frame) {
     if (fCurrentFile < (int)fInputFiles.size() - 1)  // try to get frame form next file
     {
         fCurrentFile++;
+        // In case the files are opened on demand
+        GetInputFile(fCurrentFile);
         return GetNextFrame(frame);
     } else {
         return false;
@@ -493,6 +503,9 @@ bool TRestRawUSTCToSignalProcess::ReadFrameData(USTCDataFrame& frame) {
     fChannelOffset.insert(frame.boardId * 4 * 68 + frame.chipId * 68);
 #endif
 
+    // The samples of skipped channels are not decoded, AddBuffer will discard the frame
+    if (IsChannelSkipped(frame.signalId)) return true;
+
     // sampling point data
     for (int i = 0; i < 512; i++) {
         int pos = i * 2 + DATA_OFFSET;
@@ -515,6 +528,8 @@ bool TRestRawUSTCToSignalProcess::ReadFrameData(USTCDataFrame& frame) {
 }
 
 bool TRestRawUSTCToSignalProcess::AddBuffer(USTCDataFrame& frame) {
+    if (IsChannelSkipped(frame.signalId)) return true;
+
 #ifdef Incoherent_Event_Generation
     if (frame.evId == fCurrentEvent) {
         fEventBuffer[fCurrentBuffer].push_back(frame);
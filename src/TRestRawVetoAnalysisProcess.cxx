@@ -199,7 +199,39 @@ void TRestRawVetoAnalysisProcess::LoadConfig(const string& configFilename, const
 /// \brief Function to use in initialization of process members before starting
 /// to process the event
 ///
-void TRestRawVetoAnalysisProcess::InitProcess() {}
+/// The veto groups are parsed here into a table giving the group of each signal
+/// id, and the observable names of each group are built.
+///
+void TRestRawVetoAnalysisProcess::InitProcess() {
+    fVetoGroupIndex.clear();
+    fPeakTime.clear();
+    fPeakAmp.clear();
+
+    if (!fVetoSignalId.empty() && fVetoSignalId[0] != -1) {
+        for (double id : fVetoSignalId) AddVetoToGroup((Int_t)id, 0);
+        fPeakTime.push_back("PeakTime");
+        fPeakAmp.push_back("MaxPeakAmplitude");
+    } else {
+        for (unsigned int i = 0; i < fVetoGroupNames.size(); i++) {
+            for (double id : StringToElements(fVetoGroupIds[i], ",")) AddVetoToGroup((Int_t)id, i);
+            fPeakTime.push_back("PeakTime_" + fVetoGroupNames[i]);
+            fPeakAmp.push_back("MaxPeakAmplitude_" + fVetoGroupNames[i]);
+        }
+    }
+
+    fGroupPeakTime.assign(fPeakTime.size(), {});
+    fGroupMaxPeakAmplitude.assign(fPeakAmp.size(), {});
+}
+
+///////////////////////////////////////////////
+/// \brief It assigns the signal id to a veto group. A signal stays in the first group
+/// it was assigned to.
+///
+void TRestRawVetoAnalysisProcess::AddVetoToGroup(Int_t signalId, Int_t group) {
+    if (signalId < 0) return;
+    if (signalId >= (Int_t)fVetoGroupIndex.size()) fVetoGroupIndex.resize(signalId + 1, -1);
+    if (fVetoGroupIndex[signalId] == -1) fVetoGroupIndex[signalId] = group;
+}
 
 ///////////////////////////////////////////////
 /// \brief Function to initialize input/output event members and define the
@@ -223,9 +255,6 @@ TRestEvent* TRestRawVetoAnalysisProcess::ProcessEvent(TRestEvent* inputEvent) {
         fSignalEvent->InitializeReferences(run);
     }
 
-    map<int, Double_t> VetoMaxPeakAmplitude_map;
-    map<int, Double_t> VetoPeakTime_map;
-
     Int_t VetoAboveThreshold = 0;
     Int_t NVetoAboveThreshold = 0;
     Int_t VetoInTimeWindow = 0;
@@ -233,145 +262,96 @@ TRestEvent* TRestRawVetoAnalysisProcess::ProcessEvent(TRestEvent* inputEvent) {
 
     fSignalEvent->SetRange(fRange);
 
-    VetoMaxPeakAmplitude_map.clear();
-    VetoPeakTime_map.clear();
-
     // **************************************************************
-    // if list of veto Ids without groups is given ******************
+    // if no vetoes are given, they are the veto channels of the readout
     // **************************************************************
 
     if (fReadoutMetadata == nullptr) {
         fReadoutMetadata = fSignalEvent->GetReadoutMetadata();
-    }
 
-    if (fReadoutMetadata != nullptr && fVetoSignalId[0] == -1) {
-        // iterate over signals and get type
-        fVetoSignalId.clear();
-        for (int i = 0; i < fSignalEvent->GetNumberOfSignals(); i++) {
-            TRestRawSignal* signal = fSignalEvent->GetSignal(i);
-            auto channelType = fReadoutMetadata->GetTypeForChannelDaqId(signal->GetID());
-            // uppercase
-            transform(channelType.begin(), channelType.end(), channelType.begin(), ::toupper);
-            if (channelType == "VETO") {
-                fVetoSignalId.push_back(signal->GetID());
+        if (fReadoutMetadata != nullptr && fVetoSignalId[0] == -1 && fVetoGroupNames.empty()) {
+            fVetoSignalId.clear();
+            for (const auto& [daqId, info] : fReadoutMetadata->fChannelInfo) {
+                string channelType = info.type;
+                // uppercase
+                transform(channelType.begin(), channelType.end(), channelType.begin(), ::toupper);
+                if (channelType == "VETO") {
+                    fVetoSignalId.push_back(daqId);
+                }
             }
+            if (fVetoSignalId.empty()) fVetoSignalId.push_back(-1);
+            InitProcess();
         }
     }
 
-    if (fVetoSignalId[0] != -1) {
-        // iterate over vetoes
-        for (double i : fVetoSignalId) {
-            // Checks if channel (fVetoSignalId) participated in the event. If not, it
-            // is -1
-            if (fSignalEvent->GetSignalIndex(i) != -1) {
-                // We extract the parameters from the veto signal
-                TRestRawSignal* signal = fSignalEvent->GetSignalById(i);
-                // Deal with noise
-                signal->CalculateBaseLine(fBaseLineRange.X(), fBaseLineRange.Y(), "ROBUST");
-                signal->InitializePointsOverThreshold(TVector2(fPointThreshold, fSignalThreshold),
-                                                      fPointsOverThreshold);
-
-                // Save two maps with (veto panel ID, max amplitude) and (veto panel ID, peak time)
-                if (signal->GetPointsOverThreshold().size() >= (unsigned int)fPointsOverThreshold) {
-                    // signal is not noise
-                    VetoMaxPeakAmplitude_map[i] = signal->GetMaxPeakValue();
-                } else {
-                    // signal is noise
-                    VetoMaxPeakAmplitude_map[i] = 0;
-                }
-                VetoPeakTime_map[i] = signal->GetMaxPeakBin();
-                // We remove the signal from the event
-                fSignalEvent->RemoveSignalWithId(i);
-
-                // check if signal is above threshold
-                if (signal->GetMaxPeakValue() > fThreshold) {
-                    VetoAboveThreshold = 1;
-                    NVetoAboveThreshold += 1;
-                }
-                // check if signal is in time window
-                if (signal->GetMaxPeakBin() > fTimeWindow[0] && signal->GetMaxPeakBin() < fTimeWindow[1]) {
-                    VetoInTimeWindow = 1;
-                    NVetoInTimeWindow += 1;
-                }
-            }
+    if (fGroupPeakTime.empty()) InitProcess();
+
+    for (auto& peakTime : fGroupPeakTime) peakTime.clear();
+    for (auto& maxPeakAmplitude : fGroupMaxPeakAmplitude) maxPeakAmplitude.clear();
+
+    // **************************************************************
+    // the vetoes of every group are analysed in a single pass ******
+    // **************************************************************
+
+    const auto vetoGroup = [this](Int_t signalId) {
+        if (signalId < 0 || signalId >= (Int_t)fVetoGroupIndex.size()) return -1;
+        return fVetoGroupIndex[signalId];
+    };
+
+    for (int s = 0; s < fSignalEvent->GetNumberOfSignals(); s++) {
+        TRestRawSignal* signal = fSignalEvent->GetSignal(s);
+        const Int_t signalId = signal->GetID();
+        const Int_t group = vetoGroup(signalId);
+        if (group == -1) {
+            continue;
+        }
+
+        // Deal with noise
+        signal->CalculateBaseLine(fBaseLineRange.X(), fBaseLineRange.Y(), "ROBUST");
+        signal->InitializePointsOverThreshold(TVector2(fPointThreshold, fSignalThreshold),
+                                              fPointsOverThreshold);
+
+        const Double_t maxPeakValue = signal->GetMaxPeakValue();
+        const Int_t maxPeakBin = signal->GetMaxPeakBin();
+
+        // Save two maps with (veto panel ID, max amplitude) and (veto panel ID, peak time)
+        if (signal->GetPointsOverThreshold().size() >= (unsigned int)fPointsOverThreshold) {
+            // signal is not noise
+            fGroupMaxPeakAmplitude[group][signalId] = maxPeakValue;
+        } else {
+            // signal is noise
+            fGroupMaxPeakAmplitude[group][signalId] = 0;
         }
+        fGroupPeakTime[group][signalId] = maxPeakBin;
 
-        SetObservableValue("PeakTime", VetoPeakTime_map);
-        SetObservableValue("MaxPeakAmplitude", VetoMaxPeakAmplitude_map);
-        if (fThreshold != -1) {
-            SetObservableValue("VetoAboveThreshold", VetoAboveThreshold);
-            SetObservableValue("NvetoAboveThreshold", NVetoAboveThreshold);
+        // check if signal is above threshold
+        if (maxPeakValue > fThreshold) {
+            VetoAboveThreshold = 1;
+            NVetoAboveThreshold += 1;
         }
-        if (fTimeWindow[0] != -1) {
-            SetObservableValue("VetoInTimeWindow", VetoInTimeWindow);
-            SetObservableValue("NVetoInTimeWindow", NVetoInTimeWindow);
+        // check if signal is in time window
+        if (maxPeakBin > fTimeWindow[0] && maxPeakBin < fTimeWindow[1]) {
+            VetoInTimeWindow = 1;
+            NVetoInTimeWindow += 1;
         }
     }
 
-    // ***************************************************************
-    // if the veto ids are defined within the veto groups ************
-    // ***************************************************************
+    // We remove the veto signals from the event
+    fSignalEvent->RemoveSignalsIf(
+        [&vetoGroup](const TRestRawSignal& signal) { return vetoGroup(signal.GetID()) != -1; });
 
-    // create observable names for veto groups
-    for (const auto& fVetoGroupName : fVetoGroupNames) {
-        fPeakTime.push_back("PeakTime_" + fVetoGroupName);
-        fPeakAmp.push_back("MaxPeakAmplitude_" + fVetoGroupName);
+    for (unsigned int i = 0; i < fGroupPeakTime.size(); i++) {
+        SetObservableValue(fPeakTime[i], fGroupPeakTime[i]);
+        SetObservableValue(fPeakAmp[i], fGroupMaxPeakAmplitude[i]);
     }
 
-    if (fVetoSignalId[0] == -1) {
-        // iterate over veto groups
-        for (unsigned int i = 0; i < fVetoGroupNames.size(); i++) {
-            // iterate over vetoes in each group
-            vector<double> groupIds = StringToElements(fVetoGroupIds[i], ",");
-            for (double groupId : groupIds) {
-                // Checks if channel (groupIds) participated in the event. If not, it is -1
-                if (fSignalEvent->GetSignalIndex(groupId) != -1) {
-                    // We extract the parameters from the veto signal
-                    TRestRawSignal* signal = fSignalEvent->GetSignalById(groupId);
-                    // Deal with noise
-                    signal->CalculateBaseLine(fBaseLineRange.X(), fBaseLineRange.Y(), "ROBUST");
-                    signal->InitializePointsOverThreshold(TVector2(fPointThreshold, fSignalThreshold),
-                                                          fPointsOverThreshold);
-                    // Save two maps with (veto panel ID, max amplitude) and (veto panel ID, peak time)
-                    if (signal->GetPointsOverThreshold().size() >= (unsigned int)fPointsOverThreshold) {
-                        // signal is not noise
-                        VetoMaxPeakAmplitude_map[groupId] = signal->GetMaxPeakValue();
-                    } else {
-                        // signal is noise
-                        VetoMaxPeakAmplitude_map[groupId] = 0;
-                    }
-                    VetoPeakTime_map[groupId] = signal->GetMaxPeakBin();
-                    // We remove the signal from the event
-                    fSignalEvent->RemoveSignalWithId(groupId);
-
-                    // check if signal is above threshold
-                    if (signal->GetMaxPeakValue() > fThreshold) {
-                        VetoAboveThreshold = 1;
-                        NVetoAboveThreshold += 1;
-                    }
-                    // check if signal is in time window
-                    if (signal->GetMaxPeakBin() > fTimeWindow[0] &&
-                        signal->GetMaxPeakBin() < fTimeWindow[1]) {
-                        VetoInTimeWindow = 1;
-                        NVetoInTimeWindow += 1;
-                    }
-                }
-            }
-            SetObservableValue(fPeakTime[i], VetoPeakTime_map);
-            SetObservableValue(fPeakAmp[i], VetoMaxPeakAmplitude_map);
-
-            VetoMaxPeakAmplitude_map.clear();
-            VetoPeakTime_map.clear();
-        }
-
-        if (fThreshold != -1) {
-            SetObservableValue("VetoAboveThreshold", VetoAboveThreshold);
-            SetObservableValue("NvetoAboveThreshold", NVetoAboveThreshold);
-        }
-        if (fTimeWindow[0] != -1) {
-            SetObservableValue("VetoInTimeWindow", VetoInTimeWindow);
-            SetObservableValue("NVetoInTimeWindow", NVetoInTimeWindow);
-        }
+    if (fThreshold != -1) {
+        SetObservableValue("VetoAboveThreshold", VetoAboveThreshold);
+        SetObservableValue("NvetoAboveThreshold", NVetoAboveThreshold);
+    }
+    if (fTimeWindow[0] != -1) {
+        SetObservableValue("VetoInTimeWindow", VetoInTimeWindow);
+        SetObservableValue("NVetoInTimeWindow", NVetoInTimeWindow);
     }
 
     if (GetVerboseLevel() >= TRestStringOutput::REST_Verbose_Level::REST_Debug) {
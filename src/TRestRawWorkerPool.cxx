@@ -0,0 +1,145 @@
+/*************************************************************************
+ * This file is part of the REST software framework.                     *
+ *                                                                       *
+ * Copyright (C) 2016 GIFNA/TREX (University of Zaragoza)                *
+ * For more information see http://gifna.unizar.es/trex                  *
+ *                                                                       *
+ * REST is free software: you can redistribute it and/or modify          *
+ * it under the terms of the GNU General Public License as published by  *
+ * the Free Software Foundation, either version 3 of the License, or     *
+ * (at your option) any later version.                                   *
+ *                                                                       *
+ * REST is distributed in the hope that it will be useful,               *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ * GNU General Public License for more details.                          *
+ *                                                                       *
+ * You should have a copy of the GNU General Public License along with   *
+ * REST in $REST_PATH/LICENSE.                                           *
+ * If not, see http://www.gnu.org/licenses/.                             *
+ * For the list of contributors see $REST_PATH/CREDITS.                  *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+/// TRestRawWorkerPool keeps a set of threads that execute the same task, each
+/// one with its own index, every time Run is called. It is used by the
+/// processes that work on the signals of one event in parallel.
+///
+/// The threads are created once, usually at InitProcess, and they wait for the
+/// next task between events, so that no thread is created for each event.
+/// Since a given index always runs in the same thread, the state owned by
+/// each thread (e.g. the FFT plans cached by TRestRawFFT, or a fitter) is
+/// reused between events.
+///
+/// The calling thread runs the index 0, and Run returns once all the indices
+/// have finished. A pool with a single thread runs the task in the calling
+/// thread, without any synchronization.
+///
+/// \code
+/// TRestRawWorkerPool pool(4);
+/// pool.ForEach(event->GetNumberOfSignals(), [&](Int_t signal, Int_t thread) {
+///     fitters[thread].Fit(event->GetSignal(signal));
+/// });
+/// \endcode
+///
+///--------------------------------------------------------------------------
+///
+/// RESTsoft - Software for Rare Event Searches with TPCs
+///
+/// History of developments:
+///
+/// 2026-October: Extracted from TRestRawSignalFFTFilterProcess, to be shared
+///               by the multithreaded raw processes.
+///
+/// \class      TRestRawWorkerPool
+///
+/// <hr>
+///
+#include "TRestRawWorkerPool.h"
+
+using namespace std;
+
+ClassImp(TRestRawWorkerPool);
+
+///////////////////////////////////////////////
+/// \brief It starts nThreads - 1 threads, the calling thread being the first
+/// one. A value below 1 is taken as 1.
+///
+TRestRawWorkerPool::TRestRawWorkerPool(Int_t nThreads) {
+    for (int n = 1; n < nThreads; n++) fThreads.emplace_back(&TRestRawWorkerPool::Loop, this, n);
+}
+
+///////////////////////////////////////////////
+/// \brief It stops and joins the threads
+///
+TRestRawWorkerPool::~TRestRawWorkerPool() {
+    {
+        lock_guard<mutex> lock(fMutex);
+        fStop = true;
+    }
+    fWake.notify_all();
+    for (auto& thread : fThreads) thread.join();
+}
+
+///////////////////////////////////////////////
+/// \brief It runs task(n) in each thread n, the calling thread being n = 0,
+/// and waits for all of them.
+///
+void TRestRawWorkerPool::Run(const function<void(Int_t)>& task) {
+    if (fThreads.empty()) {
+        task(0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(fMutex);
+        fTask = &task;
+        fPending = fThreads.size();
+        fGeneration++;
+    }
+    fWake.notify_all();
+
+    task(0);
+
+    unique_lock<mutex> lock(fMutex);
+    fDone.wait(lock, [this] { return fPending == 0; });
+    fTask = nullptr;
+}
+
+///////////////////////////////////////////////
+/// \brief It calls work(item, thread) for every item from 0 to nItems - 1.
+/// The thread n works on the items n, n + nThreads, ...
+///
+void TRestRawWorkerPool::ForEach(Int_t nItems, const function<void(Int_t, Int_t)>& work) {
+    const Int_t nThreads = GetNumberOfThreads();
+    if (nThreads == 1 || nItems <= 1) {
+        for (int item = 0; item < nItems; item++) work(item, 0);
+        return;
+    }
+
+    Run([&](Int_t thread) {
+        for (int item = thread; item < nItems; item += nThreads) work(item, thread);
+    });
+}
+
+///////////////////////////////////////////////
+/// \brief The loop of the thread n, which waits for each new task
+///
+void TRestRawWorkerPool::Loop(Int_t thread) {
+    size_t generation = 0;
+    while (true) {
+        const function<void(Int_t)>* task;
+        {
+            unique_lock<mutex> lock(fMutex);
+            fWake.wait(lock, [&] { return fStop || fGeneration != generation; });
+            if (fStop) return;
+            generation = fGeneration;
+            task = fTask;
+        }
+
+        (*task)(thread);
+
+        lock_guard<mutex> lock(fMutex);
+        if (--fPending == 0) fDone.notify_one();
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef RestRawLib_RawSignalTestUtils
+#define RestRawLib_RawSignalTestUtils
+
+#include <TRestEventProcess.h>
+#include <TRestRawSignalEvent.h>
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+/// An event with one signal of nPoints for each id. The value of each bin is given by value(id, bin).
+inline TRestRawSignalEvent MakeRawSignalEvent(const std::vector<Int_t>& ids, Int_t nPoints,
+                                              const std::function<Double_t(Int_t, Int_t)>& value) {
+    TRestRawSignalEvent event;
+    for (const Int_t id : ids) {
+        TRestRawSignal signal;
+        for (int i = 0; i < nPoints; i++) signal.AddPoint(value(id, i));
+        signal.SetSignalID(id);
+        event.AddSignal(signal);
+    }
+    return event;
+}
+
+/// It checks that both events have the same signals, with the same data. If sameOrder is false the
+/// signals are matched by their id.
+inline void ExpectSameSignals(TRestRawSignalEvent* event, TRestRawSignalEvent* expected,
+                              bool sameOrder = true) {
+    ASSERT_TRUE(event != nullptr && expected != nullptr);
+    ASSERT_EQ(event->GetNumberOfSignals(), expected->GetNumberOfSignals());
+    if (sameOrder) EXPECT_EQ(event->GetSignalIds(), expected->GetSignalIds());
+
+    for (int s = 0; s < expected->GetNumberOfSignals(); s++) {
+        const TRestRawSignal* expectedSignal = expected->GetSignal(s);
+        const TRestRawSignal* signal = event->GetSignalById(expectedSignal->GetSignalID());
+        ASSERT_TRUE(signal != nullptr) << "signal " << expectedSignal->GetSignalID();
+        ASSERT_EQ(signal->GetNumberOfPoints(), expectedSignal->GetNumberOfPoints());
+        for (int i = 0; i < expectedSignal->GetNumberOfPoints(); i++)
+            EXPECT_EQ(signal->GetRawData(i), expectedSignal->GetRawData(i))
+                << "signal " << expectedSignal->GetSignalID() << ", bin " << i;
+    }
+}
+
+/// It processes copyInput with copy, and inPlaceInput with inPlace, which must have been set in place.
+/// It checks that only the process in place returns its input event, and returns both outputs.
+inline std::pair<TRestRawSignalEvent*, TRestRawSignalEvent*> ProcessCopyAndInPlace(
+    TRestEventProcess& copy, TRestRawSignalEvent& copyInput, TRestEventProcess& inPlace,
+    TRestRawSignalEvent& inPlaceInput) {
+    auto copyOutput = (TRestRawSignalEvent*)copy.ProcessEvent(&copyInput);
+    auto inPlaceOutput = (TRestRawSignalEvent*)inPlace.ProcessEvent(&inPlaceInput);
+    EXPECT_TRUE(copyOutput != nullptr && copyOutput != &copyInput);
+    EXPECT_EQ(inPlaceOutput, &inPlaceInput);
+    return {copyOutput, inPlaceOutput};
+}
+
+#endif
@@ -0,0 +1,39 @@
+#include <TRestRawBaseLineCorrectionProcess.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "RawSignalTestUtils.h"
+
+using namespace std;
+
+namespace {
+/// Signals with a slowly drifting baseline, some noise and a pulse
+TRestRawSignalEvent MakeEvent() {
+    return MakeRawSignalEvent({0, 1, 2, 3, 4, 5, 6, 7}, 512, [](Int_t id, Int_t i) {
+        Double_t value = 250 + 20 * sin(i / 40. + id) + (i * 7919 + id * 104729) % 11 - 5;
+        if (i >= 200 + id && i < 220 + id) value += 300;
+        return value;
+    });
+}
+}  // namespace
+
+TEST(TRestRawBaseLineCorrectionProcess, InPlaceMatchesCopy) {
+    TRestRawReadoutMetadata metadata;
+    for (int id = 0; id < 8; id++) metadata.fChannelInfo[id] = {"tpc", to_string(id), (UShort_t)id};
+
+    TRestRawBaseLineCorrectionProcess copy, inPlace;
+    inPlace.SetInPlace(true);
+    for (auto process : {&copy, &inPlace}) {
+        process->SetReadoutMetadata(&metadata);
+        process->InitProcess();
+    }
+
+    TRestRawSignalEvent copyInput = MakeEvent(), inPlaceInput = MakeEvent();
+    const auto [copyOutput, inPlaceOutput] = ProcessCopyAndInPlace(copy, copyInput, inPlace, inPlaceInput);
+    ExpectSameSignals(inPlaceOutput, copyOutput);
+
+    // The input event is not modified when the process is not in place
+    TRestRawSignalEvent original = MakeEvent();
+    ExpectSameSignals(&copyInput, &original);
+}
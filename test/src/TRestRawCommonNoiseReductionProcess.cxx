@@ -0,0 +1,70 @@
+#include <TRestRawCommonNoiseReductionProcess.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+
+#include "RawSignalTestUtils.h"
+
+namespace fs = std::filesystem;
+
+using namespace std;
+
+const auto filesPath = fs::path(__FILE__).parent_path().parent_path() / "files";
+const auto restRawCommonNoiseReductionProcessRml = filesPath / "TRestRawCommonNoiseReductionProcess.rml";
+
+namespace {
+const Int_t kNSignals = 20;
+
+/// Signals sharing a common noise, with a different offset and a pulse in some of them. The even
+/// channels are "tpc" channels, and the odd ones "veto" channels.
+TRestRawSignalEvent MakeEvent() {
+    vector<Int_t> ids;
+    for (int id = 0; id < kNSignals; id++) ids.push_back(id);
+    return MakeRawSignalEvent(ids, 512, [](Int_t id, Int_t i) {
+        Double_t value = 250 + id + 15 * sin(i / 7.) + (i * 7919 + id * 104729) % 7 - 3;
+        if (id % 4 == 0 && i >= 200 && i < 220) value += 400;
+        return value;
+    });
+}
+}  // namespace
+
+TEST(TRestRawCommonNoiseReductionProcess, TestFiles) {
+    EXPECT_TRUE(fs::exists(restRawCommonNoiseReductionProcessRml));
+}
+
+TEST(TRestRawCommonNoiseReductionProcess, InPlaceMatchesCopy) {
+    TRestRawReadoutMetadata metadata;
+    for (int id = 0; id < kNSignals; id++)
+        metadata.fChannelInfo[id] = {id % 2 == 0 ? "tpc" : "veto", to_string(id), (UShort_t)id};
+
+    TRestRawCommonNoiseReductionProcess copy(restRawCommonNoiseReductionProcessRml.c_str());
+    TRestRawCommonNoiseReductionProcess inPlace(restRawCommonNoiseReductionProcessRml.c_str());
+    inPlace.SetInPlace(true);
+    for (auto process : {&copy, &inPlace}) {
+        process->SetReadoutMetadata(&metadata);
+        process->InitProcess();
+    }
+
+    TRestRawSignalEvent copyInput = MakeEvent(), inPlaceInput = MakeEvent();
+    const auto [copyOutput, inPlaceOutput] = ProcessCopyAndInPlace(copy, copyInput, inPlace, inPlaceInput);
+    copy.EndProcess();
+    inPlace.EndProcess();
+
+    // Apart from the order, both modes give the same signals
+    ExpectSameSignals(inPlaceOutput, copyOutput, false);
+
+    // In place the signals keep their input order. Otherwise the ignored (veto) signals come first.
+    TRestRawSignalEvent original = MakeEvent();
+    vector<int> ignoredFirstIds;
+    for (int id = 1; id < kNSignals; id += 2) ignoredFirstIds.push_back(id);
+    for (int id = 0; id < kNSignals; id += 2) ignoredFirstIds.push_back(id);
+    EXPECT_EQ(inPlaceOutput->GetSignalIds(), original.GetSignalIds());
+    EXPECT_EQ(copyOutput->GetSignalIds(), ignoredFirstIds);
+
+    // The ignored signals are not modified
+    for (int id = 1; id < kNSignals; id += 2) {
+        for (int i = 0; i < original.GetSignal(id)->GetNumberOfPoints(); i++)
+            EXPECT_EQ(inPlaceOutput->GetSignalById(id)->GetRawData(i), original.GetSignal(id)->GetRawData(i));
+    }
+}
@@ -0,0 +1,89 @@
+#include <TRestRawMultiCoBoAsAdToSignalProcess.h>
+#include <TRestRun.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+using namespace std;
+
+namespace {
+const Int_t kNAsAds = 3;
+const Int_t kNEvents = 5;
+const Int_t kNBuckets = 64;
+
+/// The sample written for the given asad, event and bucket
+Int_t GetSample(Int_t asad, Int_t event, Int_t bucket) { return 100 * asad + 10 * event + bucket; }
+
+/// The channel (inside the asad) written for the given asad and event
+Int_t GetChannel(Int_t asad, Int_t event) { return 68 * (event % 4) + asad + 1; }
+
+/// It writes a .graw file with one partial readout frame per event, holding a single channel
+fs::path WriteAsAdFile(Int_t asad) {
+    const auto file = fs::temp_directory_path() / ("TRestRawMultiCoBoAsAdToSignalProcess_" +
+                                                   to_string(asad) + ".graw");
+    ofstream out(file, ios::binary);
+
+    const UInt_t nItems = kNBuckets;
+    const UInt_t frameSize = nItems * 4 + 256;
+    for (int event = 0; event < kNEvents; event++) {
+        unsigned char header[256] = {0};
+        header[0] = 0x08;
+        header[3] = frameSize / 256;
+        header[6] = 1;   // partial readout
+        header[7] = 5;   // revision
+        header[9] = 1;   // header size
+        header[11] = 4;  // item size
+        header[14] = nItems >> 8;
+        header[15] = nItems & 0xFF;
+        header[21] = 10 * event;  // event time
+        header[25] = event;
+        header[27] = asad;
+        out.write((const char*)header, sizeof(header));
+
+        const UInt_t channel = GetChannel(asad, event);
+        for (UInt_t bucket = 0; bucket < kNBuckets; bucket++) {
+            const UInt_t item = (channel / 68) << 30 | (channel % 68) << 23 | bucket << 14 |
+                                GetSample(asad, event, bucket);
+            const unsigned char bytes[4] = {(unsigned char)(item >> 24), (unsigned char)(item >> 16),
+                                            (unsigned char)(item >> 8), (unsigned char)item};
+            out.write((const char*)bytes, sizeof(bytes));
+        }
+    }
+    return file;
+}
+}  // namespace
+
+TEST(TRestRawMultiCoBoAsAdToSignalProcess, FilesOpenedOnDemand) {
+    vector<string> files;
+    for (int asad = 0; asad < kNAsAds; asad++) files.push_back(WriteAsAdFile(asad));
+
+    // Files are not kept open by default, so they are opened when the first event is read
+    TRestRawMultiCoBoAsAdToSignalProcess process;
+    TRestRun run;
+    process.SetRunInfo(&run);
+    EXPECT_TRUE(process.OpenInputFiles(files));
+    process.InitProcess();
+
+    for (int event = 0; event < kNEvents; event++) {
+        auto signalEvent = (TRestRawSignalEvent*)process.ProcessEvent(nullptr);
+        ASSERT_NE(signalEvent, nullptr);
+        EXPECT_EQ(signalEvent->GetID(), event);
+
+        // Every asad file contributes its channel to every event
+        ASSERT_EQ(signalEvent->GetNumberOfSignals(), kNAsAds);
+        for (int asad = 0; asad < kNAsAds; asad++) {
+            TRestRawSignal* signal = signalEvent->GetSignalById(GetChannel(asad, event) + 272 * asad);
+            ASSERT_NE(signal, nullptr);
+            for (int bucket = 0; bucket < kNBuckets; bucket++)
+                EXPECT_EQ(signal->GetRawData(bucket), GetSample(asad, event, bucket));
+        }
+    }
+
+    EXPECT_EQ(process.ProcessEvent(nullptr), nullptr);
+    process.EndProcess();
+
+    for (const auto& file : files) fs::remove(file);
+}
@@ -0,0 +1,58 @@
+#include <TRestRawPhiloxRandom.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+TEST(TRestRawPhiloxRandom, KnownAnswers) {
+    // Philox4x32-10 known answer tests from the Random123 library
+    const UInt_t counters[][4] = {{0x00000000, 0x00000000, 0x00000000, 0x00000000},
+                                  {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                  {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}};
+    const UInt_t keys[][2] = {{0x00000000, 0x00000000}, {0xffffffff, 0xffffffff}, {0xa4093822, 0x299f31d0}};
+    const UInt_t expected[][4] = {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+                                  {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+                                  {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+
+    for (int n = 0; n < 3; n++) {
+        UInt_t result[4];
+        TRestRawPhiloxRandom::Generate(counters[n], keys[n], result);
+        for (int i = 0; i < 4; i++) EXPECT_EQ(result[i], expected[n][i]);
+
+        TRestRawPhiloxRandom random(keys[n][0], keys[n][1]);
+        random.Generate(counters[n], result);
+        for (int i = 0; i < 4; i++) EXPECT_EQ(result[i], expected[n][i]);
+    }
+}
+
+TEST(TRestRawPhiloxRandom, Gaussian) {
+    const Int_t nValues = 100001;
+    const Double_t sigma = 10;
+
+    TRestRawPhiloxRandom random(17, 5);
+    vector<Double_t> values(nValues);
+    random.FillGaussian(values.data(), nValues, 1, 2, 3, sigma);
+
+    Double_t sum = 0, sum2 = 0;
+    for (const auto value : values) {
+        sum += value;
+        sum2 += value * value;
+    }
+    EXPECT_NEAR(sum / nValues, 0, 5 * sigma / sqrt(nValues));
+    EXPECT_NEAR(sqrt(sum2 / nValues), sigma, 0.01 * sigma);
+
+    // The values only depend on the key, the streams and their position
+    vector<Double_t> prefix(100);
+    random.FillGaussian(prefix.data(), prefix.size(), 1, 2, 3, sigma);
+    for (size_t i = 0; i < prefix.size(); i++) EXPECT_EQ(prefix[i], values[i]);
+
+    vector<Double_t> other(100);
+    random.FillGaussian(other.data(), other.size(), 1, 3, 3, sigma);
+    EXPECT_NE(other, prefix);
+
+    random.SetKey(18, 5);
+    random.FillGaussian(other.data(), other.size(), 1, 2, 3, sigma);
+    EXPECT_NE(other, prefix);
+}
@@ -0,0 +1,24 @@
+#include <TRestRawPulseFitter.h>
+#include <gtest/gtest.h>
+
+using namespace std;
+
+TEST(TRestRawPulseFitter, RecoverParameters) {
+    const Double_t parameters[][TRestRawPulseFitter::kNParameters] = {
+        {250, 2000, 70, 80}, {0, 40000, 75, 70}, {250, 5000, 10, 200}, {300, 3000, 30, 30}};
+
+    TRestRawPulseFitter fitter;
+    for (const auto& par : parameters) {
+        TRestRawSignal signal;
+        for (int i = 0; i < 512; i++) signal.AddPoint((Short_t)round(TRestRawPulseFitter::Evaluate(i, par)));
+
+        EXPECT_TRUE(fitter.Fit(&signal));
+
+        // Only the rounding of the signal values limits the precision
+        EXPECT_NEAR(fitter.GetParameter(TRestRawPulseFitter::kBaseline), par[0], 0.5);
+        EXPECT_NEAR(fitter.GetParameter(TRestRawPulseFitter::kAmplitude), par[1], 0.005 * par[1]);
+        EXPECT_NEAR(fitter.GetParameter(TRestRawPulseFitter::kShapingTime), par[2], 0.005 * par[2]);
+        EXPECT_NEAR(fitter.GetParameter(TRestRawPulseFitter::kStartPosition), par[3], 0.5);
+        EXPECT_LT(fitter.GetChiSquare() / 512, 0.25);
+    }
+}
@@ -0,0 +1,32 @@
+#include <TRestRawPulseFitter.h>
+#include <TRestRawPulseTemplateBank.h>
+#include <gtest/gtest.h>
+
+using namespace std;
+
+TEST(TRestRawPulseTemplateBank, Evaluate) {
+    TRestRawPulseTemplateBank bank;
+    EXPECT_FALSE(bank.IsBuilt());
+    bank.Build();
+    EXPECT_TRUE(bank.IsBuilt());
+
+    // Without gaussian width the table is the pulse itself
+    for (double u = -1; u < 10; u += 0.013)
+        EXPECT_NEAR(bank.Evaluate(u, 0), TRestRawPulseFitter::Shape(u), 1.e-5) << "u " << u;
+
+    // The convolution with a normalized gaussian keeps the pulse integral
+    for (const double s : {0.1, 0.35, 0.8}) {
+        double pulse = 0, convoluted = 0;
+        for (double u = -5; u < 15; u += 0.01) {
+            pulse += TRestRawPulseFitter::Shape(u);
+            convoluted += bank.Evaluate(u, s);
+        }
+        EXPECT_NEAR(convoluted, pulse, 1.e-3 * pulse) << "s " << s;
+    }
+
+    // The derivative in u
+    double dGdu = 0;
+    const double s = 0.25, u = 1.5, h = 1.e-3;
+    bank.Evaluate(u, s, &dGdu);
+    EXPECT_NEAR(dGdu, (bank.Evaluate(u + h, s) - bank.Evaluate(u - h, s)) / (2 * h), 1.e-4);
+}
@@ -2,6 +2,8 @@
 #include <TRestRawSignal.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using namespace std;
 
 TEST(TRestRawSignal, Default) {
@@ -9,3 +11,44 @@ TEST(TRestRawSignal, Default) {
 
     EXPECT_TRUE(rawSignal.GetIntegral() == 0);
 }
+
+TEST(TRestRawSignal, SmoothedMedian) {
+    TRestRawSignal rawSignal;
+    for (int i = 0; i < 512; i++) {
+        Short_t value = 250 + (i * 7) % 11 - 5;
+        if (i >= 200 && i < 220) value += 1000;
+        rawSignal.AddPoint(value);
+    }
+
+    const Int_t window = 75;
+    const vector<Float_t> smoothed = rawSignal.GetSignalSmoothed(window, "MEDIAN");
+    ASSERT_EQ((Int_t)smoothed.size(), rawSignal.GetNumberOfPoints());
+
+    // Same result than the median of the window centered at each point
+    const Int_t half = window / 2;
+    for (int i = 0; i < rawSignal.GetNumberOfPoints(); i++) {
+        const Int_t center = min(max(i, half), rawSignal.GetNumberOfPoints() - 1 - half);
+        vector<Double_t> values;
+        for (int j = center - half; j <= center + half; j++) values.push_back(rawSignal.GetRawData(j));
+        nth_element(values.begin(), values.begin() + half, values.end());
+        EXPECT_EQ(smoothed[i], values[half]) << "bin " << i;
+    }
+
+    // The pulse is shorter than half the window, so that it does not change the baseline
+    for (int i = 0; i < rawSignal.GetNumberOfPoints(); i++) {
+        EXPECT_LE(abs(smoothed[i] - 250), 5) << "bin " << i;
+    }
+}
+
+TEST(TRestRawSignal, SmoothedMedianNonPositiveWindow) {
+    TRestRawSignal rawSignal;
+    for (int i = 0; i < 64; i++) rawSignal.AddPoint((Short_t)(250 + (i * 7) % 11 - 5));
+
+    // The window is taken as a single point, so that the signal is not changed
+    for (const Int_t window : {0, -1, -8}) {
+        const vector<Float_t> smoothed = rawSignal.GetSignalSmoothed(window, "MEDIAN");
+        ASSERT_EQ((Int_t)smoothed.size(), rawSignal.GetNumberOfPoints());
+        for (int i = 0; i < rawSignal.GetNumberOfPoints(); i++)
+            EXPECT_EQ(smoothed[i], rawSignal.GetRawData(i)) << "window " << window << " bin " << i;
+    }
+}
@@ -0,0 +1,105 @@
+#include <TRestRawSignalAddNoiseProcess.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+
+#include "RawSignalTestUtils.h"
+
+using namespace std;
+
+namespace {
+/// It adds the noise in place to flat signals with the given ids, and returns the noise of each signal
+map<Int_t, vector<Double_t>> GetNoise(TRestRawSignalAddNoiseProcess& process, Int_t eventId,
+                                      const vector<Int_t>& signalIds) {
+    TRestRawSignalEvent event = MakeRawSignalEvent(signalIds, 512, [](Int_t, Int_t) { return 1000; });
+    event.SetID(eventId);
+
+    process.ProcessEvent(&event);
+
+    map<Int_t, vector<Double_t>> noise;
+    for (int n = 0; n < event.GetNumberOfSignals(); n++) {
+        const TRestRawSignal* signal = event.GetSignal(n);
+        for (int i = 0; i < signal->GetNumberOfPoints(); i++)
+            noise[signal->GetSignalID()].push_back(signal->GetRawData(i) - 1000);
+    }
+    return noise;
+}
+}  // namespace
+
+TEST(TRestRawSignalAddNoiseProcess, Generator) {
+    TRestRawSignalAddNoiseProcess process;
+    EXPECT_EQ(process.GetGenerator(), "philox");
+
+    process.SetGenerator("TRandom3");
+    process.InitProcess();
+    EXPECT_EQ(process.GetGenerator(), "TRandom3");
+
+    // Unknown generators are replaced by the default one
+    process.SetGenerator("trandom3");
+    process.InitProcess();
+    EXPECT_EQ(process.GetGenerator(), "philox");
+}
+
+TEST(TRestRawSignalAddNoiseProcess, DifferentNoiseForEachSignal) {
+    TRestRawSignalAddNoiseProcess process;
+    process.SetInPlace(true);
+    process.SetSeed(17);
+    process.InitProcess();
+
+    const auto noise = GetNoise(process, 12, {100, 101, 102, 103, 104, 105, 106, 107});
+    ASSERT_EQ(noise.size(), 8u);
+    for (const auto& [id, values] : noise) {
+        // The noise level is 10 ADC units by default
+        Double_t sum2 = 0;
+        for (const auto value : values) sum2 += value * value;
+        EXPECT_NEAR(sqrt(sum2 / values.size()), process.GetNoiseLevel(), 2) << "signal " << id;
+
+        for (const auto& [otherId, otherValues] : noise) {
+            if (otherId != id) EXPECT_NE(values, otherValues) << "signals " << id << " and " << otherId;
+        }
+    }
+}
+
+TEST(TRestRawSignalAddNoiseProcess, SameNoiseWhateverTheOrder) {
+    const vector<Int_t> ids = {100, 101, 102, 103};
+    const vector<Int_t> reversedIds(ids.rbegin(), ids.rend());
+
+    TRestRawSignalAddNoiseProcess first;
+    first.SetInPlace(true);
+    first.SetSeed(17);
+    first.InitProcess();
+    const auto noise12 = GetNoise(first, 12, ids);
+    const auto noise13 = GetNoise(first, 13, ids);
+
+    // Other events first, and the signals in a different order
+    TRestRawSignalAddNoiseProcess second;
+    second.SetInPlace(true);
+    second.SetSeed(17);
+    second.InitProcess();
+    GetNoise(second, 14, ids);
+    EXPECT_EQ(GetNoise(second, 13, reversedIds), noise13);
+    EXPECT_EQ(GetNoise(second, 12, reversedIds), noise12);
+
+    // The same signal gets a different noise in another event
+    EXPECT_NE(noise12.at(100), noise13.at(100));
+}
+
+TEST(TRestRawSignalAddNoiseProcess, InPlaceMatchesCopy) {
+    TRestRawSignalAddNoiseProcess copy, inPlace;
+    inPlace.SetInPlace(true);
+    copy.SetSeed(17);
+    inPlace.SetSeed(17);
+
+    // The noise depends on the event and signal ids, which are the same in both events
+    auto makeEvent = [] {
+        const vector<Int_t> ids = {100, 101, 102, 103, 104, 105, 106, 107};
+        TRestRawSignalEvent event =
+            MakeRawSignalEvent(ids, 512, [](Int_t, Int_t i) { return i >= 200 && i < 220 ? 550 : 250; });
+        event.SetID(12);
+        return event;
+    };
+    TRestRawSignalEvent copyInput = makeEvent(), inPlaceInput = makeEvent();
+    const auto [copyOutput, inPlaceOutput] = ProcessCopyAndInPlace(copy, copyInput, inPlace, inPlaceInput);
+    ExpectSameSignals(inPlaceOutput, copyOutput);
+}
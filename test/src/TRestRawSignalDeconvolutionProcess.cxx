@@ -0,0 +1,92 @@
+#include <TRestRawSignalDeconvolutionProcess.h>
+#include <TRestRawSignalShapingProcess.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+using namespace std;
+
+const auto filesPath = fs::path(__FILE__).parent_path().parent_path() / "files";
+const auto restRawSignalDeconvolutionProcessRml = filesPath / "TRestRawSignalDeconvolutionProcess.rml";
+
+TEST(TRestRawSignalDeconvolutionProcess, TestFiles) {
+    cout << "Test files path: " << filesPath << endl;
+
+    // Check dir exists and is a directory
+    EXPECT_TRUE(fs::is_directory(filesPath));
+    // Check it's not empty
+    EXPECT_TRUE(!fs::is_empty(filesPath));
+    EXPECT_TRUE(fs::exists(restRawSignalDeconvolutionProcessRml));
+}
+
+TEST(TRestRawSignalDeconvolutionProcess, Default) {
+    TRestRawSignalDeconvolutionProcess process;
+    EXPECT_TRUE(process.GetProcessName() == (std::string) "deconvolution");
+
+    EXPECT_TRUE(process.GetResponseType() == "shaperSin");
+    EXPECT_TRUE(process.GetShapingTime() == 10.0);
+    EXPECT_TRUE(process.GetRegularization() == 0.01);
+    EXPECT_TRUE(process.GetDeconvolutionGain() == 1.0);
+}
+
+TEST(TRestRawSignalDeconvolutionProcess, FromRml) {
+    TRestRawSignalDeconvolutionProcess process(restRawSignalDeconvolutionProcessRml.c_str());
+
+    process.PrintMetadata();
+
+    EXPECT_TRUE(process.GetResponseType() == "shaper");
+    EXPECT_TRUE(process.GetShapingTime() == 8.0);
+    EXPECT_TRUE(process.GetShapingOrder() == 4);
+    EXPECT_TRUE(process.GetRegularization() == 0.005);
+    EXPECT_TRUE(process.GetDeconvolutionGain() == 2.0);
+
+    process.InitProcess();
+    EXPECT_FALSE(process.GetResponse().empty());
+}
+
+TEST(TRestRawSignalDeconvolutionProcess, RecoverShapedCharge) {
+    // Two charges at bins 100 and 300 are shaped, and recovered by the deconvolution
+    TRestRawSignalEvent event;
+    TRestRawSignal signal;
+    for (int i = 0; i < 512; i++) {
+        Short_t value = 0;
+        if (i == 100) value = 1000;
+        if (i == 300) value = 500;
+        signal.AddPoint(value);
+    }
+    signal.SetSignalID(1);
+    event.AddSignal(signal);
+
+    TRestRawSignalShapingProcess shaping;
+    shaping.SetShapingType("shaperSin");
+    shaping.SetShapingTime(10);
+    shaping.SetShapingEngine("direct");
+    shaping.InitProcess();
+    auto shapedEvent = (TRestRawSignalEvent*)shaping.ProcessEvent(&event);
+    ASSERT_TRUE(shapedEvent != nullptr);
+
+    TRestRawSignalDeconvolutionProcess process;
+    process.InitProcess();
+    auto output = (TRestRawSignalEvent*)process.ProcessEvent(shapedEvent);
+    ASSERT_TRUE(output != nullptr);
+    ASSERT_EQ(output->GetNumberOfSignals(), 1);
+
+    const TRestRawSignal* deconvolved = output->GetSignal(0);
+    ASSERT_EQ(deconvolved->GetNumberOfPoints(), 512);
+
+    Int_t maxBin = 0;
+    Double_t firstCharge = 0, secondCharge = 0;
+    for (int i = 0; i < 512; i++) {
+        if (deconvolved->GetRawData(i) > deconvolved->GetRawData(maxBin)) maxBin = i;
+        if (i >= 90 && i < 115) firstCharge += deconvolved->GetRawData(i);
+        if (i >= 290 && i < 315) secondCharge += deconvolved->GetRawData(i);
+    }
+
+    // The shaped pulses peak about 20 samples later, and the deconvolution moves the charges back to the
+    // original deposits
+    EXPECT_EQ(maxBin, 100);
+    EXPECT_NEAR(firstCharge, 1000, 20);
+    EXPECT_NEAR(secondCharge, 500, 20);
+}
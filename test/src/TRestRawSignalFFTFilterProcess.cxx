@@ -0,0 +1,181 @@
+#include <TRestRawSignalFFTFilterProcess.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+
+namespace fs = std::filesystem;
+
+using namespace std;
+
+const auto filesPath = fs::path(__FILE__).parent_path().parent_path() / "files";
+const auto restRawSignalFFTFilterProcessRml = filesPath / "TRestRawSignalFFTFilterProcess.rml";
+
+namespace {
+/// An event with nSignals signals holding a pulse plus two sinusoids, with periods of 8 and 40 samples
+TRestRawSignalEvent MakeEvent(Int_t nSignals, Int_t nPoints) {
+    TRestRawSignalEvent event;
+    for (int s = 0; s < nSignals; s++) {
+        TRestRawSignal signal;
+        signal.SetSignalID(s);
+        for (int i = 0; i < nPoints; i++) {
+            Double_t value = 500 + 50 * sin(2 * TMath::Pi() * i / 8.) + 20 * sin(2 * TMath::Pi() * i / 40.);
+            if (i >= nPoints / 2) value += 300 * exp(-(i - nPoints / 2) / 20.);
+            signal.AddPoint((Short_t)round(value));
+        }
+        event.AddSignal(signal);
+    }
+    return event;
+}
+}  // namespace
+
+TEST(TRestRawSignalFFTFilterProcess, TestFiles) {
+    cout << "Test files path: " << filesPath << endl;
+
+    // Check dir exists and is a directory
+    EXPECT_TRUE(fs::is_directory(filesPath));
+    // Check it's not empty
+    EXPECT_TRUE(!fs::is_empty(filesPath));
+    EXPECT_TRUE(fs::exists(restRawSignalFFTFilterProcessRml));
+}
+
+TEST(TRestRawSignalFFTFilterProcess, Default) {
+    TRestRawSignalFFTFilterProcess process;
+    EXPECT_TRUE(process.GetProcessName() == (std::string) "fftFilter");
+
+    EXPECT_TRUE(process.GetFilterType() == "butterworth");
+    EXPECT_TRUE(process.GetCutFrequency() == 0.1);
+    EXPECT_TRUE(process.GetOrder() == 2);
+    EXPECT_TRUE(process.GetNotches().empty());
+}
+
+TEST(TRestRawSignalFFTFilterProcess, FromRml) {
+    TRestRawSignalFFTFilterProcess process(restRawSignalFFTFilterProcessRml.c_str());
+
+    process.PrintMetadata();
+
+    EXPECT_TRUE(process.GetFilterType() == "lowPass");
+    EXPECT_TRUE(process.GetCutFrequency() == 0.2);
+    EXPECT_TRUE(process.GetOrder() == 4);
+    EXPECT_TRUE(process.GetFilterThreads() == 2);
+    ASSERT_EQ(process.GetNotches().size(), 1);
+    EXPECT_TRUE(process.GetNotches()[0].X() == 0.125);
+    EXPECT_TRUE(process.GetNotches()[0].Y() == 0.01);
+}
+
+TEST(TRestRawSignalFFTFilterProcess, Notch) {
+    TRestRawSignalEvent event = MakeEvent(8, 512);
+
+    // Only the pickup line with a period of 8 samples is removed
+    TRestRawSignalFFTFilterProcess process;
+    process.SetFilterType("none");
+    process.AddNotch(0.125, 0.01);
+    process.SetFilterThreads(3);
+    process.InitProcess();
+
+    auto output = (TRestRawSignalEvent*)process.ProcessEvent(&event);
+    ASSERT_EQ(output->GetNumberOfSignals(), event.GetNumberOfSignals());
+
+    for (int s = 0; s < output->GetNumberOfSignals(); s++) {
+        const TRestRawSignal* signal = output->GetSignal(s);
+        ASSERT_EQ(signal->GetNumberOfPoints(), 512);
+        EXPECT_EQ(signal->GetSignalID(), s);
+        for (int i = 0; i < signal->GetNumberOfPoints(); i++) {
+            Double_t expected = 500 + 20 * sin(2 * TMath::Pi() * i / 40.);
+            if (i >= 256) expected += 300 * exp(-(i - 256) / 20.);
+            // The pulse has some power at the notch frequency
+            EXPECT_NEAR(signal->GetRawData(i), expected, 10) << "signal " << s << " bin " << i;
+        }
+    }
+
+    process.EndProcess();
+}
+
+TEST(TRestRawSignalFFTFilterProcess, ThreadsMatchSingleThread) {
+    for (const Int_t nPoints : {512, 2048}) {
+        TRestRawSignalEvent event = MakeEvent(128, nPoints);
+
+        // The raw data of each output signal, for 1 and 4 threads
+        map<Int_t, vector<vector<Double_t>>> outputs;
+        for (const Int_t threads : {1, 4}) {
+            TRestRawSignalFFTFilterProcess process;
+            process.SetFilterThreads(threads);
+            process.AddNotch(0.125, 0.01);
+            process.InitProcess();
+
+            process.BeginOfEventProcess(&event);
+            auto output = (TRestRawSignalEvent*)process.ProcessEvent(&event);
+            ASSERT_TRUE(output != nullptr);
+            ASSERT_EQ(output->GetNumberOfSignals(), 128);
+
+            for (int n = 0; n < output->GetNumberOfSignals(); n++) {
+                TRestRawSignal* signal = output->GetSignal(n);
+                EXPECT_EQ(signal->GetSignalID(), event.GetSignal(n)->GetSignalID());
+                vector<Double_t> data(signal->GetNumberOfPoints());
+                for (int i = 0; i < signal->GetNumberOfPoints(); i++) data[i] = signal->GetRawData(i);
+                outputs[threads].push_back(data);
+            }
+            process.EndProcess();
+        }
+
+        ASSERT_EQ(outputs[1].size(), outputs[4].size());
+        for (size_t n = 0; n < outputs[1].size(); n++) {
+            ASSERT_EQ(outputs[1][n].size(), outputs[4][n].size());
+            for (size_t i = 0; i < outputs[1][n].size(); i++) EXPECT_EQ(outputs[1][n][i], outputs[4][n][i]);
+        }
+    }
+}
+
+TEST(TRestRawSignalFFTFilterProcess, WithoutInitProcess) {
+    TRestRawSignalEvent event = MakeEvent(8, 512);
+
+    TRestRawSignalFFTFilterProcess process;
+    process.SetFilterThreads(2);
+
+    // The threads are started at the first event if InitProcess was not called
+    process.BeginOfEventProcess(&event);
+    auto output = (TRestRawSignalEvent*)process.ProcessEvent(&event);
+    ASSERT_TRUE(output != nullptr);
+    EXPECT_EQ(output->GetNumberOfSignals(), 8);
+
+    // And again after EndProcess stopped them
+    process.EndProcess();
+    process.BeginOfEventProcess(&event);
+    output = (TRestRawSignalEvent*)process.ProcessEvent(&event);
+    ASSERT_TRUE(output != nullptr);
+    EXPECT_EQ(output->GetNumberOfSignals(), 8);
+    process.EndProcess();
+}
+
+// Timing only, it does not check the output. It is disabled so that the tests do not depend on the
+// machine load. Run it with --gtest_also_run_disabled_tests --gtest_filter='*FFTFilter*Benchmark'
+TEST(TRestRawSignalFFTFilterProcess, DISABLED_Benchmark) {
+    for (const Int_t nPoints : {512, 2048}) {
+        TRestRawSignalEvent event = MakeEvent(128, nPoints);
+
+        for (const Int_t threads : {1, 4}) {
+            TRestRawSignalFFTFilterProcess process;
+            process.SetFilterThreads(threads);
+            process.AddNotch(0.125, 0.01);
+            process.InitProcess();
+
+            // The first event builds the FFT plans and the transfer function
+            process.BeginOfEventProcess(&event);
+            process.ProcessEvent(&event);
+
+            const Int_t nEvents = 50;
+            const auto start = chrono::steady_clock::now();
+            for (int n = 0; n < nEvents; n++) {
+                process.BeginOfEventProcess(&event);
+                process.ProcessEvent(&event);
+            }
+            const auto end = chrono::steady_clock::now();
+            process.EndProcess();
+
+            cout << "TRestRawSignalFFTFilterProcess: 128 signals of " << nPoints << " points, " << threads
+                 << " threads : " << chrono::duration<double, micro>(end - start).count() / nEvents
+                 << " us per event" << endl;
+        }
+    }
+}
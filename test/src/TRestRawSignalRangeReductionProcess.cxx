@@ -4,6 +4,8 @@
 
 #include <filesystem>
 
+#include "RawSignalTestUtils.h"
+
 namespace fs = std::filesystem;
 
 using namespace std;
@@ -68,3 +70,22 @@ TEST(TRestRawSignalRangeReductionProcess, Event) {
     EXPECT_TRUE(outputSignal->GetMinValue() == 0);
     EXPECT_TRUE(outputSignal->GetMaxValue() == 4095);
 }
+
+TEST(TRestRawSignalRangeReductionProcess, InPlaceMatchesCopy) {
+    TRestRawSignalRangeReductionProcess copy, inPlace;
+    inPlace.SetInPlace(true);
+    for (auto process : {&copy, &inPlace}) {
+        process->SetResolutionInNumberOfBits(10);
+        process->SetDigitizationInputRange({-1000, 10000});
+        process->InitProcess();
+    }
+
+    auto makeEvent = [] {
+        return MakeRawSignalEvent({10, 11, 12, 13}, 512, [](Int_t id, Int_t i) {
+            return -2000 + (i * 7919 + (id - 10) * 104729) % 14000;
+        });
+    };
+    TRestRawSignalEvent copyInput = makeEvent(), inPlaceInput = makeEvent();
+    const auto [copyOutput, inPlaceOutput] = ProcessCopyAndInPlace(copy, copyInput, inPlace, inPlaceInput);
+    ExpectSameSignals(inPlaceOutput, copyOutput);
+}
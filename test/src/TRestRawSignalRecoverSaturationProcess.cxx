@@ -0,0 +1,73 @@
+#include <TRestRawSignalRecoverSaturationProcess.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace std;
+
+namespace {
+const Double_t kBaseLine = 250;
+const Double_t kAmplitude = 3000;
+const Double_t kStart = 150;
+const Double_t kWidth = 30;
+const Short_t kSaturation = 2000;
+
+/// A pulse with the shape of the fit function, peaking at kStart + kWidth, with a small noise. The values
+/// over kSaturation are clipped as by the ADC.
+TRestRawSignal MakeSaturatedSignal() {
+    TRestRawSignal signal;
+    for (int i = 0; i < 512; i++) {
+        const Double_t u = (i - kStart) / kWidth;
+        const Double_t g = u > 0 ? u * exp(1. - u) : 0;
+        const Double_t value = kBaseLine + kAmplitude * g * g * g + (i * 7919) % 5 - 2;
+        signal.AddPoint((Short_t)min(round(value), (Double_t)kSaturation));
+    }
+    signal.SetSignalID(1);
+    return signal;
+}
+}  // namespace
+
+TEST(TRestRawSignalRecoverSaturationProcess, RecoversSaturatedPulse) {
+    TRestRawSignalEvent event;
+    event.AddSignal(MakeSaturatedSignal());
+    ASSERT_TRUE(event.GetSignal(0)->IsADCSaturation(3));
+    EXPECT_EQ(event.GetSignal(0)->GetRawData(event.GetSignal(0)->GetMaxPeakBin()), kSaturation);
+
+    TRestRawSignalRecoverSaturationProcess process;
+    process.InitProcess();
+    auto output = (TRestRawSignalEvent*)process.ProcessEvent(&event);
+    ASSERT_NE(output, nullptr);
+    process.EndProcess();
+
+    // The recovered pulse peaks at the original amplitude and time
+    TRestRawSignal* signal = output->GetSignal(0);
+    const Int_t maxBin = signal->GetMaxPeakBin();
+    EXPECT_NEAR(signal->GetRawData(maxBin), kBaseLine + kAmplitude, 0.01 * kAmplitude);
+    EXPECT_NEAR(maxBin, kStart + kWidth, 1);
+
+    // The points that were not saturated are not modified
+    const TRestRawSignal original = MakeSaturatedSignal();
+    for (int i = 0; i < original.GetNumberOfPoints(); i++) {
+        if (original.GetRawData(i) < kSaturation) EXPECT_EQ(signal->GetRawData(i), original.GetRawData(i));
+    }
+}
+
+TEST(TRestRawSignalRecoverSaturationProcess, TooFewPointsToFit) {
+    // Only 2 points out of the saturated bins, which is not enough for the 4 fit parameters
+    TRestRawSignal signal;
+    const vector<Short_t> values = {250, 260, kSaturation, kSaturation, kSaturation};
+    for (const Short_t value : values) signal.AddPoint(value);
+    signal.SetSignalID(1);
+
+    TRestRawSignalEvent event;
+    event.AddSignal(signal);
+
+    TRestRawSignalRecoverSaturationProcess process;
+    process.InitProcess();
+    auto output = (TRestRawSignalEvent*)process.ProcessEvent(&event);
+    ASSERT_NE(output, nullptr);
+    process.EndProcess();
+
+    for (int i = 0; i < signal.GetNumberOfPoints(); i++)
+        EXPECT_EQ(output->GetSignal(0)->GetRawData(i), signal.GetRawData(i));
+}
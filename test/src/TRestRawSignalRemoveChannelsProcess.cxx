@@ -4,6 +4,8 @@
 
 #include <filesystem>
 
+#include "RawSignalTestUtils.h"
+
 namespace fs = std::filesystem;
 
 using namespace std;
@@ -57,3 +59,21 @@ TEST(TRestRawSignalRemoveChannelsProcess, FromRmlTypes) {
     const set<string> channelTypesSet(channelTypes.begin(), channelTypes.end());
     EXPECT_EQ(channelTypesSet, expectedChannelTypes);
 }
+
+TEST(TRestRawSignalRemoveChannelsProcess, InPlaceMatchesCopy) {
+    TRestRawSignalRemoveChannelsProcess copy(restRawSignalRemoveChannelsProcessRmlIds.c_str());
+    TRestRawSignalRemoveChannelsProcess inPlace(restRawSignalRemoveChannelsProcessRmlIds.c_str());
+    inPlace.SetInPlace(true);
+
+    // Some of the signals are inside the removed range (4612,4888)
+    auto makeEvent = [] {
+        return MakeRawSignalEvent({4600, 4612, 4700, 4611, 4888, 4889, 5000, 4650}, 512,
+                                  [](Int_t id, Int_t i) { return id % 100 + i % 17; });
+    };
+    TRestRawSignalEvent copyInput = makeEvent(), inPlaceInput = makeEvent();
+    const auto [copyOutput, inPlaceOutput] = ProcessCopyAndInPlace(copy, copyInput, inPlace, inPlaceInput);
+    ExpectSameSignals(inPlaceOutput, copyOutput);
+
+    const vector<int> expectedIds = {4600, 4611, 4889, 5000};
+    EXPECT_EQ(inPlaceOutput->GetSignalIds(), expectedIds);
+}
@@ -4,6 +4,8 @@
 
 #include <filesystem>
 
+#include "RawSignalTestUtils.h"
+
 namespace fs = std::filesystem;
 
 using namespace std;
@@ -39,3 +41,67 @@ TEST(TRestRawSignalShapingProcess, FromRml) {
     EXPECT_TRUE(process.GetShapingTime() == 5.0);
     EXPECT_TRUE(process.GetShapingGain() == 20.0);
 }
+
+TEST(TRestRawSignalShapingProcess, IIRMatchesDirect) {
+    TRestRawSignalEvent event;
+    TRestRawSignal signal;
+    for (int i = 0; i < 512; i++) {
+        Short_t value = 0;
+        if (i == 50) value = 100;
+        if (i == 51) value = 30;
+        if (i == 200) value = 400;
+        signal.AddPoint(value);
+    }
+    signal.SetSignalID(1);
+    event.AddSignal(signal);
+
+    for (const string type : {"exponential", "shaper"}) {
+        TRestRawSignalShapingProcess direct(restRawSignalShapingProcessRml.c_str());
+        direct.SetShapingType(type);
+        direct.SetShapingEngine("direct");
+        direct.InitProcess();
+
+        TRestRawSignalShapingProcess iir(restRawSignalShapingProcessRml.c_str());
+        iir.SetShapingType(type);
+        iir.SetShapingEngine("iir");
+        iir.InitProcess();
+
+        auto directEvent = (TRestRawSignalEvent*)direct.ProcessEvent(&event);
+        auto iirEvent = (TRestRawSignalEvent*)iir.ProcessEvent(&event);
+        ASSERT_TRUE(directEvent != nullptr && iirEvent != nullptr);
+        ASSERT_EQ(directEvent->GetNumberOfSignals(), 1);
+        ASSERT_EQ(iirEvent->GetNumberOfSignals(), 1);
+
+        const TRestRawSignal* directSignal = directEvent->GetSignal(0);
+        const TRestRawSignal* iirSignal = iirEvent->GetSignal(0);
+        ASSERT_EQ(directSignal->GetNumberOfPoints(), iirSignal->GetNumberOfPoints());
+
+        // The exponential response is identical. The shaper response is not truncated by the IIR filter,
+        // which changes its normalization by less than 0.1%
+        Double_t maxValue = 0;
+        for (int i = 0; i < directSignal->GetNumberOfPoints(); i++)
+            maxValue = max(maxValue, directSignal->GetRawData(i));
+        EXPECT_GT(maxValue, 0);
+
+        const Double_t tolerance = 1 + (type == "shaper" ? 1.e-3 * maxValue : 0);
+        for (int i = 0; i < directSignal->GetNumberOfPoints(); i++)
+            EXPECT_NEAR(directSignal->GetRawData(i), iirSignal->GetRawData(i), tolerance)
+                << type << " bin " << i;
+    }
+}
+
+TEST(TRestRawSignalShapingProcess, InPlaceMatchesCopy) {
+    TRestRawSignalShapingProcess copy, inPlace;
+    inPlace.SetInPlace(true);
+    copy.InitProcess();
+    inPlace.InitProcess();
+
+    auto makeEvent = [] {
+        return MakeRawSignalEvent({10, 11, 12, 13}, 512, [](Int_t id, Int_t i) {
+            return i == 50 + 20 * (id - 10) ? 100 * (id - 9) : 0;
+        });
+    };
+    TRestRawSignalEvent copyInput = makeEvent(), inPlaceInput = makeEvent();
+    const auto [copyOutput, inPlaceOutput] = ProcessCopyAndInPlace(copy, copyInput, inPlace, inPlaceInput);
+    ExpectSameSignals(inPlaceOutput, copyOutput);
+}
@@ -0,0 +1,111 @@
+#include <TRestRawSignalAddNoiseProcess.h>
+#include <TRestRawSignalRangeReductionProcess.h>
+#include <TRestRawSignalShapingProcess.h>
+#include <TRestRawSignalTransformChainProcess.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include "RawSignalTestUtils.h"
+
+namespace fs = std::filesystem;
+
+using namespace std;
+
+const auto filesPath = fs::path(__FILE__).parent_path().parent_path() / "files";
+const auto restRawSignalTransformChainProcessRml = filesPath / "TRestRawSignalTransformChainProcess.rml";
+
+TEST(TRestRawSignalTransformChainProcess, TestFiles) {
+    cout << "Test files path: " << filesPath << endl;
+
+    // Check dir exists and is a directory
+    EXPECT_TRUE(fs::is_directory(filesPath));
+    // Check it's not empty
+    EXPECT_TRUE(!fs::is_empty(filesPath));
+    EXPECT_TRUE(fs::exists(restRawSignalTransformChainProcessRml));
+}
+
+TEST(TRestRawSignalTransformChainProcess, Default) {
+    TRestRawSignalTransformChainProcess process;
+    EXPECT_TRUE(process.GetProcessName() == (std::string) "rawSignalTransformChain");
+
+    EXPECT_EQ(process.GetNumberOfTransforms(), 0);
+    EXPECT_FALSE(process.IsInPlace());
+    EXPECT_FALSE(process.IsKeepIntermediateEvents());
+}
+
+TEST(TRestRawSignalTransformChainProcess, FromRml) {
+    TRestRawSignalTransformChainProcess process(restRawSignalTransformChainProcessRml.c_str());
+
+    process.PrintMetadata();
+
+    EXPECT_TRUE(process.IsKeepIntermediateEvents());
+    ASSERT_EQ(process.GetNumberOfTransforms(), 3);
+
+    auto range = dynamic_cast<TRestRawSignalRangeReductionProcess*>(process.GetTransform(0));
+    auto noise = dynamic_cast<TRestRawSignalAddNoiseProcess*>(process.GetTransform(1));
+    auto shaping = dynamic_cast<TRestRawSignalShapingProcess*>(process.GetTransform(2));
+    ASSERT_TRUE(range != nullptr && noise != nullptr && shaping != nullptr);
+
+    EXPECT_TRUE(range->GetResolutionInNumberOfBits() == 10);
+    EXPECT_TRUE(noise->GetNoiseLevel() == 5.0);
+    EXPECT_TRUE(shaping->GetShapingType() == (std::string) "shaper");
+    EXPECT_TRUE(shaping->GetShapingTime() == 8.0);
+}
+
+TEST(TRestRawSignalTransformChainProcess, MatchesUnfusedChain) {
+    TRestRawSignalEvent event = MakeRawSignalEvent({0, 1, 2}, 512, [](Int_t id, Int_t i) {
+        if (i == 100 + 50 * id) return 2000;
+        if (i == 101 + 50 * id) return 800;
+        return 250;
+    });
+
+    auto configure = [](TRestRawSignalRangeReductionProcess* range, TRestRawSignalAddNoiseProcess* noise,
+                        TRestRawSignalShapingProcess* shaping) {
+        range->SetResolutionInNumberOfBits(10);
+        noise->SetNoiseLevel(5);
+        shaping->SetShapingType("shaper");
+        shaping->SetShapingTime(8);
+    };
+
+    // The processes applied one after the other
+    TRestRawSignalRangeReductionProcess range;
+    TRestRawSignalAddNoiseProcess noise;
+    TRestRawSignalShapingProcess shaping;
+    configure(&range, &noise, &shaping);
+    range.InitProcess();
+    shaping.InitProcess();
+
+    auto rangeEvent = (TRestRawSignalEvent*)range.ProcessEvent(&event);
+    auto noiseEvent = (TRestRawSignalEvent*)noise.ProcessEvent(rangeEvent);
+    auto unfused = (TRestRawSignalEvent*)shaping.ProcessEvent(noiseEvent);
+    ASSERT_TRUE(unfused != nullptr);
+
+    for (const bool inPlace : {false, true}) {
+        TRestRawSignalTransformChainProcess chain;
+        auto chainRange = new TRestRawSignalRangeReductionProcess();
+        auto chainNoise = new TRestRawSignalAddNoiseProcess();
+        auto chainShaping = new TRestRawSignalShapingProcess();
+        configure(chainRange, chainNoise, chainShaping);
+        EXPECT_TRUE(chain.AddTransform(chainRange));
+        EXPECT_TRUE(chain.AddTransform(chainNoise));
+        EXPECT_TRUE(chain.AddTransform(chainShaping));
+
+        chain.SetInPlace(inPlace);
+        chain.SetKeepIntermediateEvents(true);
+        chain.InitProcess();
+
+        TRestRawSignalEvent input = event;
+        auto fused = (TRestRawSignalEvent*)chain.ProcessEvent(&input);
+        ASSERT_TRUE(fused != nullptr);
+        EXPECT_EQ(fused == &input, inPlace);
+
+        const vector<TRestRawSignalEvent*> expected = {rangeEvent, noiseEvent, unfused};
+        for (size_t k = 0; k < expected.size(); k++) {
+            ASSERT_TRUE(chain.GetIntermediateEvent(k) != nullptr);
+            ExpectSameSignals(chain.GetIntermediateEvent(k), expected[k]);
+        }
+
+        ExpectSameSignals(fused, unfused);
+    }
+}
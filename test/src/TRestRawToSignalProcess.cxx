@@ -0,0 +1,158 @@
+#include <TRestRawToSignalProcess.h>
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#ifdef REST_RAW_ZLIB
+#include <zlib.h>
+#endif
+#ifdef REST_RAW_ZSTD
+#include <zstd.h>
+#endif
+#ifdef REST_RAW_LZ4
+#include <lz4frame.h>
+#endif
+
+namespace fs = std::filesystem;
+
+using namespace std;
+
+namespace {
+/// A minimal raw process, giving access to the raw file streams
+class TRestRawFileReader : public TRestRawToSignalProcess {
+   public:
+    using TRestRawToSignalProcess::OpenRawFile;
+
+    TRestEvent* ProcessEvent(TRestEvent*) override { return nullptr; }
+
+    Long64_t GetCompressedBytesRead() const { return fCompressedBytesRead; }
+    Long64_t GetDecompressedBytesRead() const { return fDecompressedBytesRead; }
+};
+
+/// 1 MiB of raw-like content, much larger than the output buffers of the decompressors
+vector<char> MakeRawContent() {
+    vector<char> content(1 << 20);
+    mt19937 random(1);
+    for (size_t i = 0; i < content.size(); i += 2) {
+        // Slowly varying 12 bit samples, with some noise, as in the raw data
+        const UInt_t sample = 250 + (i / 2) % 1000 + random() % 16;
+        content[i] = (char)(sample >> 8);
+        content[i + 1] = (char)(sample & 0xFF);
+    }
+    return content;
+}
+
+vector<char> ReadFile(FILE* f) {
+    vector<char> content;
+    char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) content.insert(content.end(), buffer, buffer + n);
+    return content;
+}
+
+/// It writes the compressed content to a file and checks it is read back byte by byte as the original one
+void CheckCompressedFile(const string& extension, const vector<char>& compressed, const vector<char>& raw) {
+    const auto file = fs::temp_directory_path() / ("TRestRawToSignalProcess" + extension);
+    ofstream(file, ios::binary).write(compressed.data(), compressed.size());
+
+    EXPECT_TRUE(TRestRawToSignalProcess::IsCompressedFile(file));
+
+    TRestRawFileReader reader;
+    FILE* f = reader.OpenRawFile(file);
+    ASSERT_NE(f, nullptr);
+
+    const vector<char> content = ReadFile(f);
+    EXPECT_FALSE(ferror(f));
+    EXPECT_EQ(content.size(), raw.size());
+    EXPECT_TRUE(content == raw);
+
+    EXPECT_EQ(reader.GetDecompressedBytesRead(), (Long64_t)raw.size());
+    EXPECT_EQ(reader.GetCompressedBytesRead(), (Long64_t)compressed.size());
+
+    // Rewinding restarts the decompression
+    rewind(f);
+    EXPECT_TRUE(ReadFile(f) == raw);
+    fclose(f);
+
+    // A truncated file must be reported as a read error, not as a shorter file
+    ofstream(file, ios::binary).write(compressed.data(), compressed.size() - 8);
+    f = reader.OpenRawFile(file);
+    ASSERT_NE(f, nullptr);
+    EXPECT_LE(ReadFile(f).size(), raw.size());
+    EXPECT_TRUE(ferror(f));
+    fclose(f);
+
+    fs::remove(file);
+}
+}  // namespace
+
+TEST(TRestRawToSignalProcess, UncompressedFile) {
+    const vector<char> raw = MakeRawContent();
+    const auto file = fs::temp_directory_path() / "TRestRawToSignalProcess.aqs";
+    ofstream(file, ios::binary).write(raw.data(), raw.size());
+
+    EXPECT_FALSE(TRestRawToSignalProcess::IsCompressedFile(file));
+
+    TRestRawFileReader reader;
+    FILE* f = reader.OpenRawFile(file);
+    ASSERT_NE(f, nullptr);
+    EXPECT_TRUE(ReadFile(f) == raw);
+    fclose(f);
+
+    fs::remove(file);
+}
+
+#ifdef REST_RAW_ZLIB
+TEST(TRestRawToSignalProcess, GzipFile) {
+    const vector<char> raw = MakeRawContent();
+
+    // Two concatenated gzip members, as produced by pigz, holding each half of the content
+    vector<char> compressed;
+    for (const size_t begin : {(size_t)0, raw.size() / 2}) {
+        z_stream stream = {};
+        // 15 + 16 writes a gzip header
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+        vector<char> member(deflateBound(&stream, raw.size() / 2));
+        stream.next_in = (Bytef*)raw.data() + begin;
+        stream.avail_in = raw.size() / 2;
+        stream.next_out = (Bytef*)member.data();
+        stream.avail_out = member.size();
+        ASSERT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+        compressed.insert(compressed.end(), member.begin(), member.begin() + stream.total_out);
+        deflateEnd(&stream);
+    }
+
+    CheckCompressedFile(".gz", compressed, raw);
+}
+#endif
+
+#ifdef REST_RAW_ZSTD
+TEST(TRestRawToSignalProcess, ZstdFile) {
+    const vector<char> raw = MakeRawContent();
+    ASSERT_GT(raw.size(), ZSTD_DStreamOutSize());
+
+    vector<char> compressed(ZSTD_compressBound(raw.size()));
+    const size_t size = ZSTD_compress(compressed.data(), compressed.size(), raw.data(), raw.size(), 3);
+    ASSERT_FALSE(ZSTD_isError(size));
+    compressed.resize(size);
+
+    CheckCompressedFile(".zst", compressed, raw);
+}
+#endif
+
+#ifdef REST_RAW_LZ4
+TEST(TRestRawToSignalProcess, Lz4File) {
+    const vector<char> raw = MakeRawContent();
+
+    vector<char> compressed(LZ4F_compressFrameBound(raw.size(), nullptr));
+    const size_t size =
+        LZ4F_compressFrame(compressed.data(), compressed.size(), raw.data(), raw.size(), nullptr);
+    ASSERT_FALSE(LZ4F_isError(size));
+    compressed.resize(size);
+
+    CheckCompressedFile(".lz4", compressed, raw);
+}
+#endif